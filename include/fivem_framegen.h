@@ -46,6 +46,43 @@ enum class QualityPreset : uint32_t {
     Quality = 2         // Best quality, more GPU intensive
 };
 
+/**
+ * Region-of-interest shapes for tiered interpolation quality
+ */
+enum class RoiMode : uint32_t {
+    Off = 0,            // Full quality everywhere
+    CenterEllipse = 1,  // Ellipse around the screen centre
+    Rectangles = 2      // User-defined rectangles
+};
+
+/**
+ * ROI rectangle in fractions of the screen (0-1, origin top-left)
+ */
+struct RoiRect {
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+};
+
+constexpr uint32_t MAX_ROI_RECTS = 4;
+
+/**
+ * Region-of-interest settings
+ *
+ * Full-quality warping runs inside the region; outside it frames are
+ * interpolated with a plain bilinear warp and blend. Weights fade
+ * across the feather band so there is no visible seam.
+ */
+struct RoiConfig {
+    RoiMode mode = RoiMode::Off;
+    float radiusX = 0.30f;                          // Ellipse half-width (screen fraction)
+    float radiusY = 0.35f;                          // Ellipse half-height (screen fraction)
+    float feather = 0.05f;                          // Transition width (screen fraction)
+    uint32_t rectCount = 0;                         // Rectangles used (Rectangles mode)
+    RoiRect rects[MAX_ROI_RECTS];
+};
+
 /**
  * Frame generation configuration
  */
@@ -57,6 +94,10 @@ struct Config {
     bool showOverlay = true;                        // Show performance overlay
     bool hudLessMode = false;                       // Exclude HUD from interpolation
     float sharpness = 0.5f;                         // Sharpening strength (0-1)
+    bool linearBlending = false;                    // Blend frames in linear light
+    RoiConfig roi;                                  // Full-quality focus region
+    uint32_t memoryBudgetMB = 0;                    // Frame gen memory cap (0 = unlimited)
+    uint32_t readbackDepth = 0;                     // CPU readback staging copies (0 = off, max 8)
 };
 
 /**
@@ -69,6 +110,22 @@ struct Stats {
     float gpuTimeMs;        // GPU time for frame gen
     uint64_t framesGenerated;// Total interpolated frames
     uint64_t framesMissed;   // Frames that couldn't be generated in time
+    uint32_t tilesStatic;   // Tiles copied: no motion and no change, interpolation skipped
+    uint32_t tilesBlended;  // Interpolation tiles cross-faded (no visible motion)
+    uint32_t tilesWarped;   // Tiles given the cheap bilinear warp
+    uint32_t tilesFullWarp; // Tiles given the full occlusion-aware warp
+    uint32_t tilesReused;   // Tiles kept from the last generated frame (inputs hashed the same)
+    uint32_t tilesReuseLookups; // Tiles local enough to key for reuse
+    uint64_t memoryUsedBytes;   // Textures, buffers and shaders held by frame gen
+    uint64_t memoryBudgetBytes; // Configured cap (0 = unlimited)
+    uint32_t memoryDegradation; // Budget degradation level (0 = none)
+    uint32_t readbackLatencyFrames; // Frames between capture and CPU readback
+    float readbackLatencyMs;        // Time between capture and CPU readback
+    uint64_t readbackNotReady;      // Readbacks skipped because the GPU copy was unfinished
+    uint64_t readbackDropped;       // Captured frames never read back
+    uint64_t frameCopies;           // Full-frame GPU copies on the capture/present path
+    uint64_t frameBytesCopied;      // Bytes moved by those copies
+    uint64_t frameCopiesAliased;    // Copies skipped by rendering into the back buffer
 };
 
 /**
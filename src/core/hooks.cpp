@@ -111,7 +111,7 @@ void Hooks::Shutdown() {
 }
 
 void Hooks::SetPresentCallback(PresentCallback callback) {
-    m_PresentCallback = std::move(callback);
+    m_PresentCallback = callback;
 }
 
 bool Hooks::GetD3D11VTable(void** vtable, size_t size) {
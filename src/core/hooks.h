@@ -13,7 +13,6 @@
 #include <Windows.h>
 #include <d3d11.h>
 #include <dxgi.h>
-#include <functional>
 #include <memory>
 
 namespace FiveMFrameGen {
@@ -21,8 +20,10 @@ namespace Core {
 
 /**
  * Callback type for present hook
+ *
+ * A plain function pointer: it runs every frame and must not allocate
  */
-using PresentCallback = std::function<void(IDXGISwapChain*)>;
+using PresentCallback = void (*)(IDXGISwapChain*);
 
 /**
  * DirectX 11 Hooks Manager
@@ -137,7 +138,7 @@ private:
     HWND m_GameWindow = nullptr;
     
     // Callbacks
-    PresentCallback m_PresentCallback;
+    PresentCallback m_PresentCallback = nullptr;
     
     // Original function pointers
     using PresentFn = HRESULT(STDMETHODCALLTYPE*)(IDXGISwapChain*, UINT, UINT);
@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * sRGB Transfer Function
+ *
+ * Compile-time lookup tables for converting 8-bit sRGB to linear light and
+ * back, so the CPU kernels can blend in linear space without any pow()
+ * calls at run time.
+ */
+
+#ifndef FIVEM_FRAMEGEN_COLOR_SPACE_H
+#define FIVEM_FRAMEGEN_COLOR_SPACE_H
+
+#include <array>
+#include <cstdint>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+namespace ColorSpace {
+
+// Linear values are 16-bit fixed point (65535 = 1.0)
+static constexpr uint32_t LINEAR_BITS = 16;
+static constexpr uint32_t LINEAR_MAX = (1u << LINEAR_BITS) - 1;
+
+// Linear -> sRGB table is indexed by the top bits of the linear value.
+// 12 bits keeps every 8-bit code in its own bucket, so a decode/encode
+// round trip is exact.
+static constexpr uint32_t ENCODE_LUT_BITS = 12;
+static constexpr uint32_t ENCODE_LUT_SIZE = 1u << ENCODE_LUT_BITS;
+static constexpr uint32_t ENCODE_SHIFT = LINEAR_BITS - ENCODE_LUT_BITS;
+
+namespace Detail {
+
+/**
+ * a^(1/5) by Newton iteration; converges from 1 for a in (0, 1]
+ */
+constexpr double FifthRoot(double a) {
+    double y = 1.0;
+    for (int i = 0; i < 24; ++i) {
+        double y4 = (y * y) * (y * y);
+        y -= (y4 * y - a) / (5.0 * y4);
+    }
+    return y;
+}
+
+/**
+ * IEC 61966-2-1 decode, c in [0, 1]
+ */
+constexpr double SrgbToLinear(double c) {
+    if (c <= 0.04045) return c / 12.92;
+    double x = (c + 0.055) / 1.055;
+    // x^2.4 = x^2 * (x^2)^(1/5)
+    return x * x * FifthRoot(x * x);
+}
+
+constexpr std::array<uint16_t, 256> MakeDecodeLut() {
+    std::array<uint16_t, 256> lut = {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        lut[i] = static_cast<uint16_t>(SrgbToLinear(i / 255.0) * LINEAR_MAX + 0.5);
+    }
+    return lut;
+}
+
+/**
+ * Invert the decode table: each bucket maps to the code whose linear value
+ * is nearest the bucket centre. One monotonic sweep, no transcendental math.
+ */
+constexpr std::array<uint8_t, ENCODE_LUT_SIZE> MakeEncodeLut(const std::array<uint16_t, 256>& decode) {
+    std::array<uint8_t, ENCODE_LUT_SIZE> lut = {};
+    uint32_t code = 0;
+    for (uint32_t i = 0; i < ENCODE_LUT_SIZE; ++i) {
+        uint32_t center = (i << ENCODE_SHIFT) + (1u << ENCODE_SHIFT) / 2;
+        while (code < 255 && decode[code] + decode[code + 1] < 2 * center) {
+            ++code;
+        }
+        lut[i] = static_cast<uint8_t>(code);
+    }
+    return lut;
+}
+
+} // namespace Detail
+
+inline constexpr std::array<uint16_t, 256> DecodeLut = Detail::MakeDecodeLut();
+inline constexpr std::array<uint8_t, ENCODE_LUT_SIZE> EncodeLut = Detail::MakeEncodeLut(DecodeLut);
+
+static_assert(DecodeLut[0] == 0 && DecodeLut[255] == LINEAR_MAX, "decode table endpoints");
+static_assert(EncodeLut[DecodeLut[128] >> ENCODE_SHIFT] == 128, "decode/encode round trip");
+
+/**
+ * 8-bit sRGB code -> 16-bit linear
+ */
+inline uint32_t ToLinear(uint32_t code) {
+    return DecodeLut[code];
+}
+
+/**
+ * 16-bit linear -> 8-bit sRGB code
+ */
+inline uint32_t ToSrgb(uint32_t linear) {
+    return EncodeLut[linear >> ENCODE_SHIFT];
+}
+
+} // namespace ColorSpace
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_COLOR_SPACE_H
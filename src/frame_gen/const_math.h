@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Compile-Time Math
+ *
+ * constexpr stand-ins for the <cmath> functions the kernel weight tables
+ * are built from, so the tables can live in read-only data.
+ */
+
+#ifndef FIVEM_FRAMEGEN_CONST_MATH_H
+#define FIVEM_FRAMEGEN_CONST_MATH_H
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+namespace ConstMath {
+
+inline constexpr double PI = 3.14159265358979323846;
+
+/**
+ * sin(x) by Taylor series after reduction to [-pi, pi]
+ */
+constexpr double Sin(double x) {
+    while (x > PI) x -= 2.0 * PI;
+    while (x < -PI) x += 2.0 * PI;
+
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 16; ++n) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * Normalised sinc, sin(pi x) / (pi x)
+ */
+constexpr double Sinc(double x) {
+    return x == 0.0 ? 1.0 : Sin(PI * x) / (PI * x);
+}
+
+} // namespace ConstMath
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_CONST_MATH_H
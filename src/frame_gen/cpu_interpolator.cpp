@@ -0,0 +1,1027 @@
+/**
+ * CPU Interpolation Engine Implementation
+ */
+
+#include "cpu_interpolator.h"
+#include "../utils/logger.h"
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+CpuInterpolator::CpuInterpolator() = default;
+
+CpuInterpolator::~CpuInterpolator() {
+    Shutdown();
+}
+
+bool CpuInterpolator::Initialize(uint32_t width, uint32_t height, PixelFormat format,
+                                 uint32_t motionBlockSize) {
+    if (width == 0 || height == 0 || motionBlockSize == 0) return false;
+
+    switch (format) {
+#define SELECT_KERNELS(f) \
+        case f: m_InterpolateFn = &CpuInterpolator::InterpolateFormat<f>; break;
+        FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(SELECT_KERNELS)
+#undef SELECT_KERNELS
+        default:
+            Utils::Logger::Error("Unsupported pixel format for CPU interpolation");
+            return false;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    m_Format = format;
+    m_MotionBlockSize = motionBlockSize;
+
+    uint32_t blocksX = (std::max)(width / motionBlockSize, 1u);
+    uint32_t blocksY = (std::max)(height / motionBlockSize, 1u);
+    if (!m_Occlusion.Initialize(blocksX, blocksY)) {
+        Utils::Logger::Error("Failed to initialize occlusion estimator");
+        return false;
+    }
+
+    if (!m_HoleFiller.Initialize(width, height, format)) {
+        Utils::Logger::Error("Failed to initialize hole filler");
+        return false;
+    }
+
+    if (!m_Tiles.Initialize(width, height)) {
+        Utils::Logger::Error("Failed to initialize tile classifier");
+        return false;
+    }
+    m_Tiles.SetStaticDetection(m_StaticTileSkip);
+    m_Tiles.SetMotionClasses(m_MotionTiers);
+
+    if (!m_Sharpener.Initialize(width, format)) {
+        Utils::Logger::Error("Failed to initialize sharpener");
+        return false;
+    }
+
+    if (m_HudLessMode && !m_HudMask.Initialize(width, height)) {
+        Utils::Logger::Error("Failed to initialize HUD mask");
+        return false;
+    }
+
+    if (m_TileReuse && !m_TileCache.Initialize(width, height, BytesPerPixel(format))) {
+        Utils::Logger::Error("Failed to initialize tile cache");
+        return false;
+    }
+
+    if (m_BilateralMotion && !m_MotionUpsampler.Initialize(width, height, motionBlockSize)) {
+        Utils::Logger::Error("Failed to initialize motion upsampler");
+        return false;
+    }
+
+    if (!m_Roi.Initialize(width, height)) {
+        Utils::Logger::Error("Failed to initialize ROI map");
+        return false;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(width) * BytesPerPixel(format);
+    m_FusedPitchBytes = FrameArena::PaddedPitch(rowBytes);
+    const size_t arenaBytes = 2 * FrameArena::PlaneBytes(width, height, 1) +
+                              FrameArena::AllocationBytes(3 * m_FusedPitchBytes) +
+                              FrameArena::AllocationBytes(rowBytes);
+    if (!m_Arena.Initialize(arenaBytes, m_HugePages)) {
+        Utils::Logger::Error("Failed to allocate interpolator planes");
+        return false;
+    }
+    m_BlendWeights = m_Arena.PersistentPlane<uint8_t>(width, height);
+    m_HoleMask = m_Arena.PersistentPlane<uint8_t>(width, height);
+    m_FusedRows = m_Arena.PersistentArray<uint8_t>(3 * m_FusedPitchBytes);
+    m_RoiRow = m_Arena.PersistentArray<uint8_t>(rowBytes);
+
+    if (m_TiledSources && !InitializeTiledSources()) {
+        Utils::Logger::Warn("Tiled warp sources unavailable, sampling linear frames");
+        m_TiledSources = false;
+    }
+
+    if (m_PlanarYCoCg && !InitializePlanarSources()) {
+        Utils::Logger::Warn("Planar YCoCg sources unavailable for %s, sampling linear frames",
+            GetPixelFormatName(format));
+        m_PlanarYCoCg = false;
+    }
+
+    if (m_HalfResolution && !InitializeHalfResolution()) {
+        Utils::Logger::Warn("Half-resolution interpolation unavailable, using full resolution");
+        m_HalfResolution = false;
+    }
+
+    m_Initialized = true;
+    Utils::Logger::Info("CPU interpolator initialized (%ux%u, %s)", width, height,
+        GetPixelFormatName(format));
+    return true;
+}
+
+void CpuInterpolator::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Occlusion.Shutdown();
+    m_HoleFiller.Shutdown();
+    m_Tiles.Shutdown();
+    m_Sharpener.Shutdown();
+    m_HudMask.Shutdown();
+    m_TileCache.Shutdown();
+    m_MotionUpsampler.Shutdown();
+    m_Roi.Shutdown();
+    m_BlendWeights = {};
+    m_HoleMask = {};
+    m_FusedRows = nullptr;
+    m_FusedPitchBytes = 0;
+    m_RoiRow = nullptr;
+    m_Arena.Shutdown();
+    ShutdownTiledSources();
+    ShutdownPlanarSources();
+    ShutdownHalfResolution();
+
+    m_Initialized = false;
+}
+
+bool CpuInterpolator::SetHalfResolution(bool enabled) {
+    if (enabled == m_HalfResolution) return true;
+
+    if (!enabled) {
+        ShutdownHalfResolution();
+        m_HalfResolution = false;
+        return true;
+    }
+
+    // Buffers are allocated by Initialize if we are not running yet
+    if (m_Initialized && !InitializeHalfResolution()) {
+        return false;
+    }
+    m_HalfResolution = true;
+    return true;
+}
+
+void CpuInterpolator::SetHudLessMode(bool enabled) {
+    if (enabled == m_HudLessMode) return;
+
+    // The mask lives at output resolution, so the half-res engine never needs one
+    if (!enabled) {
+        m_HudMask.Shutdown();
+    } else if (m_Initialized && !m_HudMask.Initialize(m_Width, m_Height)) {
+        return;
+    }
+    m_HudLessMode = enabled;
+}
+
+void CpuInterpolator::SetTileReuse(bool enabled) {
+    if (enabled == m_TileReuse) return;
+
+    if (!enabled) {
+        m_TileCache.Shutdown();
+    } else if (m_Initialized && !m_TileCache.Initialize(m_Width, m_Height, BytesPerPixel(m_Format))) {
+        return;
+    }
+    m_TileReuse = enabled;
+    if (m_HalfEngine) m_HalfEngine->SetTileReuse(enabled);
+}
+
+void CpuInterpolator::SetBilateralMotion(bool enabled) {
+    if (enabled == m_BilateralMotion) return;
+
+    if (!enabled) {
+        m_MotionUpsampler.Shutdown();
+    } else if (m_Initialized && !m_MotionUpsampler.Initialize(m_Width, m_Height, m_MotionBlockSize)) {
+        return;
+    }
+    m_BilateralMotion = enabled;
+    if (m_HalfEngine) m_HalfEngine->SetBilateralMotion(enabled);
+}
+
+bool CpuInterpolator::SetTiledSources(bool enabled) {
+    if (enabled == m_TiledSources) return true;
+
+    if (!enabled) {
+        ShutdownTiledSources();
+    } else if (m_Initialized && !InitializeTiledSources()) {
+        return false;
+    }
+    m_TiledSources = enabled;
+    if (m_HalfEngine) m_HalfEngine->SetTiledSources(enabled);
+    return true;
+}
+
+bool CpuInterpolator::InitializeTiledSources() {
+    const size_t frameBytes = TiledPlane<uint8_t>::ElementCount(m_Width, m_Height) * BytesPerPixel(m_Format);
+    if (!m_TiledArena.Initialize(2 * FrameArena::AllocationBytes(frameBytes), m_HugePages)) {
+        return false;
+    }
+    m_TiledFrames[0] = m_TiledArena.PersistentArray<uint8_t>(frameBytes);
+    m_TiledFrames[1] = m_TiledArena.PersistentArray<uint8_t>(frameBytes);
+    m_TiledPair.Clear();
+    return true;
+}
+
+void CpuInterpolator::ShutdownTiledSources() {
+    m_TiledFrames[0] = m_TiledFrames[1] = nullptr;
+    m_TiledPair.Clear();
+    m_TiledArena.Shutdown();
+}
+
+bool CpuInterpolator::SetPlanarYCoCg(bool enabled) {
+    if (enabled == m_PlanarYCoCg) return true;
+
+    if (!enabled) {
+        ShutdownPlanarSources();
+    } else if (m_Initialized && !InitializePlanarSources()) {
+        return false;
+    }
+    m_PlanarYCoCg = enabled;
+
+    // Planar calls do not track frames for the tiled copies, so their last
+    // current frame is stale either way
+    m_TiledPair.Clear();
+    if (m_HalfEngine) m_HalfEngine->SetPlanarYCoCg(enabled);
+    return true;
+}
+
+bool CpuInterpolator::InitializePlanarSources() {
+    if (m_Format != PixelFormat::RGBA8 && m_Format != PixelFormat::BGRA8) return false;
+
+    const uint32_t chromaWidth = YCoCgPlanes::ChromaSize(m_Width);
+    const uint32_t chromaHeight = YCoCgPlanes::ChromaSize(m_Height);
+    const size_t frameBytes = FrameArena::PlaneBytes(m_Width, m_Height, sizeof(uint8_t)) +
+                              2 * FrameArena::PlaneBytes(chromaWidth, chromaHeight, sizeof(int16_t));
+    if (!m_PlanarArena.Initialize(2 * frameBytes, m_HugePages)) {
+        return false;
+    }
+    for (int slot = 0; slot < 2; ++slot) {
+        m_PlanarLuma[slot] = m_PlanarArena.PersistentPlane<uint8_t>(m_Width, m_Height);
+        m_PlanarCo[slot] = m_PlanarArena.PersistentPlane<int16_t>(chromaWidth, chromaHeight);
+        m_PlanarCg[slot] = m_PlanarArena.PersistentPlane<int16_t>(chromaWidth, chromaHeight);
+    }
+    m_PlanarPair.Clear();
+    return true;
+}
+
+void CpuInterpolator::ShutdownPlanarSources() {
+    for (int slot = 0; slot < 2; ++slot) {
+        m_PlanarLuma[slot] = {};
+        m_PlanarCo[slot] = {};
+        m_PlanarCg[slot] = {};
+    }
+    m_PlanarPair.Clear();
+    m_PlanarArena.Shutdown();
+}
+
+void CpuInterpolator::ConvertedPair::Assign(const void* prev, const void* curr, bool& convertPrev) {
+    // In a steady stream the last current frame is this previous one, so
+    // only the new frame is converted, into the slot the old previous held
+    convertPrev = prev != lastCurrent || prev == curr;
+    if (convertPrev) {
+        prevSlot = 0;
+    } else {
+        prevSlot = currSlot;
+    }
+    currSlot = 1 - prevSlot;
+    lastCurrent = curr;
+}
+
+template <PixelFormat F>
+void CpuInterpolator::PrepareTiledSources(const ConstFormatPlane<F>& framePrev,
+                                          const ConstFormatPlane<F>& frameCurrent) {
+    using Storage = PixelStorage<F>;
+
+    auto convert = [&](const ConstFormatPlane<F>& frame, int slot) {
+        auto tiled = TiledPlane<Storage>::Wrap(reinterpret_cast<Storage*>(m_TiledFrames[slot]), m_Width, m_Height);
+        ConvertToTiled<Storage>(frame, tiled);
+        ++m_LastStats.sourceConversions;
+    };
+
+    bool convertPrev;
+    m_TiledPair.Assign(framePrev.data, frameCurrent.data, convertPrev);
+    if (convertPrev) convert(framePrev, m_TiledPair.prevSlot);
+    convert(frameCurrent, m_TiledPair.currSlot);
+}
+
+template <PixelFormat F>
+void CpuInterpolator::PreparePlanarSources(const ConstFormatPlane<F>& framePrev,
+                                           const ConstFormatPlane<F>& frameCurrent) {
+    auto convert = [&](const ConstFormatPlane<F>& frame, int slot) {
+        ConvertToYCoCg<F>(frame, m_PlanarLuma[slot], m_PlanarCo[slot], m_PlanarCg[slot]);
+        ++m_LastStats.sourceConversions;
+    };
+
+    bool convertPrev;
+    m_PlanarPair.Assign(framePrev.data, frameCurrent.data, convertPrev);
+    if (convertPrev) convert(framePrev, m_PlanarPair.prevSlot);
+    convert(frameCurrent, m_PlanarPair.currSlot);
+}
+
+bool CpuInterpolator::InitializeHalfResolution() {
+    uint32_t halfWidth = m_Width / 2;
+    uint32_t halfHeight = m_Height / 2;
+    if (halfWidth == 0 || halfHeight == 0 || m_MotionBlockSize < 2) return false;
+
+    // Same vector grid, half the pixels per block
+    m_HalfEngine = std::make_unique<CpuInterpolator>();
+    m_HalfEngine->SetHugePages(m_HugePages);
+    if (!m_HalfEngine->Initialize(halfWidth, halfHeight, m_Format, m_MotionBlockSize / 2)) {
+        m_HalfEngine.reset();
+        return false;
+    }
+    m_HalfEngine->SetOcclusionAware(m_OcclusionAware);
+    m_HalfEngine->SetHoleFilling(m_HoleFilling);
+    m_HalfEngine->SetStaticTileSkip(m_StaticTileSkip);
+    m_HalfEngine->SetMotionTiers(m_MotionTiers);
+    m_HalfEngine->SetTileReuse(m_TileReuse);
+    m_HalfEngine->SetLinearBlending(m_LinearBlending);
+    m_HalfEngine->SetOverlappedBlocks(m_OverlappedBlocks);
+    m_HalfEngine->SetBilateralMotion(m_BilateralMotion);
+    m_HalfEngine->SetWarpFilter(m_WarpFilter);
+    m_HalfEngine->SetTiledSources(m_TiledSources);
+    m_HalfEngine->SetPlanarYCoCg(m_PlanarYCoCg);
+    m_HalfEngine->m_Roi.SetShape(m_Roi);
+
+    if (!m_Upsampler.Initialize(m_Width, m_Height)) {
+        m_HalfEngine.reset();
+        return false;
+    }
+
+    // Three half-size frames, plus a frame region for the halved vectors
+    const size_t halfPitchBytes = FrameArena::PaddedPitch(static_cast<size_t>(halfWidth) * BytesPerPixel(m_Format));
+    const size_t vectorCount = static_cast<size_t>(m_Width / m_MotionBlockSize + 1) *
+                               (m_Height / m_MotionBlockSize + 1);
+    const size_t arenaBytes = 3 * halfPitchBytes * halfHeight +
+                              FrameArena::AllocationBytes(vectorCount * sizeof(MotionVector));
+    if (!m_HalfArena.Initialize(arenaBytes, m_HugePages)) {
+        m_HalfEngine.reset();
+        m_Upsampler.Shutdown();
+        return false;
+    }
+
+    m_HalfPrev = { m_HalfArena.AllocatePersistent(halfPitchBytes * halfHeight), halfWidth, halfHeight, halfPitchBytes };
+    m_HalfCurr = { m_HalfArena.AllocatePersistent(halfPitchBytes * halfHeight), halfWidth, halfHeight, halfPitchBytes };
+    m_HalfOutput = { m_HalfArena.AllocatePersistent(halfPitchBytes * halfHeight), halfWidth, halfHeight, halfPitchBytes };
+    return true;
+}
+
+void CpuInterpolator::ShutdownHalfResolution() {
+    m_HalfEngine.reset();
+    m_Upsampler.Shutdown();
+    m_HalfPrev = {};
+    m_HalfCurr = {};
+    m_HalfOutput = {};
+    m_HalfArena.Shutdown();
+}
+
+bool CpuInterpolator::Interpolate(
+    const ConstImageView& framePrev,
+    const ConstImageView& frameCurrent,
+    const MotionField& motion,
+    const ImageView& output,
+    float interpolationFactor
+) {
+    if (!m_Initialized) return false;
+    if (!framePrev.IsValid() || !frameCurrent.IsValid() || !output.IsValid() || !motion.IsValid()) {
+        return false;
+    }
+    if (output.width != m_Width || output.height != m_Height ||
+        framePrev.width != m_Width || framePrev.height != m_Height ||
+        frameCurrent.width != m_Width || frameCurrent.height != m_Height) {
+        return false;
+    }
+
+    float t = std::clamp(interpolationFactor, 0.0f, 1.0f);
+    return (this->*m_InterpolateFn)(framePrev, frameCurrent, motion, output, t);
+}
+
+template <PixelFormat F>
+bool CpuInterpolator::InterpolateFormat(
+    const ConstImageView& framePrev,
+    const ConstImageView& frameCurrent,
+    const MotionField& motion,
+    const ImageView& output,
+    float interpolationFactor
+) {
+    using Storage = PixelStorage<F>;
+
+    ConstFormatPlane<F> prev = framePrev.As<const Storage>();
+    ConstFormatPlane<F> curr = frameCurrent.As<const Storage>();
+    FormatPlane<F> out = output.As<Storage>();
+
+    if (m_HudLessMode) {
+        m_HudMask.Update<F>(prev, curr);
+    }
+
+    const bool sharpen = m_Sharpness > 0.0f;
+    if (m_HalfResolution && m_HalfEngine) {
+        if (!InterpolateHalfResolution<F>(prev, curr, motion, out, interpolationFactor)) {
+            return false;
+        }
+    } else {
+        // The fused kernel sharpens as it goes; the multi-pass one needs a separate pass
+        const bool fused = sharpen && m_FusedKernel;
+        InterpolateFullResolution<F>(prev, curr, motion, out, interpolationFactor, fused);
+        if (fused) return true;
+    }
+
+    // Sharpen the finished frame; skipped entirely when off
+    if (sharpen) {
+        m_Sharpener.Apply<F>(out, m_Sharpness);
+    }
+    return true;
+}
+
+template <PixelFormat F>
+bool CpuInterpolator::InterpolateFullResolution(
+    const ConstFormatPlane<F>& framePrev,
+    const ConstFormatPlane<F>& frameCurrent,
+    const MotionField& motion,
+    const FormatPlane<F>& output,
+    float interpolationFactor,
+    bool fusedSharpen
+) {
+    using Storage = PixelStorage<F>;
+    const float t = interpolationFactor;
+
+    m_LastStats = {};
+    m_LastStats.tilesTotal = m_Tiles.GetTileCount();
+    m_LastStats.fusedSharpen = fusedSharpen;
+
+    // Planar copies only exist for 8-bit formats
+    bool planar = false;
+    if constexpr (PixelTraits<F>::PACKED_8BIT) {
+        planar = m_PlanarYCoCg;
+        if (planar) {
+            PreparePlanarSources<F>(framePrev, frameCurrent);
+        }
+    }
+    if (m_TiledSources && !planar) {
+        PrepareTiledSources<F>(framePrev, frameCurrent);
+    }
+
+    if (m_StaticTileSkip || m_MotionTiers) {
+        m_LastStats.tilesStatic = m_Tiles.Classify(framePrev, frameCurrent, motion, BytesPerPixel(F));
+    }
+
+    if (m_OcclusionAware) {
+        m_Occlusion.Prepare(motion);
+    }
+
+    if (m_BilateralMotion && !m_OverlappedBlocks) {
+        if (planar) {
+            m_MotionUpsampler.Prepare(m_PlanarLuma[m_PlanarPair.prevSlot], motion);
+        } else {
+            m_MotionUpsampler.Prepare<F>(framePrev, motion);
+        }
+    }
+
+    if (m_TileReuse) {
+        Plane<const uint8_t> hudMask = m_HudLessMode ? m_HudMask.GetMask() : Plane<const uint8_t>{};
+        m_TileCache.Prepare(framePrev, frameCurrent, motion, hudMask, GetSettingsKey(t));
+    }
+
+    uint32_t holeCount = 0;
+
+    if (!fusedSharpen) {
+        for (uint32_t y = 0; y < m_Height; ++y) {
+            holeCount += InterpolateRow<F>(framePrev, frameCurrent, motion, output.Row(y), t, y);
+        }
+    } else {
+        // Rows are generated one ahead into a three-row ring and sharpened
+        // from there, so every output pixel is written exactly once
+        Storage* ring[3];
+        for (uint32_t i = 0; i < 3; ++i) {
+            ring[i] = reinterpret_cast<Storage*>(m_FusedRows + i * m_FusedPitchBytes);
+        }
+        uint32_t ringHoles[3] = {};
+
+        auto sharpenRow = [&](uint32_t y) {
+            const Storage* center = ring[y % 3];
+            const Storage* up = y > 0 ? ring[(y - 1) % 3] : center;
+            const Storage* down = y + 1 < m_Height ? ring[(y + 1) % 3] : center;
+            Storage* out = output.Row(y);
+            m_Sharpener.SharpenRow<F>(up, center, down, out, m_Width, m_Sharpness);
+
+            // Holes are not final until the fill; leave their neighbours unsharpened
+            uint32_t nearbyHoles = ringHoles[y % 3] +
+                (y > 0 ? ringHoles[(y - 1) % 3] : 0) + (y + 1 < m_Height ? ringHoles[(y + 1) % 3] : 0);
+            if (m_HoleFilling && nearbyHoles > 0) {
+                RestoreNearHoles<F>(center, out, y);
+            }
+        };
+
+        for (uint32_t y = 0; y < m_Height; ++y) {
+            ringHoles[y % 3] = InterpolateRow<F>(framePrev, frameCurrent, motion, ring[y % 3], t, y);
+            holeCount += ringHoles[y % 3];
+            if (y > 0) sharpenRow(y - 1);
+        }
+        sharpenRow(m_Height - 1);
+    }
+
+    if (m_TileReuse) {
+        m_TileCache.Commit();
+    }
+
+    if (m_HoleFilling && holeCount > 0) {
+        Plane<const uint8_t> holes = m_HoleMask;
+        m_LastStats.tilesHoleFilled = m_HoleFiller.Fill<F>(output, holes);
+    }
+
+    return true;
+}
+
+uint64_t CpuInterpolator::GetSettingsKey(float interpolationFactor) const {
+    uint64_t modes = (m_OcclusionAware ? 1u : 0u) |
+                     (m_LinearBlending ? 2u : 0u) |
+                     (m_HudLessMode ? 4u : 0u) |
+                     (m_BilateralMotion ? 8u : 0u) |
+                     (m_OverlappedBlocks ? 16u : 0u) |
+                     (m_MotionTiers ? 32u : 0u) |
+                     (m_PlanarYCoCg ? 64u : 0u) |
+                     (m_TiledSources ? 128u : 0u) |
+                     (static_cast<uint32_t>(m_WarpFilter) << 8);
+    uint64_t key = (static_cast<uint64_t>(std::bit_cast<uint32_t>(interpolationFactor)) << 32) | modes;
+
+    if (m_OcclusionAware) {
+        uint64_t occlusion = (static_cast<uint64_t>(std::bit_cast<uint32_t>(m_Occlusion.GetStrength())) << 32) |
+                             std::bit_cast<uint32_t>(m_Occlusion.GetHoleThreshold());
+        key ^= occlusion * 0x9E3779B97F4A7C15ull;
+    }
+
+    // Tiers and weights are fixed per tile for a given shape
+    key ^= m_Roi.GetKey();
+    return key;
+}
+
+template <PixelFormat F>
+bool CpuInterpolator::InterpolateHalfResolution(
+    const ConstFormatPlane<F>& framePrev,
+    const ConstFormatPlane<F>& frameCurrent,
+    const MotionField& motion,
+    const FormatPlane<F>& output,
+    float interpolationFactor
+) {
+    using Storage = PixelStorage<F>;
+    FormatPlane<F> halfPrev = m_HalfPrev.As<Storage>();
+    FormatPlane<F> halfCurr = m_HalfCurr.As<Storage>();
+    FormatPlane<F> halfOutput = m_HalfOutput.As<Storage>();
+
+    DownsampleBox2x<F>(framePrev, halfPrev);
+    DownsampleBox2x<F>(frameCurrent, halfCurr);
+
+    // The half frames are rewritten in place every call
+    m_HalfEngine->InvalidateSources();
+
+    // Vectors are in pixels, so they halve along with the image
+    size_t vectorCount = static_cast<size_t>(motion.blocksX) * motion.blocksY;
+    MotionVector* halfVectors = m_HalfArena.FrameArray<MotionVector>(vectorCount);
+    if (!halfVectors) return false;
+    for (size_t i = 0; i < vectorCount; ++i) {
+        halfVectors[i].x = motion.vectors[i].x * 0.5f;
+        halfVectors[i].y = motion.vectors[i].y * 0.5f;
+    }
+    MotionField halfMotion = { halfVectors, motion.blocksX, motion.blocksY,
+        (std::max)(motion.blockSize / 2, 1u) };
+
+    const bool interpolated = m_HalfEngine->Interpolate(halfPrev, halfCurr, halfMotion, halfOutput,
+                                                        interpolationFactor);
+    m_HalfArena.ResetFrame();
+    if (!interpolated) {
+        return false;
+    }
+
+    // The current real frame supplies the high-frequency edges
+    m_Upsampler.Upsample<F>(halfOutput, frameCurrent, output);
+
+    m_LastStats = m_HalfEngine->GetLastFrameStats();
+    m_LastStats.halfResolution = true;
+
+    // The half-res pass cannot see the full-res mask; patch HUD in afterwards
+    if (m_HudLessMode && m_HudMask.GetMaskedTileCount() > 0) {
+        for (uint32_t ty = 0; ty < m_HudMask.GetTilesY(); ++ty) {
+            for (uint32_t tx = 0; tx < m_HudMask.GetTilesX(); ++tx) {
+                if (m_HudMask.GetTileCoverage(tx, ty) == 0) continue;
+
+                uint32_t x0, y0, x1, y1;
+                m_Tiles.GetTileRect(tx, ty, x0, y0, x1, y1);
+                for (uint32_t y = y0; y < y1; ++y) {
+                    CopyHudPixels<F>(frameCurrent.Row(y), output.Row(y), y, x0, x1);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <PixelFormat F>
+uint32_t CpuInterpolator::InterpolateRow(
+    const ConstFormatPlane<F>& framePrev,
+    const ConstFormatPlane<F>& frameCurrent,
+    const MotionField& motion,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y
+) {
+    const float t = interpolationFactor;
+    const uint32_t ty = y / TileClassifier::TILE_SIZE;
+    const bool firstTileRow = (y % TileClassifier::TILE_SIZE) == 0;
+    const PixelStorage<F>* current = frameCurrent.Row(y);
+    const bool classified = m_StaticTileSkip || m_MotionTiers;
+    uint8_t* weights = m_BlendWeights.Row(y);
+    uint8_t* holes = m_HoleMask.Row(y);
+    const uint8_t lerpWeight = static_cast<uint8_t>(t * 255.0f + 0.5f);
+
+    // Per-pixel flow is generated a band of block rows at a time
+    const MotionVector* flow = nullptr;
+    if (m_BilateralMotion && !m_OverlappedBlocks && motion.blockSize == m_MotionUpsampler.GetBlockSize()) {
+        if (y % motion.blockSize == 0) {
+            m_MotionUpsampler.UpsampleBand(motion, y);
+        }
+        flow = m_MotionUpsampler.GetRow(y);
+    }
+
+    uint32_t holeCount = 0;
+
+    for (uint32_t tx = 0; tx < m_Tiles.GetTilesX(); ++tx) {
+        uint32_t x0, y0, x1, y1;
+        m_Tiles.GetTileRect(tx, ty, x0, y0, x1, y1);
+        const size_t spanBytes = (x1 - x0) * sizeof(PixelStorage<F>);
+
+        // Static tiles never contain holes
+        const TileClass tileClass = classified ? m_Tiles.GetClass(tx, ty) : TileClass::Dynamic;
+        if (tileClass == TileClass::Static) {
+            std::memcpy(out + x0, current + x0, spanBytes);
+            std::memset(holes + x0, 0, x1 - x0);
+            continue;
+        }
+
+        const uint32_t hudPixels = m_HudLessMode ? m_HudMask.GetTileCoverage(tx, ty) : 0;
+        if (hudPixels == (x1 - x0) * (y1 - y0)) {
+            std::memcpy(out + x0, current + x0, spanBytes);
+            std::memset(holes + x0, 0, x1 - x0);
+            if (firstTileRow) ++m_LastStats.tilesHud;
+            continue;
+        }
+
+        // Unchanged inputs: last frame's warp output for this tile is still exact
+        const bool cacheable = m_TileReuse && m_TileCache.IsCacheable(tx, ty);
+        if (cacheable) {
+            if (firstTileRow) ++m_LastStats.tilesReuseLookups;
+            if (m_TileCache.IsHit(tx, ty)) {
+                holeCount += m_TileCache.Load(y, x0, x1, out, holes);
+                if (firstTileRow) ++m_LastStats.tilesReused;
+                continue;
+            }
+        }
+
+        // Cheaper kernels by motion class, then by focus region: outside
+        // the ROI the cheap tier is the result; in the feather band each
+        // path runs only where its weight is non-zero and the two are
+        // blended per pixel
+        const RoiTier tier = tileClass == TileClass::Dynamic ? m_Roi.GetTier(tx, ty) : RoiTier::Outside;
+        uint32_t fullX0 = x0, fullX1 = x1;
+        if (tileClass == TileClass::Blend) {
+            CrossFadeSpan<F>(framePrev.Row(y), current, out, t, y, x0, x1);
+            fullX1 = fullX0;
+            if (firstTileRow) ++m_LastStats.tilesBlended;
+        } else if (tier == RoiTier::Outside) {
+            holeCount += WarpReducedSpan<F>(framePrev, frameCurrent, motion, out, t, y, x0, x1);
+            fullX1 = fullX0;
+            if (firstTileRow) ++(tileClass == TileClass::Warp ? m_LastStats.tilesWarped : m_LastStats.tilesRoiReduced);
+        } else if (tier == RoiTier::Transition) {
+            const uint8_t* roi = m_Roi.GetWeightRow(y);
+            PixelStorage<F>* reduced = reinterpret_cast<PixelStorage<F>*>(m_RoiRow);
+            uint32_t reducedX0 = x1, reducedX1 = x0;
+            fullX0 = x1;
+            fullX1 = x0;
+            for (uint32_t x = x0; x < x1; ++x) {
+                if (roi[x] < 255) { reducedX0 = (std::min)(reducedX0, x); reducedX1 = x + 1; }
+                if (roi[x] > 0) { fullX0 = (std::min)(fullX0, x); fullX1 = x + 1; }
+            }
+
+            // Its holes where the full path also runs are superseded below
+            if (reducedX0 < reducedX1) {
+                holeCount += WarpReducedSpan<F>(framePrev, frameCurrent, motion, reduced, t, y,
+                                                reducedX0, reducedX1);
+            }
+            if (firstTileRow) ++m_LastStats.tilesRoiBlended;
+        }
+
+        if (fullX0 < fullX1) {
+            if (m_OcclusionAware) {
+                holeCount += m_Occlusion.EstimateRect(motion, t, m_BlendWeights, m_HoleMask, fullX0, y, fullX1, y + 1);
+            } else {
+                std::fill(weights + fullX0, weights + fullX1, lerpWeight);
+                std::fill(holes + fullX0, holes + fullX1, static_cast<uint8_t>(0));
+            }
+
+            holeCount += WarpSpan<F>(framePrev, frameCurrent, motion, flow, out, t, y, fullX0, fullX1);
+        }
+
+        if (tier == RoiTier::Transition) {
+            // Weight 0 selects the cheap pixel exactly and 255 the full one
+            const PixelStorage<F>* reduced = reinterpret_cast<const PixelStorage<F>*>(m_RoiRow);
+            const uint8_t* roi = m_Roi.GetWeightRow(y);
+            for (uint32_t x = x0; x < x1; ++x) {
+                uint32_t w = roi[x];
+                w += w >> 7;
+                out[x] = PixelTraits<F>::Lerp(reduced[x], out[x], w);
+            }
+        }
+
+        if (hudPixels > 0) {
+            CopyHudPixels<F>(current, out, y, x0, x1);
+        }
+
+        if (cacheable) {
+            m_TileCache.Store(tx, y, x0, x1, out, holes);
+        }
+    }
+
+    return holeCount;
+}
+
+template <PixelFormat F>
+void CpuInterpolator::CopyHudPixels(
+    const PixelStorage<F>* current,
+    PixelStorage<F>* out,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    const uint8_t* hud = m_HudMask.GetMask().Row(y);
+    uint8_t* holes = m_HoleMask.Row(y);
+    for (uint32_t x = x0; x < x1; ++x) {
+        if (hud[x]) {
+            out[x] = current[x];
+            holes[x] = 0;
+        }
+    }
+}
+
+template <PixelFormat F>
+void CpuInterpolator::RestoreNearHoles(const PixelStorage<F>* unsharpened, PixelStorage<F>* out, uint32_t y) {
+    const uint8_t* holes = m_HoleMask.Row(y);
+    const uint8_t* holesUp = y > 0 ? m_HoleMask.Row(y - 1) : holes;
+    const uint8_t* holesDown = y + 1 < m_Height ? m_HoleMask.Row(y + 1) : holes;
+
+    for (uint32_t x = 0; x < m_Width; ++x) {
+        bool nearHole = holes[x] || holesUp[x] || holesDown[x] ||
+                        (x > 0 && holes[x - 1]) || (x + 1 < m_Width && holes[x + 1]);
+        if (nearHole) {
+            out[x] = unsharpened[x];
+        }
+    }
+}
+
+template <PixelFormat F>
+uint32_t CpuInterpolator::WarpSpan(
+    const ConstFormatPlane<F>& framePrev,
+    const ConstFormatPlane<F>& frameCurrent,
+    const MotionField& motion,
+    const MotionVector* flow,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    const float t = interpolationFactor;
+
+    // Every setting is a template parameter of the row kernels, so the
+    // per-pixel loops never branch on them
+    auto warpFrom = [&](const auto& prev, const auto& curr, auto filter) {
+        constexpr WarpFilter Filter = decltype(filter)::value;
+        if (m_OverlappedBlocks) {
+            return m_LinearBlending
+                ? ObmcBlendRow<F, true, Filter>(prev, curr, motion, out, t, y, x0, x1)
+                : ObmcBlendRow<F, false, Filter>(prev, curr, motion, out, t, y, x0, x1);
+        }
+        return m_LinearBlending
+            ? WarpBlendRow<F, true, Filter>(prev, curr, motion, flow, out, t, y, x0, x1)
+            : WarpBlendRow<F, false, Filter>(prev, curr, motion, flow, out, t, y, x0, x1);
+    };
+    auto warp = [&](auto filter) {
+        if constexpr (PixelTraits<F>::PACKED_8BIT) {
+            if (m_PlanarYCoCg) {
+                return warpFrom(PlanarSource(m_PlanarPair.prevSlot), PlanarSource(m_PlanarPair.currSlot), filter);
+            }
+        }
+        if (m_TiledSources) {
+            return warpFrom(TiledSource<F>(m_TiledPair.prevSlot), TiledSource<F>(m_TiledPair.currSlot), filter);
+        }
+        return warpFrom(framePrev, frameCurrent, filter);
+    };
+
+    switch (m_WarpFilter) {
+        case WarpFilter::CatmullRom:
+            return warp(std::integral_constant<WarpFilter, WarpFilter::CatmullRom>{});
+        case WarpFilter::Lanczos2:
+            return warp(std::integral_constant<WarpFilter, WarpFilter::Lanczos2>{});
+        case WarpFilter::Bilinear:
+        default:
+            return warp(std::integral_constant<WarpFilter, WarpFilter::Bilinear>{});
+    }
+}
+
+template <PixelFormat F>
+void CpuInterpolator::CrossFadeSpan(
+    const PixelStorage<F>* previous,
+    const PixelStorage<F>* current,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    using Traits = PixelTraits<F>;
+
+    std::fill(m_HoleMask.Row(y) + x0, m_HoleMask.Row(y) + x1, static_cast<uint8_t>(0));
+
+    // Expand 0-255 to 0-256 like the warp kernels, so zero motion matches them exactly
+    uint32_t w = static_cast<uint32_t>(interpolationFactor * 255.0f + 0.5f);
+    w += w >> 7;
+
+    if (m_LinearBlending) {
+        for (uint32_t x = x0; x < x1; ++x) out[x] = Traits::LerpLinearLight(previous[x], current[x], w);
+    } else {
+        for (uint32_t x = x0; x < x1; ++x) out[x] = Traits::Lerp(previous[x], current[x], w);
+    }
+}
+
+template <PixelFormat F>
+uint32_t CpuInterpolator::WarpReducedSpan(
+    const ConstFormatPlane<F>& framePrev,
+    const ConstFormatPlane<F>& frameCurrent,
+    const MotionField& motion,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    uint8_t* weights = m_BlendWeights.Row(y);
+    uint8_t* holes = m_HoleMask.Row(y);
+    std::fill(weights + x0, weights + x1, static_cast<uint8_t>(interpolationFactor * 255.0f + 0.5f));
+    std::fill(holes + x0, holes + x1, static_cast<uint8_t>(0));
+
+    if constexpr (PixelTraits<F>::PACKED_8BIT) {
+        if (m_PlanarYCoCg) {
+            return WarpBlendRow<F, false, WarpFilter::Bilinear>(PlanarSource(m_PlanarPair.prevSlot),
+                PlanarSource(m_PlanarPair.currSlot), motion, nullptr, out, interpolationFactor, y, x0, x1);
+        }
+    }
+    if (m_TiledSources) {
+        return WarpBlendRow<F, false, WarpFilter::Bilinear>(TiledSource<F>(m_TiledPair.prevSlot),
+            TiledSource<F>(m_TiledPair.currSlot), motion, nullptr, out, interpolationFactor, y, x0, x1);
+    }
+    return WarpBlendRow<F, false, WarpFilter::Bilinear>(
+        framePrev, frameCurrent, motion, nullptr, out, interpolationFactor, y, x0, x1);
+}
+
+template <PixelFormat F, bool LinearLight, WarpFilter Filter, typename Source>
+uint32_t CpuInterpolator::WarpBlendRow(
+    const Source& framePrev,
+    const Source& frameCurrent,
+    const MotionField& motion,
+    const MotionVector* flow,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    using Traits = PixelTraits<F>;
+    using Storage = PixelStorage<F>;
+
+    const float t = interpolationFactor;
+    const float width = static_cast<float>(m_Width);
+    const float height = static_cast<float>(m_Height);
+    uint32_t holeCount = 0;
+
+    auto inside = [&](float x, float y) {
+        return x >= 0.0f && y >= 0.0f && x <= width && y <= height;
+    };
+
+    const uint8_t* weights = m_BlendWeights.Row(y);
+    uint8_t* holes = m_HoleMask.Row(y);
+    const float py = y + 0.5f;
+
+    for (uint32_t x = x0; x < x1; ++x) {
+        const float px = x + 0.5f;
+        MotionVector m = flow ? flow[x] : motion.Sample(px, py);
+
+        float prevX = px - m.x * t, prevY = py - m.y * t;
+        float currX = px + m.x * (1.0f - t), currY = py + m.y * (1.0f - t);
+
+        Storage prevColor = SampleWarp<F, Filter>(framePrev, prevX, prevY);
+        Storage currColor = SampleWarp<F, Filter>(frameCurrent, currX, currY);
+
+        // Expand 0-255 to 0-256 so a full weight selects the source exactly
+        uint32_t w = weights[x];
+        w += w >> 7;
+
+        // A sample warped off-screen is clamped garbage; use the other one
+        bool prevInside = inside(prevX, prevY);
+        bool currInside = inside(currX, currY);
+        if (!prevInside && currInside) {
+            w = 256;
+        } else if (prevInside && !currInside) {
+            w = 0;
+        } else if (!prevInside && !currInside && !holes[x]) {
+            holes[x] = 1;
+            ++holeCount;
+        }
+
+        if constexpr (LinearLight) {
+            out[x] = Traits::LerpLinearLight(prevColor, currColor, w);
+        } else {
+            out[x] = Traits::Lerp(prevColor, currColor, w);
+        }
+    }
+
+    return holeCount;
+}
+
+template <PixelFormat F, bool LinearLight, WarpFilter Filter, typename Source>
+uint32_t CpuInterpolator::ObmcBlendRow(
+    const Source& framePrev,
+    const Source& frameCurrent,
+    const MotionField& motion,
+    PixelStorage<F>* out,
+    float interpolationFactor,
+    uint32_t y, uint32_t x0, uint32_t x1
+) {
+    using Traits = PixelTraits<F>;
+    using Storage = PixelStorage<F>;
+
+    const float t = interpolationFactor;
+    const float width = static_cast<float>(m_Width);
+    const float height = static_cast<float>(m_Height);
+    uint32_t holeCount = 0;
+
+    auto inside = [&](float x, float y) {
+        return x >= 0.0f && y >= 0.0f && x <= width && y <= height;
+    };
+
+    const uint8_t* weights = m_BlendWeights.Row(y);
+    uint8_t* holes = m_HoleMask.Row(y);
+    const float py = y + 0.5f;
+
+    // The vertical pair of blocks and their window weights are fixed for the row
+    int by0;
+    const uint32_t wy0 = Obmc::AxisTaps(y, motion.blockSize, by0);
+    const uint32_t wy1 = Obmc::WEIGHT_ONE - wy0;
+
+    for (uint32_t x = x0; x < x1; ++x) {
+        const float px = x + 0.5f;
+
+        // Expand 0-255 to 0-256 so a full weight selects the source exactly
+        uint32_t blend = weights[x];
+        blend += blend >> 7;
+
+        // One hypothesis: warp both frames along m, falling back to whichever
+        // sample stays on-screen
+        bool usable = false;
+        auto predict = [&](const MotionVector& m) {
+            float prevX = px - m.x * t, prevY = py - m.y * t;
+            float currX = px + m.x * (1.0f - t), currY = py + m.y * (1.0f - t);
+
+            Storage prevColor = SampleWarp<F, Filter>(framePrev, prevX, prevY);
+            Storage currColor = SampleWarp<F, Filter>(frameCurrent, currX, currY);
+
+            uint32_t w = blend;
+            bool prevInside = inside(prevX, prevY);
+            bool currInside = inside(currX, currY);
+            if (!prevInside && currInside) {
+                w = 256;
+            } else if (prevInside && !currInside) {
+                w = 0;
+            }
+            usable |= prevInside || currInside;
+
+            if constexpr (LinearLight) {
+                return Traits::LerpLinearLight(prevColor, currColor, w);
+            } else {
+                return Traits::Lerp(prevColor, currColor, w);
+            }
+        };
+
+        int bx0;
+        const uint32_t wx0 = Obmc::AxisTaps(x, motion.blockSize, bx0);
+        const uint32_t wx1 = Obmc::WEIGHT_ONE - wx0;
+
+        const MotionVector& m00 = motion.Block(bx0, by0);
+        const MotionVector& m10 = motion.Block(bx0 + 1, by0);
+        const MotionVector& m01 = motion.Block(bx0, by0 + 1);
+        const MotionVector& m11 = motion.Block(bx0 + 1, by0 + 1);
+
+        // Inside a uniformly moving region every hypothesis is the same
+        auto same = [](const MotionVector& a, const MotionVector& b) { return a.x == b.x && a.y == b.y; };
+        if (same(m00, m10) && same(m00, m01) && same(m00, m11)) {
+            out[x] = predict(m00);
+        } else {
+            const Storage predictions[4] = { predict(m00), predict(m10), predict(m01), predict(m11) };
+            const uint32_t windowWeights[4] = { wx0 * wy0, wx1 * wy0, wx0 * wy1, wx1 * wy1 };
+            out[x] = Obmc::Combine4<F>(predictions, windowWeights);
+        }
+
+        if (!usable && !holes[x]) {
+            holes[x] = 1;
+            ++holeCount;
+        }
+    }
+
+    return holeCount;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
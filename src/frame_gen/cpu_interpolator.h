@@ -0,0 +1,600 @@
+#pragma once
+
+/**
+ * CPU Interpolation Engine
+ *
+ * Software implementation of the motion-compensated interpolation pass.
+ * Mirrors g_InterpolationPS so frames can be generated from CPU-side copies
+ * of the swap chain. Platform-neutral.
+ */
+
+#ifndef FIVEM_FRAMEGEN_CPU_INTERPOLATOR_H
+#define FIVEM_FRAMEGEN_CPU_INTERPOLATOR_H
+
+#include "pixel_format.h"
+#include "frame_arena.h"
+#include "occlusion.h"
+#include "obmc.h"
+#include "hole_fill.h"
+#include "hud_mask.h"
+#include "motion_upsample.h"
+#include "tile_classifier.h"
+#include "tile_cache.h"
+#include "resample.h"
+#include "roi_map.h"
+#include "sampling.h"
+#include "sharpen.h"
+#include "ycocg.h"
+#include <memory>
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * CPU motion-compensated frame interpolator
+ */
+class CpuInterpolator {
+public:
+    /**
+     * Per-frame work counters
+     */
+    struct FrameStats {
+        uint32_t tilesTotal = 0;
+        uint32_t tilesStatic = 0;       // Copied instead of interpolated
+        uint32_t tilesBlended = 0;      // Sub-pixel motion, cross-faded
+        uint32_t tilesWarped = 0;       // Coherent motion, bilinear warp only
+        uint32_t tilesHoleFilled = 0;   // Touched by the hole filler
+        uint32_t tilesHud = 0;          // Fully masked HUD, copied
+        uint32_t tilesReuseLookups = 0; // Cacheable tiles looked up in the tile cache
+        uint32_t tilesReused = 0;       // Cache hits, copied from the last generated frame
+        uint32_t tilesRoiReduced = 0;   // Outside the ROI, cheap path only
+        uint32_t tilesRoiBlended = 0;   // ROI feather band, both paths blended
+        uint32_t sourceConversions = 0; // Source frames converted to tiled or planar copies
+        bool halfResolution = false;    // Tile counts refer to the half-res pass
+        bool fusedSharpen = false;      // Sharpened inside the warp/blend pass
+
+        float StaticTileRatio() const {
+            return tilesTotal ? static_cast<float>(tilesStatic) / tilesTotal : 0.0f;
+        }
+
+        float ReuseHitRate() const {
+            return tilesReuseLookups ? static_cast<float>(tilesReused) / tilesReuseLookups : 0.0f;
+        }
+
+        float RoiReducedRatio() const {
+            return tilesTotal ? static_cast<float>(tilesRoiReduced) / tilesTotal : 0.0f;
+        }
+    };
+
+    CpuInterpolator();
+    ~CpuInterpolator();
+
+    /**
+     * Allocate working buffers and select the kernels for a frame format
+     *
+     * @param format Pixel format of every plane passed to Interpolate
+     * @param motionBlockSize Pixels per motion vector at this resolution
+     */
+    bool Initialize(uint32_t width, uint32_t height, PixelFormat format = PixelFormat::RGBA8,
+                    uint32_t motionBlockSize = 8);
+    void Shutdown();
+
+    /**
+     * Generate an intermediate frame
+     *
+     * @param framePrev Previous real frame
+     * @param frameCurrent Current real frame
+     * @param motion Block motion field (pixels, prev -> curr)
+     * @param output Destination plane, same size and format as the inputs
+     * @param interpolationFactor Temporal position (0 = prev, 1 = curr)
+     * @return True if a frame was written
+     *
+     * With tiled or planar sources on, the current frame is always
+     * converted. When framePrev is the previous call's frameCurrent its
+     * copy from that call is carried over, so the previous frame must not
+     * be rewritten in between; call InvalidateSources if it was.
+     */
+    bool Interpolate(
+        const ConstImageView& framePrev,
+        const ConstImageView& frameCurrent,
+        const MotionField& motion,
+        const ImageView& output,
+        float interpolationFactor
+    );
+
+    /**
+     * Enable occlusion-aware blend weights (default on)
+     */
+    void SetOcclusionAware(bool enabled) {
+        m_OcclusionAware = enabled;
+        if (m_HalfEngine) m_HalfEngine->SetOcclusionAware(enabled);
+    }
+    bool IsOcclusionAware() const { return m_OcclusionAware; }
+
+    /**
+     * Enable push-pull filling of pixels neither source can supply (default on)
+     */
+    void SetHoleFilling(bool enabled) {
+        m_HoleFilling = enabled;
+        if (m_HalfEngine) m_HalfEngine->SetHoleFilling(enabled);
+    }
+    bool IsHoleFilling() const { return m_HoleFilling; }
+
+    /**
+     * Copy zero-motion, zero-residual tiles instead of interpolating them (default on)
+     */
+    void SetStaticTileSkip(bool enabled) {
+        m_StaticTileSkip = enabled;
+        m_Tiles.SetStaticDetection(enabled);
+        if (m_HalfEngine) m_HalfEngine->SetStaticTileSkip(enabled);
+    }
+    bool IsStaticTileSkip() const { return m_StaticTileSkip; }
+
+    /**
+     * Pick a kernel per tile by motion (default on): sub-pixel tiles are
+     * cross-faded, coherent moderate motion gets a bilinear warp with a
+     * plain lerp, and only fast or discontinuous tiles take the configured
+     * occlusion-aware path. See TileClassifier for the thresholds.
+     */
+    void SetMotionTiers(bool enabled) {
+        m_MotionTiers = enabled;
+        m_Tiles.SetMotionClasses(enabled);
+        if (m_HalfEngine) m_HalfEngine->SetMotionTiers(enabled);
+    }
+    bool IsMotionTiers() const { return m_MotionTiers; }
+
+    /**
+     * Reuse last frame's warp output for tiles whose inputs, motion and
+     * settings hash the same as then (default on). The hit rate is in
+     * FrameStats; FSR3FrameGenerator::SetTileReuse is the GPU counterpart.
+     */
+    void SetTileReuse(bool enabled);
+    bool IsTileReuse() const { return m_TileReuse; }
+
+    /**
+     * Interpolate at half resolution and edge-guided upsample the result
+     * (Performance preset). Roughly quarters the warp/blend bandwidth.
+     */
+    bool SetHalfResolution(bool enabled);
+    bool IsHalfResolution() const { return m_HalfResolution; }
+
+    /**
+     * Blend the two warped samples in linear light instead of on the
+     * gamma-encoded values (default off). Only affects 8-bit sRGB formats.
+     */
+    void SetLinearBlending(bool enabled) {
+        m_LinearBlending = enabled;
+        if (m_HalfEngine) m_HalfEngine->SetLinearBlending(enabled);
+    }
+    bool IsLinearBlending() const { return m_LinearBlending; }
+
+    /**
+     * Reconstruction filter for the warp fetches (default bilinear). The 4x4
+     * filters keep fine detail such as text at fractional offsets, at about
+     * four times the fetch cost.
+     */
+    void SetWarpFilter(WarpFilter filter) {
+        m_WarpFilter = filter;
+        if (m_HalfEngine) m_HalfEngine->SetWarpFilter(filter);
+    }
+    WarpFilter GetWarpFilter() const { return m_WarpFilter; }
+
+    /**
+     * Warp along per-pixel flow from a joint bilateral upsample of the block
+     * field, guided by the previous frame's luma, instead of bilinearly
+     * filtered block vectors (default off). Keeps motion boundaries on
+     * object edges. Not used by the overlapped-block mode, which works on
+     * the block vectors directly.
+     */
+    void SetBilateralMotion(bool enabled);
+    bool IsBilateralMotion() const { return m_BilateralMotion; }
+
+    /**
+     * Overlapped block motion compensation (default off): blend the
+     * predictions of the four nearest block vectors with a raised-cosine
+     * window instead of warping along one bilinearly filtered vector.
+     * Keeps edges sharp at vector discontinuities at up to 4x the fetches
+     * there; uniform-motion regions cost the same as the bilinear path.
+     */
+    void SetOverlappedBlocks(bool enabled) {
+        m_OverlappedBlocks = enabled;
+        if (m_HalfEngine) m_HalfEngine->SetOverlappedBlocks(enabled);
+    }
+    bool IsOverlappedBlocks() const { return m_OverlappedBlocks; }
+
+    /**
+     * Foveated quality (default off): the configured warp runs inside a
+     * screen region, tiles outside it get a bilinear warp along the block
+     * vectors with a plain lerp, and the feather band blends the two per
+     * pixel. Shapes are in screen fractions; see RoiMap.
+     */
+    void SetRoiEllipse(float radiusX, float radiusY, float feather) {
+        m_Roi.SetEllipse(radiusX, radiusY, feather);
+        if (m_HalfEngine) m_HalfEngine->SetRoiEllipse(radiusX, radiusY, feather);
+    }
+    void SetRoiRectangles(const RoiMap::Rect* rects, uint32_t count, float feather) {
+        m_Roi.SetRectangles(rects, count, feather);
+        if (m_HalfEngine) m_HalfEngine->SetRoiRectangles(rects, count, feather);
+    }
+    void DisableRoi() {
+        m_Roi.Disable();
+        if (m_HalfEngine) m_HalfEngine->DisableRoi();
+    }
+    const RoiMap& GetRoiMap() const { return m_Roi; }
+
+    /**
+     * Copy stable screen-space overlays (HUD) from the current frame
+     * instead of interpolating them (default off)
+     */
+    void SetHudLessMode(bool enabled);
+    bool IsHudLessMode() const { return m_HudLessMode; }
+
+    /**
+     * Contrast-adaptive sharpening of the output (0 = off, the default)
+     */
+    void SetSharpness(float sharpness) { m_Sharpness = std::clamp(sharpness, 0.0f, 1.0f); }
+    float GetSharpness() const { return m_Sharpness; }
+
+    /**
+     * Sharpen inside the full-resolution warp/blend pass from a three-row
+     * ring instead of as a separate pass over the finished frame (default on).
+     * Pixels next to a hole are left unsharpened since the fill runs later.
+     */
+    void SetFusedKernel(bool enabled) { m_FusedKernel = enabled; }
+    bool IsFusedKernel() const { return m_FusedKernel; }
+
+    /**
+     * Back the engine's planes with huge pages (default off); takes
+     * effect at the next Initialize
+     */
+    void SetHugePages(bool enabled) { m_HugePages = enabled; }
+    bool IsHugePages() const { return m_Arena.IsHugePages(); }
+
+    /**
+     * Warp from 8x8-tiled copies of the source frames (default off)
+     *
+     * Each new frame is converted once; the previous current frame is
+     * normally the next previous one, so steady state costs one
+     * conversion per call. With vectors of a few pixels the linear rows
+     * are already cache-resident, and this measures 6-10% slower at 1080p
+     * (framegen_bench tiled_sources).
+     *
+     * @return False if the tiled copies could not be allocated
+     */
+    bool SetTiledSources(bool enabled);
+    bool IsTiledSources() const { return m_TiledSources; }
+
+    /**
+     * Warp from planar YCoCg-R copies of the source frames with 2x2
+     * subsampled chroma (default off): half the bytes per fetch, and the
+     * luma plane guides the bilateral motion upsampling. 8-bit formats
+     * only; takes precedence over tiled sources. Warped pixels are opaque.
+     * Only the warp fetches read the planes: cross-fades, static tiles,
+     * the tile cache and the HUD mask still read the RGBA frames.
+     *
+     * @return False if the planar copies could not be allocated
+     */
+    bool SetPlanarYCoCg(bool enabled);
+    bool IsPlanarYCoCg() const { return m_PlanarYCoCg; }
+
+    /**
+     * Forget which frames the tiled and planar copies hold
+     */
+    void InvalidateSources() {
+        m_TiledPair.Clear();
+        m_PlanarPair.Clear();
+        if (m_HalfEngine) m_HalfEngine->InvalidateSources();
+    }
+
+    OcclusionEstimator& GetOcclusionEstimator() { return m_Occlusion; }
+    const HudMaskTracker& GetHudMask() const { return m_HudMask; }
+
+    /**
+     * Counters for the most recent Interpolate call
+     */
+    const FrameStats& GetLastFrameStats() const { return m_LastStats; }
+
+    PixelFormat GetFormat() const { return m_Format; }
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+
+private:
+    using InterpolateFn = bool (CpuInterpolator::*)(
+        const ConstImageView&, const ConstImageView&, const MotionField&, const ImageView&, float);
+
+    /**
+     * Allocate the half-resolution engine and its buffers
+     */
+    bool InitializeHalfResolution();
+    void ShutdownHalfResolution();
+
+    /**
+     * Slots of a pair of converted source copies
+     *
+     * Addresses are not frame identities: callers ping-pong two buffers
+     * and rewrite them in place. Only the hand-over of the last current
+     * frame to this call's previous one is trusted.
+     */
+    struct ConvertedPair {
+        const void* lastCurrent = nullptr;
+        int prevSlot = 0;
+        int currSlot = 1;
+
+        /**
+         * Pick this call's slots; the current copy is always converted,
+         * convertPrev reports whether the previous one must be too
+         */
+        void Assign(const void* prev, const void* curr, bool& convertPrev);
+        void Clear() { lastCurrent = nullptr; }
+    };
+
+    /**
+     * Allocate the two tiled source copies
+     */
+    bool InitializeTiledSources();
+    void ShutdownTiledSources();
+
+    /**
+     * Allocate the two planar source copies
+     */
+    bool InitializePlanarSources();
+    void ShutdownPlanarSources();
+
+    /**
+     * Bring the tiled copies up to date with this call's frames, converting
+     * only the ones they do not already hold
+     */
+    template <PixelFormat F>
+    void PrepareTiledSources(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent);
+
+    template <PixelFormat F>
+    void PreparePlanarSources(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent);
+
+    YCoCgPlanes PlanarSource(int slot) const {
+        return { m_PlanarLuma[slot], m_PlanarCo[slot], m_PlanarCg[slot] };
+    }
+
+    template <PixelFormat F>
+    ConstTiledFormatPlane<F> TiledSource(int slot) const {
+        return ConstTiledFormatPlane<F>::Wrap(reinterpret_cast<const PixelStorage<F>*>(m_TiledFrames[slot]),
+                                              m_Width, m_Height);
+    }
+
+    /**
+     * Format-specialized frame: full or half resolution, then sharpening
+     */
+    template <PixelFormat F>
+    bool InterpolateFormat(
+        const ConstImageView& framePrev,
+        const ConstImageView& frameCurrent,
+        const MotionField& motion,
+        const ImageView& output,
+        float interpolationFactor
+    );
+
+    /**
+     * Full-resolution path: row-by-row warp/blend, then hole filling
+     *
+     * @param fusedSharpen Sharpen each row as soon as its neighbours exist
+     */
+    template <PixelFormat F>
+    bool InterpolateFullResolution(
+        const ConstFormatPlane<F>& framePrev,
+        const ConstFormatPlane<F>& frameCurrent,
+        const MotionField& motion,
+        const FormatPlane<F>& output,
+        float interpolationFactor,
+        bool fusedSharpen
+    );
+
+    /**
+     * Hash of every setting that changes the warp output, for the tile cache
+     */
+    uint64_t GetSettingsKey(float interpolationFactor) const;
+
+    /**
+     * Half-resolution path: downsample, interpolate, guided upsample
+     */
+    template <PixelFormat F>
+    bool InterpolateHalfResolution(
+        const ConstFormatPlane<F>& framePrev,
+        const ConstFormatPlane<F>& frameCurrent,
+        const MotionField& motion,
+        const FormatPlane<F>& output,
+        float interpolationFactor
+    );
+
+    /**
+     * Generate one output row: static and HUD tile spans are copied from
+     * the current frame, the rest is occlusion-weighted and warped
+     *
+     * @param out Destination row (the output frame or the fused ring)
+     * @return Number of new hole pixels
+     */
+    template <PixelFormat F>
+    uint32_t InterpolateRow(
+        const ConstFormatPlane<F>& framePrev,
+        const ConstFormatPlane<F>& frameCurrent,
+        const MotionField& motion,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y
+    );
+
+    /**
+     * Overwrite the HUD-masked pixels of a row span with the current frame
+     */
+    template <PixelFormat F>
+    void CopyHudPixels(const PixelStorage<F>* current, PixelStorage<F>* out,
+                       uint32_t y, uint32_t x0, uint32_t x1);
+
+    /**
+     * Undo fused sharpening where the cross touches a hole
+     */
+    template <PixelFormat F>
+    void RestoreNearHoles(const PixelStorage<F>* unsharpened, PixelStorage<F>* out, uint32_t y);
+
+    /**
+     * Warp and blend a row span with the configured filter and compensation
+     * mode, flagging pixels with no usable source
+     *
+     * @return Number of new hole pixels
+     */
+    template <PixelFormat F>
+    uint32_t WarpSpan(
+        const ConstFormatPlane<F>& framePrev,
+        const ConstFormatPlane<F>& frameCurrent,
+        const MotionField& motion,
+        const MotionVector* flow,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y, uint32_t x0, uint32_t x1
+    );
+
+    /**
+     * Cross-fade a row span of the two frames without warping (Blend tiles)
+     */
+    template <PixelFormat F>
+    void CrossFadeSpan(
+        const PixelStorage<F>* previous,
+        const PixelStorage<F>* current,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y, uint32_t x0, uint32_t x1
+    );
+
+    /**
+     * Cheap tier for a row span (Warp tiles and outside the ROI): bilinear fetches along the block
+     * vectors and a plain lerp, regardless of the quality settings
+     *
+     * @param out Destination row, indexed from x = 0 like the output
+     * @return Number of new hole pixels
+     */
+    template <PixelFormat F>
+    uint32_t WarpReducedSpan(
+        const ConstFormatPlane<F>& framePrev,
+        const ConstFormatPlane<F>& frameCurrent,
+        const MotionField& motion,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y, uint32_t x0, uint32_t x1
+    );
+
+    /**
+     * Warp and blend a row span along one vector per pixel
+     *
+     * @tparam LinearLight Blend via the sRGB linearization tables
+     * @tparam Filter Reconstruction filter for both fetches
+     * @tparam Source Linear, tiled or planar YCoCg source frames
+     * @param flow Per-pixel vectors for this row, or null to sample the block field
+     * @return Number of new hole pixels
+     */
+    template <PixelFormat F, bool LinearLight, WarpFilter Filter, typename Source>
+    uint32_t WarpBlendRow(
+        const Source& framePrev,
+        const Source& frameCurrent,
+        const MotionField& motion,
+        const MotionVector* flow,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y, uint32_t x0, uint32_t x1
+    );
+
+    /**
+     * OBMC variant of WarpBlendRow: one prediction per covering block,
+     * combined with the Obmc window weights
+     *
+     * @tparam LinearLight Blend via the sRGB linearization tables
+     * @tparam Filter Reconstruction filter for every fetch
+     * @tparam Source Linear, tiled or planar YCoCg source frames
+     * @return Number of new hole pixels
+     */
+    template <PixelFormat F, bool LinearLight, WarpFilter Filter, typename Source>
+    uint32_t ObmcBlendRow(
+        const Source& framePrev,
+        const Source& frameCurrent,
+        const MotionField& motion,
+        PixelStorage<F>* out,
+        float interpolationFactor,
+        uint32_t y, uint32_t x0, uint32_t x1
+    );
+
+    OcclusionEstimator m_Occlusion;
+    PushPullFiller m_HoleFiller;
+    TileClassifier m_Tiles;
+    ContrastAdaptiveSharpener m_Sharpener;
+    HudMaskTracker m_HudMask;
+    TileCache m_TileCache;
+    RoiMap m_Roi;
+    BilateralMotionUpsampler m_MotionUpsampler;
+    float m_Sharpness = 0.0f;
+    bool m_OcclusionAware = true;
+    bool m_HoleFilling = true;
+    bool m_StaticTileSkip = true;
+    bool m_MotionTiers = true;
+    bool m_TileReuse = true;
+    bool m_LinearBlending = false;
+    bool m_HudLessMode = false;
+    bool m_BilateralMotion = false;
+    bool m_OverlappedBlocks = false;
+    bool m_FusedKernel = true;
+    WarpFilter m_WarpFilter = WarpFilter::Bilinear;
+
+    // Kernel set for m_Format, chosen once by Initialize
+    InterpolateFn m_InterpolateFn = nullptr;
+
+    // Planes and scratch rows below live here
+    FrameArena m_Arena;
+    bool m_HugePages = false;
+
+    // Per-pixel blend weight toward the current frame (0-255)
+    Plane<uint8_t> m_BlendWeights;
+
+    // Per-pixel hole flags (non-zero = no usable source)
+    Plane<uint8_t> m_HoleMask;
+
+    // Three unsharpened rows for the fused kernel (m_Format texels, padded pitch)
+    uint8_t* m_FusedRows = nullptr;
+    size_t m_FusedPitchBytes = 0;
+
+    // Cheap-tier row for ROI transition tiles (m_Format texels)
+    uint8_t* m_RoiRow = nullptr;
+
+    // Tiled copies of the source frames (m_Format texels) and the linear
+    // frame each one was converted from
+    bool m_TiledSources = false;
+    FrameArena m_TiledArena;
+    uint8_t* m_TiledFrames[2] = {};
+    ConvertedPair m_TiledPair;
+
+    // Planar YCoCg-R copies of the source frames
+    bool m_PlanarYCoCg = false;
+    FrameArena m_PlanarArena;
+    Plane<uint8_t> m_PlanarLuma[2];
+    Plane<int16_t> m_PlanarCo[2];
+    Plane<int16_t> m_PlanarCg[2];
+    ConvertedPair m_PlanarPair;
+
+    FrameStats m_LastStats;
+
+    // Half-resolution path (pixel buffers hold m_Format texels)
+    bool m_HalfResolution = false;
+    std::unique_ptr<CpuInterpolator> m_HalfEngine;
+    EdgeGuidedUpsampler m_Upsampler;
+    FrameArena m_HalfArena;             // Half-size frames; scaled vectors per frame
+    ImageView m_HalfPrev;
+    ImageView m_HalfCurr;
+    ImageView m_HalfOutput;
+    uint32_t m_MotionBlockSize = 8;
+
+    bool m_Initialized = false;
+    PixelFormat m_Format = PixelFormat::RGBA8;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_CPU_INTERPOLATOR_H
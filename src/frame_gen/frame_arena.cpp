@@ -0,0 +1,160 @@
+/**
+ * Frame Arena Implementation
+ */
+
+#include "frame_arena.h"
+#include "../utils/logger.h"
+
+#include <new>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2u << 20;
+constexpr size_t SMALL_PAGE_SIZE = 4096;
+
+size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+FrameArena::FrameArena() = default;
+
+FrameArena::~FrameArena() {
+    Shutdown();
+}
+
+bool FrameArena::Initialize(size_t capacityBytes, bool hugePages) {
+    if (capacityBytes == 0) return false;
+
+    Shutdown();
+    capacityBytes = AllocationBytes(capacityBytes);
+
+#if defined(_WIN32)
+    // Large pages need SeLockMemoryPrivilege; without it the call fails and
+    // we take normal pages
+    if (hugePages) {
+        const size_t largePage = GetLargePageMinimum();
+        if (largePage > 0) {
+            const size_t size = RoundUp(capacityBytes, largePage);
+            void* block = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (block) {
+                m_Base = static_cast<uint8_t*>(block);
+                m_Reserved = size;
+                m_HugePages = true;
+            }
+        }
+    }
+    if (!m_Base) {
+        const size_t size = RoundUp(capacityBytes, SMALL_PAGE_SIZE);
+        void* block = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (block) {
+            m_Base = static_cast<uint8_t*>(block);
+            m_Reserved = size;
+        }
+    }
+    if (m_Base) m_Backing = Backing::Virtual;
+#elif defined(__linux__)
+    // Explicit huge pages come from the hugetlbfs pool, which is usually
+    // empty; transparent huge pages are the fallback
+    if (hugePages) {
+        const size_t size = RoundUp(capacityBytes, HUGE_PAGE_SIZE);
+        void* block = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (block != MAP_FAILED) {
+            m_Base = static_cast<uint8_t*>(block);
+            m_Reserved = size;
+            m_HugePages = true;
+        }
+    }
+    if (!m_Base) {
+        const size_t size = RoundUp(capacityBytes, hugePages ? HUGE_PAGE_SIZE : SMALL_PAGE_SIZE);
+        void* block = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block != MAP_FAILED) {
+            m_Base = static_cast<uint8_t*>(block);
+            m_Reserved = size;
+            if (hugePages) {
+                m_HugePages = madvise(block, size, MADV_HUGEPAGE) == 0;
+            }
+        }
+    }
+    if (m_Base) m_Backing = Backing::Virtual;
+#endif
+
+    if (!m_Base) {
+        m_Base = new (std::align_val_t(ALIGNMENT), std::nothrow) uint8_t[capacityBytes]();
+        if (!m_Base) {
+            Utils::Logger::Error("Failed to allocate %zu byte frame arena", capacityBytes);
+            return false;
+        }
+        m_Reserved = capacityBytes;
+        m_Backing = Backing::Heap;
+    }
+
+    m_Capacity = capacityBytes;
+    m_PersistentEnd = 0;
+    m_FrameBegin = m_Capacity;
+
+    if (hugePages && !m_HugePages) {
+        Utils::Logger::Warn("Huge pages unavailable for the frame arena, using normal pages");
+    }
+    return true;
+}
+
+void FrameArena::Shutdown() {
+    if (!m_Base) return;
+
+    switch (m_Backing) {
+#if defined(_WIN32)
+        case Backing::Virtual:
+            VirtualFree(m_Base, 0, MEM_RELEASE);
+            break;
+#elif defined(__linux__)
+        case Backing::Virtual:
+            munmap(m_Base, m_Reserved);
+            break;
+#endif
+        case Backing::Heap:
+            ::operator delete[](m_Base, std::align_val_t(ALIGNMENT));
+            break;
+        default:
+            break;
+    }
+
+    m_Base = nullptr;
+    m_Capacity = 0;
+    m_Reserved = 0;
+    m_PersistentEnd = 0;
+    m_FrameBegin = 0;
+    m_Backing = Backing::None;
+    m_HugePages = false;
+}
+
+void* FrameArena::AllocatePersistent(size_t bytes) {
+    const size_t size = AllocationBytes(bytes);
+    if (!m_Base || size > m_FrameBegin - m_PersistentEnd) return nullptr;
+
+    void* block = m_Base + m_PersistentEnd;
+    m_PersistentEnd += size;
+    return block;
+}
+
+void* FrameArena::AllocateFrame(size_t bytes) {
+    const size_t size = AllocationBytes(bytes);
+    if (!m_Base || size > m_FrameBegin - m_PersistentEnd) return nullptr;
+
+    m_FrameBegin -= size;
+    return m_Base + m_FrameBegin;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * Frame Arena
+ *
+ * One up-front block for the CPU engine's planes and scratch buffers: a
+ * persistent region that lives until Shutdown and a linear per-frame
+ * region that is dropped in O(1) by ResetFrame. Every allocation is
+ * cache-line aligned, and plane rows are padded so that vertically
+ * adjacent pixels do not map to the same cache set.
+ */
+
+#ifndef FIVEM_FRAMEGEN_FRAME_ARENA_H
+#define FIVEM_FRAMEGEN_FRAME_ARENA_H
+
+#include "image_types.h"
+#include <cstddef>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Bump allocator over a single reservation
+ *
+ * The persistent region grows up from the start of the block and the
+ * frame region grows down from its end; an allocation that would make
+ * them meet fails with nullptr.
+ */
+class FrameArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    FrameArena();
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Reserve and commit the block
+     *
+     * @param hugePages Back it with 2 MB pages when the OS allows it
+     *                  (large-page privilege on Windows, hugetlbfs or
+     *                  transparent huge pages on Linux); falls back silently
+     */
+    bool Initialize(size_t capacityBytes, bool hugePages = false);
+    void Shutdown();
+
+    /**
+     * Allocations that live until Shutdown
+     */
+    void* AllocatePersistent(size_t bytes);
+
+    /**
+     * Allocations that live until the next ResetFrame
+     */
+    void* AllocateFrame(size_t bytes);
+
+    template <typename T>
+    T* PersistentArray(size_t count) {
+        return static_cast<T*>(AllocatePersistent(count * sizeof(T)));
+    }
+
+    template <typename T>
+    T* FrameArray(size_t count) {
+        return static_cast<T*>(AllocateFrame(count * sizeof(T)));
+    }
+
+    /**
+     * Persistent zeroed plane with a padded pitch
+     */
+    template <typename T>
+    Plane<T> PersistentPlane(uint32_t width, uint32_t height) {
+        static_assert(ALIGNMENT % sizeof(T) == 0, "rows must stay element aligned");
+        const size_t pitchBytes = PaddedPitch(static_cast<size_t>(width) * sizeof(T));
+        T* data = static_cast<T*>(AllocatePersistent(pitchBytes * height));
+        if (!data) return {};
+        return { data, width, height, pitchBytes / sizeof(T) };
+    }
+
+    /**
+     * Release every frame allocation
+     */
+    void ResetFrame() { m_FrameBegin = m_Capacity; }
+
+    /**
+     * Row pitch for a row of rowBytes: whole cache lines, and an odd
+     * number of them, so successive rows start in different cache sets
+     */
+    static size_t PaddedPitch(size_t rowBytes) {
+        size_t lines = (rowBytes + ALIGNMENT - 1) / ALIGNMENT;
+        return (lines | 1) * ALIGNMENT;
+    }
+
+    /**
+     * Bytes a PersistentPlane takes, for sizing Initialize
+     */
+    static size_t PlaneBytes(uint32_t width, uint32_t height, size_t elementSize) {
+        return PaddedPitch(static_cast<size_t>(width) * elementSize) * height;
+    }
+
+    /**
+     * Bytes any other allocation takes, for sizing Initialize
+     */
+    static size_t AllocationBytes(size_t bytes) {
+        return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    bool IsInitialized() const { return m_Base != nullptr; }
+    bool IsHugePages() const { return m_HugePages; }
+    size_t GetCapacity() const { return m_Capacity; }
+    size_t GetPersistentBytes() const { return m_PersistentEnd; }
+    size_t GetFrameBytes() const { return m_Capacity - m_FrameBegin; }
+
+private:
+    enum class Backing : uint8_t {
+        None,
+        Virtual,        // VirtualAlloc / mmap
+        Heap            // Aligned operator new
+    };
+
+    uint8_t* m_Base = nullptr;
+    size_t m_Capacity = 0;
+    size_t m_Reserved = 0;          // Rounded up to the page size
+    size_t m_PersistentEnd = 0;
+    size_t m_FrameBegin = 0;
+    Backing m_Backing = Backing::None;
+    bool m_HugePages = false;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_FRAME_ARENA_H
@@ -2,4 +2,4 @@
  * Frame Buffer - Placeholder
  */
 
-// Frame buffer is implemented in frame_generator.cpp
+// Frame history is a template in frame_history.h; GPU slots are implemented in frame_generator.cpp
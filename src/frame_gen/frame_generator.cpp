@@ -4,6 +4,7 @@
 
 #include "frame_generator.h"
 #include "fsr3_backend.h"
+#include "hud_mask.h"
 #include "../utils/logger.h"
 
 #include <wrl/client.h>
@@ -15,108 +16,297 @@ namespace FiveMFrameGen {
 namespace FrameGen {
 
 // ============================================================================
-// FrameBuffer Implementation
+// Pixel Format Mapping
 // ============================================================================
 
-FrameBuffer::FrameBuffer() {
-    for (size_t i = 0; i < MAX_FRAMES; ++i) {
-        m_Frames[i] = nullptr;
-        m_FrameSRVs[i] = nullptr;
+bool ToPixelFormat(DXGI_FORMAT dxgiFormat, PixelFormat& format) {
+    switch (dxgiFormat) {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            format = PixelFormat::RGBA8;
+            return true;
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            format = PixelFormat::BGRA8;
+            return true;
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+            format = PixelFormat::RGB10A2;
+            return true;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            format = PixelFormat::RGBA16F;
+            return true;
+        default:
+            return false;
     }
 }
 
-FrameBuffer::~FrameBuffer() {
-    Shutdown();
+uint64_t GetTextureBytes(UINT width, UINT height, DXGI_FORMAT format) {
+    UINT bytesPerPixel = 4;
+    switch (format) {
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        case DXGI_FORMAT_R32G32B32A32_UINT:
+            bytesPerPixel = 16;
+            break;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R32G32_FLOAT:
+            bytesPerPixel = 8;
+            break;
+        case DXGI_FORMAT_R16G16_FLOAT:
+        case DXGI_FORMAT_R32_FLOAT:
+        case DXGI_FORMAT_R32_UINT:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+            bytesPerPixel = 4;
+            break;
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_R8G8_UNORM:
+            bytesPerPixel = 2;
+            break;
+        case DXGI_FORMAT_R8_UNORM:
+            bytesPerPixel = 1;
+            break;
+        default:
+            break;
+    }
+    return static_cast<uint64_t>(width) * height * bytesPerPixel;
 }
 
-bool FrameBuffer::Initialize(ID3D11Device* device, UINT width, UINT height, DXGI_FORMAT format) {
-    if (!device) return false;
-    
-    m_Device = device;
-    m_Width = width;
-    m_Height = height;
-    m_Format = format;
+// ============================================================================
+// TexturePool Implementation
+// ============================================================================
+
+void* D3D11TextureAllocator::Create(const ResourceDesc& desc) {
+    if (!m_Device) return nullptr;
     
-    // Create frame textures
     D3D11_TEXTURE2D_DESC texDesc = {};
-    texDesc.Width = width;
-    texDesc.Height = height;
+    texDesc.Width = desc.width;
+    texDesc.Height = desc.height;
     texDesc.MipLevels = 1;
     texDesc.ArraySize = 1;
-    texDesc.Format = format;
+    texDesc.Format = static_cast<DXGI_FORMAT>(desc.format);
     texDesc.SampleDesc.Count = 1;
-    texDesc.SampleDesc.Quality = 0;
     texDesc.Usage = D3D11_USAGE_DEFAULT;
-    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-    texDesc.CPUAccessFlags = 0;
-    texDesc.MiscFlags = 0;
-    
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = 1;
-    srvDesc.Texture2D.MostDetailedMip = 0;
-    
-    for (size_t i = 0; i < MAX_FRAMES; ++i) {
-        HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &m_Frames[i]);
-        if (FAILED(hr)) {
-            Utils::Logger::Error("Failed to create frame buffer %zu: 0x%08X", i, hr);
-            Shutdown();
-            return false;
-        }
-        
-        hr = device->CreateShaderResourceView(m_Frames[i], &srvDesc, &m_FrameSRVs[i]);
-        if (FAILED(hr)) {
-            Utils::Logger::Error("Failed to create frame SRV %zu: 0x%08X", i, hr);
-            Shutdown();
-            return false;
-        }
+    texDesc.BindFlags = desc.bindFlags;
+    
+    auto* texture = new PooledTexture();
+    HRESULT hr = m_Device->CreateTexture2D(&texDesc, nullptr, &texture->texture);
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_SHADER_RESOURCE)) {
+        hr = m_Device->CreateShaderResourceView(texture->texture, nullptr, &texture->srv);
+    }
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_RENDER_TARGET)) {
+        hr = m_Device->CreateRenderTargetView(texture->texture, nullptr, &texture->rtv);
+    }
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_UNORDERED_ACCESS)) {
+        hr = m_Device->CreateUnorderedAccessView(texture->texture, nullptr, &texture->uav);
     }
     
-    Utils::Logger::Info("Frame buffer initialized (%dx%d, %d frames)", width, height, MAX_FRAMES);
-    return true;
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create pooled texture %ux%u: 0x%08X", desc.width, desc.height, hr);
+        Destroy(texture);
+        return nullptr;
+    }
+    
+    if (m_Budget) {
+        m_Budget->Register(texture, MemoryCategory::Textures,
+            GetTextureBytes(desc.width, desc.height, texDesc.Format));
+    }
+    return texture;
 }
 
-void FrameBuffer::Shutdown() {
-    for (size_t i = 0; i < MAX_FRAMES; ++i) {
-        if (m_FrameSRVs[i]) {
-            m_FrameSRVs[i]->Release();
-            m_FrameSRVs[i] = nullptr;
-        }
-        if (m_Frames[i]) {
-            m_Frames[i]->Release();
-            m_Frames[i] = nullptr;
-        }
+void D3D11TextureAllocator::Destroy(void* resource) {
+    auto* texture = static_cast<PooledTexture*>(resource);
+    if (!texture) return;
+    
+    if (m_Budget) {
+        m_Budget->Unregister(texture);
+    }
+    if (texture->uav) texture->uav->Release();
+    if (texture->rtv) texture->rtv->Release();
+    if (texture->srv) texture->srv->Release();
+    if (texture->texture) texture->texture->Release();
+    delete texture;
+}
+
+void* D3D11StagingDevice::CreateReadback(const StagingDesc& desc) {
+    return CreateStaging(desc, D3D11_CPU_ACCESS_READ);
+}
+
+void* D3D11StagingDevice::CreateUpload(const StagingDesc& desc) {
+    return CreateStaging(desc, D3D11_CPU_ACCESS_WRITE);
+}
+
+ID3D11Texture2D* D3D11StagingDevice::CreateStaging(const StagingDesc& desc, UINT cpuAccess) {
+    if (!m_Device) return nullptr;
+    
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = desc.width;
+    texDesc.Height = desc.height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = static_cast<DXGI_FORMAT>(desc.format);
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_STAGING;
+    texDesc.CPUAccessFlags = cpuAccess;
+    
+    ID3D11Texture2D* texture = nullptr;
+    HRESULT hr = m_Device->CreateTexture2D(&texDesc, nullptr, &texture);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create %s texture %ux%u: 0x%08X",
+            cpuAccess == D3D11_CPU_ACCESS_READ ? "readback" : "upload", desc.width, desc.height, hr);
+        return nullptr;
+    }
+    
+    if (m_Budget) {
+        m_Budget->Register(texture, MemoryCategory::Textures,
+            GetTextureBytes(desc.width, desc.height, texDesc.Format));
+    }
+    return texture;
+}
+
+void D3D11StagingDevice::Destroy(void* staging) {
+    auto* texture = static_cast<ID3D11Texture2D*>(staging);
+    if (!texture) return;
+    
+    if (m_Budget) {
+        m_Budget->Unregister(texture);
     }
+    texture->Release();
+}
+
+bool D3D11StagingDevice::CopyToReadback(void* staging, void* source) {
+    if (!m_Context || !staging || !source) return false;
+    
+    m_Context->CopyResource(static_cast<ID3D11Texture2D*>(staging), static_cast<ID3D11Resource*>(source));
+    return true;
+}
+
+bool D3D11StagingDevice::CopyFromUpload(void* target, void* staging) {
+    if (!m_Context || !target || !staging) return false;
     
-    m_CurrentIndex = 0;
-    m_FrameCount = 0;
+    m_Context->CopyResource(static_cast<ID3D11Resource*>(target), static_cast<ID3D11Texture2D*>(staging));
+    return true;
 }
 
-void FrameBuffer::PushFrame(ID3D11DeviceContext* context, ID3D11Texture2D* frame) {
-    if (!context || !frame) return;
+bool D3D11StagingDevice::CopyFrame(void* target, void* source) {
+    if (!m_Context || !target || !source) return false;
     
-    // Copy to next slot
-    m_CurrentIndex = (m_CurrentIndex + 1) % MAX_FRAMES;
-    context->CopyResource(m_Frames[m_CurrentIndex], frame);
+    m_Context->CopyResource(static_cast<ID3D11Resource*>(target), static_cast<ID3D11Resource*>(source));
+    return true;
+}
+
+MapStatus D3D11StagingDevice::Map(ID3D11Texture2D* texture, D3D11_MAP mapType, bool wait,
+                                  D3D11_MAPPED_SUBRESOURCE& mapped) {
+    if (!m_Context || !texture) return MapStatus::Failed;
     
-    if (m_FrameCount < MAX_FRAMES) {
-        m_FrameCount++;
+    HRESULT hr = m_Context->Map(texture, 0, mapType, wait ? 0 : D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+    if (hr == DXGI_ERROR_WAS_STILL_DRAWING) {
+        return MapStatus::Pending;
+    }
+    return SUCCEEDED(hr) ? MapStatus::Ready : MapStatus::Failed;
+}
+
+MapStatus D3D11StagingDevice::MapRead(void* staging, bool wait, ConstImageView& view) {
+    auto* texture = static_cast<ID3D11Texture2D*>(staging);
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    const MapStatus status = Map(texture, D3D11_MAP_READ, wait, mapped);
+    if (status == MapStatus::Ready) {
+        D3D11_TEXTURE2D_DESC texDesc;
+        texture->GetDesc(&texDesc);
+        view = ConstImageView(mapped.pData, texDesc.Width, texDesc.Height, mapped.RowPitch);
+    }
+    return status;
+}
+
+MapStatus D3D11StagingDevice::MapWrite(void* staging, bool wait, ImageView& view) {
+    // Staging textures cannot be mapped WRITE_DISCARD or NO_OVERWRITE; a
+    // plain WRITE that fails while a copy still reads it is the equivalent
+    auto* texture = static_cast<ID3D11Texture2D*>(staging);
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    const MapStatus status = Map(texture, D3D11_MAP_WRITE, wait, mapped);
+    if (status == MapStatus::Ready) {
+        D3D11_TEXTURE2D_DESC texDesc;
+        texture->GetDesc(&texDesc);
+        view = ImageView(mapped.pData, texDesc.Width, texDesc.Height, mapped.RowPitch);
+    }
+    return status;
+}
+
+void D3D11StagingDevice::Unmap(void* staging) {
+    if (m_Context && staging) {
+        m_Context->Unmap(static_cast<ID3D11Texture2D*>(staging), 0);
     }
 }
 
-ID3D11Texture2D* FrameBuffer::GetFrame(size_t index) const {
-    if (index >= m_FrameCount) return nullptr;
+TexturePool::TexturePool() = default;
+
+TexturePool::~TexturePool() {
+    Shutdown();
+}
+
+bool TexturePool::Initialize(ID3D11Device* device, MemoryBudget* budget) {
+    if (!device) return false;
+    
+    // Resources of another device cannot be handed out
+    Shutdown();
+    
+    m_Device = device;
+    m_Budget = budget ? budget : &m_OwnedBudget;
+    m_Allocator.SetDevice(device);
+    m_Allocator.SetBudget(m_Budget);
+    return m_Pool.Initialize(&m_Allocator);
+}
+
+void TexturePool::Shutdown() {
+    m_Pool.Shutdown();
+    m_Allocator.SetDevice(nullptr);
+    m_Allocator.SetBudget(nullptr);
+    m_Device = nullptr;
+    m_Budget = nullptr;
+}
+
+void TexturePool::EndFrame() {
+    m_Pool.EndFrame();
     
-    size_t actualIndex = (m_CurrentIndex + MAX_FRAMES - index) % MAX_FRAMES;
-    return m_Frames[actualIndex];
+    // Idle textures are the cheapest memory to give back
+    if (m_Budget && m_Budget->IsDegraded(MemoryDegradation::TrimIdle)) {
+        m_Pool.Trim();
+    }
 }
 
-ID3D11ShaderResourceView* FrameBuffer::GetFrameSRV(size_t index) const {
-    if (index >= m_FrameCount) return nullptr;
+PooledTexture* TexturePool::Acquire(UINT width, UINT height, DXGI_FORMAT format, UINT bindFlags) {
+    ResourceDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = static_cast<uint32_t>(format);
+    desc.bindFlags = bindFlags;
+    return static_cast<PooledTexture*>(m_Pool.Acquire(desc));
+}
+
+void TexturePool::Release(PooledTexture* texture) {
+    m_Pool.Release(texture);
+}
+
+// ============================================================================
+// GpuFrame Implementation
+// ============================================================================
+
+bool GpuFrame::Create(TexturePool* texturePool, UINT width, UINT height, DXGI_FORMAT format) {
+    if (!texturePool) return false;
     
-    size_t actualIndex = (m_CurrentIndex + MAX_FRAMES - index) % MAX_FRAMES;
-    return m_FrameSRVs[actualIndex];
+    pool = texturePool;
+    texture = pool->Acquire(width, height, format, D3D11_BIND_SHADER_RESOURCE);
+    return texture != nullptr;
+}
+
+void GpuFrame::Release() {
+    if (texture) {
+        pool->Release(texture);
+        texture = nullptr;
+    }
 }
 
 // ============================================================================
@@ -228,6 +418,7 @@ bool MotionVectorCalculator::Initialize(ID3D11Device* device, UINT width, UINT h
         Utils::Logger::Error("Failed to create motion vector texture: 0x%08X", hr);
         return false;
     }
+    m_MemoryBytes += GetTextureBytes(texDesc.Width, texDesc.Height, texDesc.Format);
     
     // Create SRV
     hr = device->CreateShaderResourceView(m_MotionVectors, nullptr, &m_MotionVectorsSRV);
@@ -270,6 +461,7 @@ void MotionVectorCalculator::Shutdown() {
         m_OpticalFlowCS->Release();
         m_OpticalFlowCS = nullptr;
     }
+    m_MemoryBytes = 0;
 }
 
 bool MotionVectorCalculator::CreateShader() {
@@ -328,8 +520,10 @@ bool MotionVectorCalculator::CreateShader() {
         nullptr,
         &m_OpticalFlowCS
     );
+    if (FAILED(hr)) return false;
     
-    return SUCCEEDED(hr);
+    m_MemoryBytes += shaderBlob->GetBufferSize();
+    return true;
 }
 
 ID3D11Texture2D* MotionVectorCalculator::Calculate(
@@ -368,6 +562,980 @@ ID3D11Texture2D* MotionVectorCalculator::Calculate(
     return m_MotionVectors;
 }
 
+// ============================================================================
+// HudMaskCalculator Implementation
+// ============================================================================
+
+// HUD stability compute shader (HLSL), keep in sync with hud_mask.cpp
+static const char* g_HudStabilityShader = R"(
+Texture2D<float4> prevFrame : register(t0);
+Texture2D<float4> currFrame : register(t1);
+RWTexture2D<uint> stability : register(u0);
+
+cbuffer Constants : register(b0) {
+    uint2 resolution;
+    uint bandOffset;
+    uint bandRows;
+};
+
+// Luma difference still considered unchanged (2 of 255)
+static const float LUMA_TOLERANCE = 2.0 / 255.0;
+
+float Luminance(float4 color) {
+    return dot(color.rgb, float3(0.299, 0.587, 0.114));
+}
+
+// One thread group per 16x16 tile of the band
+[numthreads(16, 16, 1)]
+void main(uint3 DTid : SV_DispatchThreadID) {
+    uint2 pos = uint2(DTid.x, DTid.y + bandOffset);
+    
+    if (DTid.y >= bandRows || pos.x >= resolution.x || pos.y >= resolution.y) {
+        return;
+    }
+    
+    float diff = abs(Luminance(prevFrame[pos]) - Luminance(currFrame[pos]));
+    uint count = stability[pos];
+    stability[pos] = diff <= LUMA_TOLERANCE ? min(count + 1, 255u) : 0u;
+}
+)";
+
+HudMaskCalculator::HudMaskCalculator() = default;
+
+HudMaskCalculator::~HudMaskCalculator() {
+    Shutdown();
+}
+
+bool HudMaskCalculator::Initialize(ID3D11Device* device, UINT width, UINT height) {
+    if (!device) return false;
+    
+    m_Device = device;
+    m_Width = width;
+    m_Height = height;
+    m_NextTileRow = 0;
+    
+    // R32_UINT: the only integer format with guaranteed typed UAV loads
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = width;
+    texDesc.Height = height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = DXGI_FORMAT_R32_UINT;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+    
+    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &m_Stability);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create HUD stability texture: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += GetTextureBytes(width, height, texDesc.Format);
+    
+    hr = device->CreateShaderResourceView(m_Stability, nullptr, &m_StabilitySRV);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create HUD stability SRV: 0x%08X", hr);
+        return false;
+    }
+    
+    hr = device->CreateUnorderedAccessView(m_Stability, nullptr, &m_StabilityUAV);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create HUD stability UAV: 0x%08X", hr);
+        return false;
+    }
+    
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = 16;
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    
+    hr = device->CreateBuffer(&cbDesc, nullptr, &m_ConstantBuffer);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create HUD constant buffer: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += cbDesc.ByteWidth;
+    
+    if (!CreateShader()) {
+        Utils::Logger::Error("Failed to create HUD stability shader");
+        return false;
+    }
+    
+    Utils::Logger::Info("HUD mask calculator initialized");
+    return true;
+}
+
+void HudMaskCalculator::Shutdown() {
+    if (m_StabilityUAV) {
+        m_StabilityUAV->Release();
+        m_StabilityUAV = nullptr;
+    }
+    if (m_StabilitySRV) {
+        m_StabilitySRV->Release();
+        m_StabilitySRV = nullptr;
+    }
+    if (m_Stability) {
+        m_Stability->Release();
+        m_Stability = nullptr;
+    }
+    if (m_ConstantBuffer) {
+        m_ConstantBuffer->Release();
+        m_ConstantBuffer = nullptr;
+    }
+    if (m_StabilityCS) {
+        m_StabilityCS->Release();
+        m_StabilityCS = nullptr;
+    }
+    m_MemoryBytes = 0;
+}
+
+bool HudMaskCalculator::CreateShader() {
+    ComPtr<ID3DBlob> shaderBlob;
+    ComPtr<ID3DBlob> errorBlob;
+    
+    typedef HRESULT(WINAPI* pD3DCompile)(
+        LPCVOID, SIZE_T, LPCSTR, const D3D_SHADER_MACRO*, ID3DInclude*,
+        LPCSTR, LPCSTR, UINT, UINT, ID3DBlob**, ID3DBlob**
+    );
+    
+    HMODULE hD3DCompiler = LoadLibraryW(L"d3dcompiler_47.dll");
+    if (!hD3DCompiler) {
+        Utils::Logger::Error("Failed to load d3dcompiler_47.dll");
+        return false;
+    }
+    
+    pD3DCompile D3DCompileFunc = (pD3DCompile)GetProcAddress(hD3DCompiler, "D3DCompile");
+    if (!D3DCompileFunc) {
+        FreeLibrary(hD3DCompiler);
+        Utils::Logger::Error("Failed to get D3DCompile function");
+        return false;
+    }
+    
+    HRESULT hr = D3DCompileFunc(
+        g_HudStabilityShader,
+        strlen(g_HudStabilityShader),
+        "HudStability.hlsl",
+        nullptr,
+        nullptr,
+        "main",
+        "cs_5_0",
+        0,
+        0,
+        &shaderBlob,
+        &errorBlob
+    );
+    
+    FreeLibrary(hD3DCompiler);
+    
+    if (FAILED(hr)) {
+        if (errorBlob) {
+            Utils::Logger::Error("Shader compile error: %s", 
+                (const char*)errorBlob->GetBufferPointer());
+        }
+        return false;
+    }
+    
+    hr = m_Device->CreateComputeShader(
+        shaderBlob->GetBufferPointer(),
+        shaderBlob->GetBufferSize(),
+        nullptr,
+        &m_StabilityCS
+    );
+    if (FAILED(hr)) return false;
+    
+    m_MemoryBytes += shaderBlob->GetBufferSize();
+    return true;
+}
+
+void HudMaskCalculator::Update(
+    ID3D11DeviceContext* context,
+    ID3D11ShaderResourceView* framePrev,
+    ID3D11ShaderResourceView* frameCurrent
+) {
+    if (!context || !framePrev || !frameCurrent || !m_StabilityCS) {
+        return;
+    }
+    
+    constexpr UINT tileSize = HudMaskTracker::TILE_SIZE;
+    const UINT tilesY = (m_Height + tileSize - 1) / tileSize;
+    const UINT bandTileRows = (tilesY + HudMaskTracker::SWEEP_FRAMES - 1) / HudMaskTracker::SWEEP_FRAMES;
+    const UINT bandBegin = m_NextTileRow;
+    const UINT bandEnd = (std::min)(bandBegin + bandTileRows, tilesY);
+    m_NextTileRow = bandEnd < tilesY ? bandEnd : 0;
+    
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(m_ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr)) return;
+    
+    UINT* constants = static_cast<UINT*>(mapped.pData);
+    constants[0] = m_Width;
+    constants[1] = m_Height;
+    constants[2] = bandBegin * tileSize;
+    constants[3] = (bandEnd - bandBegin) * tileSize;
+    context->Unmap(m_ConstantBuffer, 0);
+    
+    context->CSSetShader(m_StabilityCS, nullptr, 0);
+    
+    ID3D11ShaderResourceView* srvs[] = { framePrev, frameCurrent };
+    context->CSSetShaderResources(0, 2, srvs);
+    context->CSSetUnorderedAccessViews(0, 1, &m_StabilityUAV, nullptr);
+    context->CSSetConstantBuffers(0, 1, &m_ConstantBuffer);
+    
+    // Only this band's tiles are touched
+    context->Dispatch((m_Width + tileSize - 1) / tileSize, bandEnd - bandBegin, 1);
+    
+    ID3D11ShaderResourceView* nullSRVs[2] = { nullptr, nullptr };
+    context->CSSetShaderResources(0, 2, nullSRVs);
+    
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+}
+
+void HudMaskCalculator::Reset(ID3D11DeviceContext* context) {
+    m_NextTileRow = 0;
+    if (context && m_StabilityUAV) {
+        const UINT zero[4] = { 0, 0, 0, 0 };
+        context->ClearUnorderedAccessViewUint(m_StabilityUAV, zero);
+    }
+}
+
+// ============================================================================
+// TileClassCalculator Implementation
+// ============================================================================
+
+// Tile classification compute shader (HLSL), keep in sync with tile_classifier.cpp
+// and, for the reuse keys, tile_cache.cpp. HashTiles is the reuse pre-pass.
+static const char* g_TileClassifyShader = R"(
+Texture2D<float2> motionVectors : register(t0);
+Texture2D<float4> framePrev : register(t1);
+Texture2D<float4> frameCurr : register(t2);
+Texture2D<uint> hudStability : register(t3);
+RWStructuredBuffer<uint> tileLists : register(u0);
+RWByteAddressBuffer drawArgs : register(u1);
+RWStructuredBuffer<uint4> tileHashes : register(u2);    // Content hash, asuint(largest motion)
+RWStructuredBuffer<uint4> tileKeys : register(u3);      // Key the target's tile was drawn with, valid
+
+cbuffer Constants : register(b0) {
+    uint2 tileCount;
+    uint2 outputSize;
+    uint listCapacity;
+    float blendMotion;      // Pixels; at or below this the tile is cross-faded
+    float fastMotion;       // Pixels; at or above this the tile gets the full warp
+    float discontinuity;    // Pixels of vector spread that also need the full warp
+    float staticMotion;     // Pixels; below this a tile with unchanged pixels is copied
+    uint staticDetection;
+    uint motionClasses;     // 0 = every moving tile gets the full warp
+    uint tileReuse;         // Leave tiles keyed as last time out of the lists
+    uint2 settingsKey;      // Hash of the settings that shape the output
+    uint targetValid;       // 0 = the target no longer holds the stored keys' pixels
+    uint padding;
+};
+
+static const uint TILE_SIZE = 16;
+
+// Classes and list order (keep in sync with TileClass in tile_classifier.h)
+static const uint CLASS_STATIC = 0;
+static const uint CLASS_BLEND = 1;
+static const uint CLASS_WARP = 2;
+static const uint CLASS_DYNAMIC = 3;
+
+// Reuse counters after the per-class draw arguments: reused, looked up
+static const uint REUSE_COUNTERS = 4 * 16;
+
+// HUD mask threshold (keep in sync with hud_mask.h)
+static const uint HUD_STABLE_UPDATES = 4;
+
+// Reach limits of a reuse key (keep in sync with tile_cache.h)
+static const uint MAX_REACH_TILES = 4;
+static const float FILTER_APRON = 3.0;
+
+// Two xxHash32-style lanes with their own primes, so a stale tile takes a
+// 64-bit collision like on the CPU
+static const uint2 HASH_PRIME1 = uint2(0x9E3779B1u, 0x85EBCA77u);
+static const uint2 HASH_PRIME2 = uint2(0xC2B2AE3Du, 0x27D4EB2Fu);
+
+uint2 Mix(uint2 h, uint v) {
+    h += v * HASH_PRIME2;
+    h = (h << 13) | (h >> 19);
+    return h * HASH_PRIME1;
+}
+
+uint2 MixTexel(uint2 h, float4 c) {
+    uint4 v = asuint(c);
+    return Mix(Mix(Mix(Mix(h, v.x), v.y), v.z), v.w);
+}
+
+uint2 Finalize(uint2 h) {
+    h ^= h >> 15;
+    h *= HASH_PRIME2;
+    h ^= h >> 13;
+    h *= HASH_PRIME1.yx;
+    return h ^ (h >> 16);
+}
+
+// Output pixels of a tile, in UV
+void TileBounds(uint2 tile, out float2 uv0, out float2 uv1) {
+    uv0 = float2(tile * TILE_SIZE) / float2(outputSize);
+    uv1 = float2(min((tile + 1) * TILE_SIZE, outputSize)) / float2(outputSize);
+}
+
+// True if every frame texel under the tile is bit-identical in both frames
+bool IsUnchanged(float2 uv0, float2 uv1) {
+    uint2 frameSize;
+    framePrev.GetDimensions(frameSize.x, frameSize.y);
+    
+    int2 p0 = int2(floor(uv0 * frameSize));
+    int2 p1 = min(int2(ceil(uv1 * frameSize)), int2(frameSize));
+    for (int y = p0.y; y < p1.y; ++y) {
+        for (int x = p0.x; x < p1.x; ++x) {
+            if (any(framePrev.Load(int3(x, y, 0)) != frameCurr.Load(int3(x, y, 0)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Reuse pre-pass, one thread per output tile: hash everything under the
+// tile that the kernels read (both frames, HUD mask, motion) and find its
+// largest vector
+[numthreads(8, 8, 1)]
+void HashTiles(uint3 DTid : SV_DispatchThreadID) {
+    if (DTid.x >= tileCount.x || DTid.y >= tileCount.y) {
+        return;
+    }
+    
+    float2 uv0, uv1;
+    TileBounds(DTid.xy, uv0, uv1);
+    
+    uint2 frameSize;
+    framePrev.GetDimensions(frameSize.x, frameSize.y);
+    int2 p0 = int2(floor(uv0 * frameSize));
+    int2 p1 = min(int2(ceil(uv1 * frameSize)), int2(frameSize));
+    
+    uint2 h = HASH_PRIME1;
+    for (int y = p0.y; y < p1.y; ++y) {
+        for (int x = p0.x; x < p1.x; ++x) {
+            h = MixTexel(h, framePrev.Load(int3(x, y, 0)));
+            h = MixTexel(h, frameCurr.Load(int3(x, y, 0)));
+            // Unbound outside HUD-less mode, which reads as 0
+            h = Mix(h, hudStability.Load(int3(x, y, 0)) >= HUD_STABLE_UPDATES ? 1 : 0);
+        }
+    }
+    
+    uint2 motionSize;
+    motionVectors.GetDimensions(motionSize.x, motionSize.y);
+    int2 m0 = int2(floor(uv0 * motionSize));
+    int2 m1 = min(int2(ceil(uv1 * motionSize)), int2(motionSize));
+    
+    float maxMotion = 0.0;
+    for (int my = m0.y; my < m1.y; ++my) {
+        for (int mx = m0.x; mx < m1.x; ++mx) {
+            float2 m = motionVectors[int2(mx, my)];
+            h = Mix(Mix(h, asuint(m.x)), asuint(m.y));
+            float2 v = m * float2(outputSize);
+            maxMotion = max(maxMotion, max(abs(v.x), abs(v.y)));
+        }
+    }
+    
+    tileHashes[DTid.y * tileCount.x + DTid.x] = uint4(Finalize(h), asuint(maxMotion), 0);
+}
+
+// Key a tile over every tile its output can read from (same reach as
+// TileCache::Prepare) and store it. True when the key matches the one the
+// target's pixels were drawn with, so the tile needs no draw.
+bool ReuseTile(uint2 tile) {
+    // Vectors at a pixel come from its own and the neighbouring tiles
+    float maxMotion = 0.0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int2 n = int2(tile) + int2(dx, dy);
+            if (all(n >= 0) && all(n < int2(tileCount))) {
+                maxMotion = max(maxMotion, asfloat(tileHashes[n.y * tileCount.x + n.x].z));
+            }
+        }
+    }
+    
+    // Both frames and their vectors up to that motion away, the bilinear
+    // and gradient motion taps, and the 4x4 filters
+    uint2 motionSize;
+    motionVectors.GetDimensions(motionSize.x, motionSize.y);
+    float blockSize = ceil(float(outputSize.x) / float(motionSize.x));
+    uint reach = max((uint)ceil((ceil(maxMotion) + 2.0 * blockSize + FILTER_APRON) / TILE_SIZE), 1);
+    
+    uint index = tile.y * tileCount.x + tile.x;
+    if (reach > MAX_REACH_TILES) {
+        // Drawn this time, so the stored key no longer describes the target
+        tileKeys[index] = uint4(0, 0, 0, 0);
+        return false;
+    }
+    
+    int2 n0 = max(int2(tile) - int(reach), 0);
+    int2 n1 = min(int2(tile) + int(reach), int2(tileCount) - 1);
+    uint2 key = Mix(settingsKey, reach);
+    for (int ny = n0.y; ny <= n1.y; ++ny) {
+        for (int nx = n0.x; nx <= n1.x; ++nx) {
+            uint2 h = tileHashes[ny * tileCount.x + nx].xy;
+            key = Mix(Mix(key, h.x), h.y);
+        }
+    }
+    key = Finalize(key);
+    
+    uint4 stored = tileKeys[index];
+    tileKeys[index] = uint4(key, 1, 0);
+    
+    uint unused;
+    drawArgs.InterlockedAdd(REUSE_COUNTERS + 8, 1, unused);
+    if (targetValid == 0 || stored.z == 0 || any(stored.xy != key)) {
+        return false;
+    }
+    drawArgs.InterlockedAdd(REUSE_COUNTERS + 4, 1, unused);
+    return true;
+}
+
+// One thread per output tile
+[numthreads(8, 8, 1)]
+void main(uint3 DTid : SV_DispatchThreadID) {
+    if (DTid.x >= tileCount.x || DTid.y >= tileCount.y) {
+        return;
+    }
+    
+    // Kept from the last generated frame: in no list, nothing drawn
+    if (tileReuse != 0 && ReuseTile(DTid.xy)) {
+        return;
+    }
+    
+    uint2 motionSize;
+    motionVectors.GetDimensions(motionSize.x, motionSize.y);
+    
+    // Motion texels under the tile, plus one for the bilinear and gradient taps
+    float2 uv0, uv1;
+    TileBounds(DTid.xy, uv0, uv1);
+    int2 m0 = max(int2(floor(uv0 * motionSize)) - 1, 0);
+    int2 m1 = min(int2(ceil(uv1 * motionSize)), int2(motionSize) - 1);
+    
+    float maxMag = 0.0;
+    float2 lo = float2(1e10, 1e10);
+    float2 hi = float2(-1e10, -1e10);
+    for (int y = m0.y; y <= m1.y; ++y) {
+        for (int x = m0.x; x <= m1.x; ++x) {
+            float2 v = motionVectors[int2(x, y)] * float2(outputSize);
+            maxMag = max(maxMag, max(abs(v.x), abs(v.y)));
+            lo = min(lo, v);
+            hi = max(hi, v);
+        }
+    }
+    float2 spread = hi - lo;
+    
+    uint cls;
+    if (staticDetection != 0 && maxMag < staticMotion && IsUnchanged(uv0, uv1)) {
+        cls = CLASS_STATIC;
+    } else if (motionClasses == 0) {
+        cls = CLASS_DYNAMIC;
+    } else {
+        cls = maxMag <= blendMotion ? CLASS_BLEND :
+            (maxMag >= fastMotion || max(spread.x, spread.y) >= discontinuity) ? CLASS_DYNAMIC : CLASS_WARP;
+    }
+    
+    // Instance count of the class's indirect draw doubles as its list length
+    uint slot;
+    drawArgs.InterlockedAdd(cls * 16 + 4, 1, slot);
+    tileLists[cls * listCapacity + slot] = DTid.x | (DTid.y << 16);
+}
+)";
+
+// Tile quad vertex shader: one instance per listed tile
+static const char* g_TileVS = R"(
+StructuredBuffer<uint> tileList : register(t0);
+
+cbuffer Constants : register(b0) {
+    uint listOffset;
+    uint tileSize;
+    uint2 outputSize;
+};
+
+struct VSOutput {
+    float4 position : SV_Position;
+    float2 texcoord : TEXCOORD0;
+};
+
+static const float2 CORNERS[6] = {
+    float2(0, 0), float2(1, 0), float2(0, 1),
+    float2(0, 1), float2(1, 0), float2(1, 1)
+};
+
+VSOutput main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID) {
+    uint packed = tileList[listOffset + instanceId];
+    uint2 tile = uint2(packed & 0xFFFF, packed >> 16);
+    
+    float2 pixel = min((float2(tile) + CORNERS[vertexId]) * tileSize, float2(outputSize));
+    
+    VSOutput output;
+    output.texcoord = pixel / float2(outputSize);
+    output.position = float4(output.texcoord * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    return output;
+}
+)";
+
+TileClassCalculator::TileClassCalculator() = default;
+
+TileClassCalculator::~TileClassCalculator() {
+    Shutdown();
+}
+
+bool TileClassCalculator::Initialize(ID3D11Device* device, UINT width, UINT height) {
+    if (!device) return false;
+    
+    m_Device = device;
+    m_Width = width;
+    m_Height = height;
+    m_ListCapacity = ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+    m_ReadbackPending = false;
+    
+    // Each list can hold every tile, since one class may take the whole frame
+    D3D11_BUFFER_DESC listDesc = {};
+    listDesc.ByteWidth = m_ListCapacity * CLASS_COUNT * sizeof(UINT);
+    listDesc.Usage = D3D11_USAGE_DEFAULT;
+    listDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+    listDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    listDesc.StructureByteStride = sizeof(UINT);
+    
+    HRESULT hr = device->CreateBuffer(&listDesc, nullptr, &m_TileLists);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile list buffer: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += listDesc.ByteWidth;
+    
+    hr = device->CreateShaderResourceView(m_TileLists, nullptr, &m_TileListsSRV);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile list SRV: 0x%08X", hr);
+        return false;
+    }
+    
+    hr = device->CreateUnorderedAccessView(m_TileLists, nullptr, &m_TileListsUAV);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile list UAV: 0x%08X", hr);
+        return false;
+    }
+    
+    // Reuse hashes and keys, one uint4 per tile
+    D3D11_BUFFER_DESC tileDesc = {};
+    tileDesc.ByteWidth = m_ListCapacity * 4 * sizeof(UINT);
+    tileDesc.Usage = D3D11_USAGE_DEFAULT;
+    tileDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    tileDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    tileDesc.StructureByteStride = 4 * sizeof(UINT);
+    
+    ID3D11Buffer** tileBuffers[] = { &m_TileHashes, &m_TileKeys };
+    ID3D11UnorderedAccessView** tileUAVs[] = { &m_TileHashesUAV, &m_TileKeysUAV };
+    for (size_t i = 0; i < 2; ++i) {
+        hr = device->CreateBuffer(&tileDesc, nullptr, tileBuffers[i]);
+        if (FAILED(hr)) {
+            Utils::Logger::Error("Failed to create tile reuse buffer: 0x%08X", hr);
+            return false;
+        }
+        m_MemoryBytes += tileDesc.ByteWidth;
+        
+        hr = device->CreateUnorderedAccessView(*tileBuffers[i], nullptr, tileUAVs[i]);
+        if (FAILED(hr)) {
+            Utils::Logger::Error("Failed to create tile reuse UAV: 0x%08X", hr);
+            return false;
+        }
+    }
+    
+    // Indirect arguments need a raw view for InterlockedAdd; the reuse
+    // counters take one more row
+    D3D11_BUFFER_DESC argsDesc = {};
+    argsDesc.ByteWidth = (CLASS_COUNT + 1) * 4 * sizeof(UINT);
+    argsDesc.Usage = D3D11_USAGE_DEFAULT;
+    argsDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    argsDesc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS | D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+    
+    hr = device->CreateBuffer(&argsDesc, nullptr, &m_DrawArgs);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile draw argument buffer: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += argsDesc.ByteWidth;
+    
+    D3D11_UNORDERED_ACCESS_VIEW_DESC argsUavDesc = {};
+    argsUavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    argsUavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    argsUavDesc.Buffer.NumElements = (CLASS_COUNT + 1) * 4;
+    argsUavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
+    
+    hr = device->CreateUnorderedAccessView(m_DrawArgs, &argsUavDesc, &m_DrawArgsUAV);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile draw argument UAV: 0x%08X", hr);
+        return false;
+    }
+    
+    D3D11_BUFFER_DESC readbackDesc = {};
+    readbackDesc.ByteWidth = argsDesc.ByteWidth;
+    readbackDesc.Usage = D3D11_USAGE_STAGING;
+    readbackDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    
+    hr = device->CreateBuffer(&readbackDesc, nullptr, &m_DrawArgsReadback);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile count readback buffer: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += readbackDesc.ByteWidth;
+    
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = 64;
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    
+    hr = device->CreateBuffer(&cbDesc, nullptr, &m_ConstantBuffer);
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create tile classifier constant buffer: 0x%08X", hr);
+        return false;
+    }
+    m_MemoryBytes += cbDesc.ByteWidth;
+    
+    // Per-class draw constants only change with the output size
+    cbDesc.ByteWidth = 16;
+    for (UINT i = 0; i < CLASS_COUNT; ++i) {
+        hr = device->CreateBuffer(&cbDesc, nullptr, &m_DrawConstants[i]);
+        if (FAILED(hr)) {
+            Utils::Logger::Error("Failed to create tile draw constant buffer: 0x%08X", hr);
+            return false;
+        }
+        m_MemoryBytes += cbDesc.ByteWidth;
+    }
+    
+    if (!CreateShaders()) {
+        Utils::Logger::Error("Failed to create tile classifier shaders");
+        return false;
+    }
+    
+    Utils::Logger::Info("Tile classifier initialized (%u tiles per list)", m_ListCapacity);
+    return true;
+}
+
+void TileClassCalculator::Shutdown() {
+    if (m_DrawArgsReadback) {
+        m_DrawArgsReadback->Release();
+        m_DrawArgsReadback = nullptr;
+    }
+    if (m_DrawArgsUAV) {
+        m_DrawArgsUAV->Release();
+        m_DrawArgsUAV = nullptr;
+    }
+    if (m_DrawArgs) {
+        m_DrawArgs->Release();
+        m_DrawArgs = nullptr;
+    }
+    if (m_TileKeysUAV) {
+        m_TileKeysUAV->Release();
+        m_TileKeysUAV = nullptr;
+    }
+    if (m_TileKeys) {
+        m_TileKeys->Release();
+        m_TileKeys = nullptr;
+    }
+    if (m_TileHashesUAV) {
+        m_TileHashesUAV->Release();
+        m_TileHashesUAV = nullptr;
+    }
+    if (m_TileHashes) {
+        m_TileHashes->Release();
+        m_TileHashes = nullptr;
+    }
+    if (m_TileListsUAV) {
+        m_TileListsUAV->Release();
+        m_TileListsUAV = nullptr;
+    }
+    if (m_TileListsSRV) {
+        m_TileListsSRV->Release();
+        m_TileListsSRV = nullptr;
+    }
+    if (m_TileLists) {
+        m_TileLists->Release();
+        m_TileLists = nullptr;
+    }
+    for (UINT i = 0; i < CLASS_COUNT; ++i) {
+        if (m_DrawConstants[i]) {
+            m_DrawConstants[i]->Release();
+            m_DrawConstants[i] = nullptr;
+        }
+    }
+    if (m_ConstantBuffer) {
+        m_ConstantBuffer->Release();
+        m_ConstantBuffer = nullptr;
+    }
+    if (m_TileVS) {
+        m_TileVS->Release();
+        m_TileVS = nullptr;
+    }
+    if (m_HashCS) {
+        m_HashCS->Release();
+        m_HashCS = nullptr;
+    }
+    if (m_ClassifyCS) {
+        m_ClassifyCS->Release();
+        m_ClassifyCS = nullptr;
+    }
+    m_ReadbackPending = false;
+    m_MemoryBytes = 0;
+}
+
+bool TileClassCalculator::CreateShaders() {
+    ComPtr<ID3DBlob> csBlob;
+    ComPtr<ID3DBlob> hashBlob;
+    ComPtr<ID3DBlob> vsBlob;
+    ComPtr<ID3DBlob> errorBlob;
+    
+    typedef HRESULT(WINAPI* pD3DCompile)(
+        LPCVOID, SIZE_T, LPCSTR, const D3D_SHADER_MACRO*, ID3DInclude*,
+        LPCSTR, LPCSTR, UINT, UINT, ID3DBlob**, ID3DBlob**
+    );
+    
+    HMODULE hD3DCompiler = LoadLibraryW(L"d3dcompiler_47.dll");
+    if (!hD3DCompiler) {
+        Utils::Logger::Error("Failed to load d3dcompiler_47.dll");
+        return false;
+    }
+    
+    pD3DCompile D3DCompileFunc = (pD3DCompile)GetProcAddress(hD3DCompiler, "D3DCompile");
+    if (!D3DCompileFunc) {
+        FreeLibrary(hD3DCompiler);
+        Utils::Logger::Error("Failed to get D3DCompile function");
+        return false;
+    }
+    
+    HRESULT hr = D3DCompileFunc(
+        g_TileClassifyShader,
+        strlen(g_TileClassifyShader),
+        "TileClassify.hlsl",
+        nullptr,
+        nullptr,
+        "main",
+        "cs_5_0",
+        0,
+        0,
+        &csBlob,
+        &errorBlob
+    );
+    
+    if (SUCCEEDED(hr)) {
+        hr = D3DCompileFunc(
+            g_TileClassifyShader,
+            strlen(g_TileClassifyShader),
+            "TileClassify.hlsl",
+            nullptr,
+            nullptr,
+            "HashTiles",
+            "cs_5_0",
+            0,
+            0,
+            &hashBlob,
+            &errorBlob
+        );
+    }
+    
+    if (SUCCEEDED(hr)) {
+        hr = D3DCompileFunc(
+            g_TileVS,
+            strlen(g_TileVS),
+            "TileVS.hlsl",
+            nullptr,
+            nullptr,
+            "main",
+            "vs_5_0",
+            0,
+            0,
+            &vsBlob,
+            &errorBlob
+        );
+    }
+    
+    FreeLibrary(hD3DCompiler);
+    
+    if (FAILED(hr)) {
+        if (errorBlob) {
+            Utils::Logger::Error("Shader compile error: %s", 
+                (const char*)errorBlob->GetBufferPointer());
+        }
+        return false;
+    }
+    
+    hr = m_Device->CreateComputeShader(
+        csBlob->GetBufferPointer(),
+        csBlob->GetBufferSize(),
+        nullptr,
+        &m_ClassifyCS
+    );
+    if (FAILED(hr)) return false;
+    
+    hr = m_Device->CreateComputeShader(
+        hashBlob->GetBufferPointer(),
+        hashBlob->GetBufferSize(),
+        nullptr,
+        &m_HashCS
+    );
+    if (FAILED(hr)) return false;
+    
+    hr = m_Device->CreateVertexShader(
+        vsBlob->GetBufferPointer(),
+        vsBlob->GetBufferSize(),
+        nullptr,
+        &m_TileVS
+    );
+    if (FAILED(hr)) return false;
+    
+    m_MemoryBytes += csBlob->GetBufferSize() + hashBlob->GetBufferSize() + vsBlob->GetBufferSize();
+    return true;
+}
+
+void TileClassCalculator::Classify(
+    ID3D11DeviceContext* context,
+    ID3D11ShaderResourceView* motionVectors,
+    ID3D11ShaderResourceView* framePrev,
+    ID3D11ShaderResourceView* frameCurrent,
+    UINT outputWidth,
+    UINT outputHeight,
+    bool staticDetection,
+    bool motionClasses,
+    const ReuseParams* reuse
+) {
+    if (!context || !motionVectors || !m_ClassifyCS) {
+        return;
+    }
+    staticDetection = staticDetection && framePrev && frameCurrent;
+    if (!framePrev || !frameCurrent || !m_HashCS) {
+        reuse = nullptr;
+    }
+    
+    outputWidth = (std::min)(outputWidth, m_Width);
+    outputHeight = (std::min)(outputHeight, m_Height);
+    const UINT tilesX = (outputWidth + TILE_SIZE - 1) / TILE_SIZE;
+    const UINT tilesY = (outputHeight + TILE_SIZE - 1) / TILE_SIZE;
+    
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(m_ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr)) return;
+    
+    UINT* constants = static_cast<UINT*>(mapped.pData);
+    float* thresholds = static_cast<float*>(mapped.pData);
+    constants[0] = tilesX;
+    constants[1] = tilesY;
+    constants[2] = outputWidth;
+    constants[3] = outputHeight;
+    constants[4] = m_ListCapacity;
+    thresholds[5] = TileClassifier::BLEND_MOTION_MAX;
+    thresholds[6] = TileClassifier::FAST_MOTION;
+    thresholds[7] = TileClassifier::DISCONTINUITY;
+    thresholds[8] = TileClassifier::STATIC_MOTION_EPSILON;
+    constants[9] = staticDetection ? 1 : 0;
+    constants[10] = motionClasses ? 1 : 0;
+    constants[11] = reuse ? 1 : 0;
+    constants[12] = reuse ? static_cast<UINT>(reuse->settingsKey) : 0;
+    constants[13] = reuse ? static_cast<UINT>(reuse->settingsKey >> 32) : 0;
+    constants[14] = (reuse && reuse->targetValid) ? 1 : 0;
+    constants[15] = 0;
+    context->Unmap(m_ConstantBuffer, 0);
+    
+    for (UINT i = 0; i < CLASS_COUNT; ++i) {
+        hr = context->Map(m_DrawConstants[i], 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(hr)) return;
+        
+        UINT* drawConstants = static_cast<UINT*>(mapped.pData);
+        drawConstants[0] = i * m_ListCapacity;
+        drawConstants[1] = TILE_SIZE;
+        drawConstants[2] = outputWidth;
+        drawConstants[3] = outputHeight;
+        context->Unmap(m_DrawConstants[i], 0);
+    }
+    
+    // Six vertices per tile quad; the shader counts the instances. The
+    // last row is the reuse counters.
+    const UINT resetArgs[(CLASS_COUNT + 1) * 4] = {
+        6, 0, 0, 0,
+        6, 0, 0, 0,
+        6, 0, 0, 0,
+        6, 0, 0, 0,
+        0, 0, 0, 0,
+    };
+    context->UpdateSubresource(m_DrawArgs, 0, nullptr, resetArgs, 0, 0);
+    
+    ID3D11ShaderResourceView* srvs[] = {
+        motionVectors, framePrev, frameCurrent, reuse ? reuse->hudStability : nullptr
+    };
+    context->CSSetShaderResources(0, 4, srvs);
+    
+    ID3D11UnorderedAccessView* uavs[] = { m_TileListsUAV, m_DrawArgsUAV, m_TileHashesUAV, m_TileKeysUAV };
+    context->CSSetUnorderedAccessViews(0, 4, uavs, nullptr);
+    context->CSSetConstantBuffers(0, 1, &m_ConstantBuffer);
+    
+    // Every tile's hash must be in before any key mixes its neighbours'
+    if (reuse) {
+        context->CSSetShader(m_HashCS, nullptr, 0);
+        context->Dispatch((tilesX + 7) / 8, (tilesY + 7) / 8, 1);
+    }
+    
+    context->CSSetShader(m_ClassifyCS, nullptr, 0);
+    context->Dispatch((tilesX + 7) / 8, (tilesY + 7) / 8, 1);
+    
+    ID3D11ShaderResourceView* nullSRVs[4] = { nullptr, nullptr, nullptr, nullptr };
+    context->CSSetShaderResources(0, 4, nullSRVs);
+    
+    ID3D11UnorderedAccessView* nullUAVs[4] = { nullptr, nullptr, nullptr, nullptr };
+    context->CSSetUnorderedAccessViews(0, 4, nullUAVs, nullptr);
+    
+    // Counts are picked up by a later ReadCounts, never waited on
+    if (!m_ReadbackPending) {
+        context->CopyResource(m_DrawArgsReadback, m_DrawArgs);
+        m_ReadbackPending = true;
+    }
+}
+
+void TileClassCalculator::DrawTiles(ID3D11DeviceContext* context, TileClass cls) {
+    if (!context || !m_TileVS) {
+        return;
+    }
+    
+    const UINT list = ListIndex(cls);
+    
+    context->VSSetShader(m_TileVS, nullptr, 0);
+    context->VSSetShaderResources(0, 1, &m_TileListsSRV);
+    context->VSSetConstantBuffers(0, 1, &m_DrawConstants[list]);
+    
+    context->DrawInstancedIndirect(m_DrawArgs, static_cast<UINT>(list * 4 * sizeof(UINT)));
+    
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    context->VSSetShaderResources(0, 1, &nullSRV);
+}
+
+bool TileClassCalculator::ReadCounts(ID3D11DeviceContext* context, TileKernelCounts& counts) {
+    if (!context || !m_ReadbackPending) {
+        return false;
+    }
+    
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(m_DrawArgsReadback, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+    if (FAILED(hr)) {
+        // DXGI_ERROR_WAS_STILL_DRAWING: try again next frame
+        return false;
+    }
+    
+    const UINT* args = static_cast<const UINT*>(mapped.pData);
+    counts.copied = args[ListIndex(TileClass::Static) * 4 + 1];
+    counts.blend = args[ListIndex(TileClass::Blend) * 4 + 1];
+    counts.warp = args[ListIndex(TileClass::Warp) * 4 + 1];
+    counts.full = args[ListIndex(TileClass::Dynamic) * 4 + 1];
+    counts.reused = args[CLASS_COUNT * 4 + 1];
+    counts.reuseLookups = args[CLASS_COUNT * 4 + 2];
+    context->Unmap(m_DrawArgsReadback, 0);
+    
+    m_ReadbackPending = false;
+    return true;
+}
+
 // ============================================================================
 // Factory Function
 // ============================================================================
@@ -16,10 +16,32 @@
 #include <cstdint>
 
 #include "../include/fivem_framegen.h"
+#include "frame_handle.h"
+#include "frame_history.h"
+#include "memory_budget.h"
+#include "pixel_format.h"
+#include "readback_ring.h"
+#include "resource_pool.h"
+#include "tile_classifier.h"
+#include "upload_ring.h"
 
 namespace FiveMFrameGen {
 namespace FrameGen {
 
+class TexturePool;
+
+/**
+ * Interpolation tiles per kernel for the most recent generated frame
+ */
+struct TileKernelCounts {
+    uint32_t copied = 0;        // Static: unchanged and still, copied instead of interpolated
+    uint32_t blend = 0;         // Cross-faded
+    uint32_t warp = 0;          // Bilinear warp, plain lerp
+    uint32_t full = 0;          // Full occlusion-aware warp
+    uint32_t reused = 0;        // Inputs hashed as last time: kept from that frame, nothing drawn
+    uint32_t reuseLookups = 0;  // Tiles local enough to key for reuse
+};
+
 /**
  * Abstract frame generator interface
  */
@@ -46,6 +68,12 @@ public:
      */
     virtual void Shutdown() = 0;
     
+    /**
+     * Allocate render textures from a shared pool; call before Initialize.
+     * Without one the generator keeps a private pool.
+     */
+    virtual void SetTexturePool(TexturePool* pool) = 0;
+    
     /**
      * Process the current frame and generate interpolated frame if needed
      */
@@ -61,6 +89,27 @@ public:
      */
     virtual void SetSharpness(float sharpness) = 0;
     
+    /**
+     * Blend frames in linear light instead of gamma space
+     */
+    virtual void SetLinearBlending(bool enabled) = 0;
+    
+    /**
+     * Copy stable HUD pixels from the current frame instead of interpolating them
+     */
+    virtual void SetHudLessMode(bool enabled) = 0;
+    
+    /**
+     * Limit full-quality interpolation to a screen region
+     */
+    virtual void SetRegionOfInterest(const RoiConfig& roi) = 0;
+    
+    /**
+     * Read captured frames back to the CPU through a ring of this many
+     * staging copies (0 = off); frames arrive depth - 1 frames late
+     */
+    virtual void SetReadbackDepth(uint32_t depth) = 0;
+    
     /**
      * Get the base (actual rendered) FPS
      */
@@ -81,6 +130,21 @@ public:
      */
     virtual uint64_t GetFramesGenerated() const = 0;
     
+    /**
+     * Get the per-kernel tile split of the interpolation pass
+     */
+    virtual TileKernelCounts GetTileKernelCounts() const = 0;
+    
+    /**
+     * Get the CPU readback counters (all zero while readback is off)
+     */
+    virtual ReadbackRing::Stats GetReadbackStats() const = 0;
+    
+    /**
+     * Get the full-frame copies made and avoided on the capture/present path
+     */
+    virtual FrameTransfer::Counters GetFrameTraffic() const = 0;
+    
     /**
      * Get the backend type
      */
@@ -98,56 +162,128 @@ public:
 };
 
 /**
- * Frame buffer for storing frame history
+ * Map a swap chain format to the CPU pixel format with the same memory layout
+ *
+ * @return False if the CPU kernels have no matching format
+ */
+bool ToPixelFormat(DXGI_FORMAT dxgiFormat, PixelFormat& format);
+
+/**
+ * Size of a single-mip 2D texture, for memory accounting
+ */
+uint64_t GetTextureBytes(UINT width, UINT height, DXGI_FORMAT format);
+
+/**
+ * 2D texture with a view for each of its bind flags
+ */
+struct PooledTexture {
+    ID3D11Texture2D* texture = nullptr;
+    ID3D11ShaderResourceView* srv = nullptr;
+    ID3D11RenderTargetView* rtv = nullptr;
+    ID3D11UnorderedAccessView* uav = nullptr;
+};
+
+/**
+ * ResourcePool allocator for PooledTexture; registers each texture with a
+ * memory budget while it exists
  */
-class FrameBuffer {
+class D3D11TextureAllocator : public IResourceAllocator {
 public:
-    static constexpr size_t MAX_FRAMES = 4;
+    void SetDevice(ID3D11Device* device) { m_Device = device; }
+    void SetBudget(MemoryBudget* budget) { m_Budget = budget; }
     
-    FrameBuffer();
-    ~FrameBuffer();
+    void* Create(const ResourceDesc& desc) override;
+    void Destroy(void* resource) override;
+
+private:
+    ID3D11Device* m_Device = nullptr;
+    MemoryBudget* m_Budget = nullptr;
+};
+
+/**
+ * Staging device over D3D11 staging textures; sources are ID3D11Resource
+ * pointers of the same size and format
+ */
+class D3D11StagingDevice : public IStagingDevice {
+public:
+    void SetDevice(ID3D11Device* device, ID3D11DeviceContext* context) {
+        m_Device = device;
+        m_Context = context;
+    }
+    void SetBudget(MemoryBudget* budget) { m_Budget = budget; }
     
-    bool Initialize(ID3D11Device* device, UINT width, UINT height, DXGI_FORMAT format);
-    void Shutdown();
+    void* CreateReadback(const StagingDesc& desc) override;
+    void Destroy(void* staging) override;
+    bool CopyToReadback(void* staging, void* source) override;
+    MapStatus MapRead(void* staging, bool wait, ConstImageView& view) override;
+    void* CreateUpload(const StagingDesc& desc) override;
+    MapStatus MapWrite(void* staging, bool wait, ImageView& view) override;
+    bool CopyFromUpload(void* target, void* staging) override;
+    void Unmap(void* staging) override;
+    bool CopyFrame(void* target, void* source) override;
+
+private:
+    ID3D11Texture2D* CreateStaging(const StagingDesc& desc, UINT cpuAccess);
     
     /**
-     * Push a new frame to the buffer
+     * Map without waiting unless asked; Pending while the GPU still uses it
      */
-    void PushFrame(ID3D11DeviceContext* context, ID3D11Texture2D* frame);
+    MapStatus Map(ID3D11Texture2D* texture, D3D11_MAP mapType, bool wait, D3D11_MAPPED_SUBRESOURCE& mapped);
     
-    /**
-     * Get frame by index (0 = current, 1 = previous, etc.)
-     */
-    ID3D11Texture2D* GetFrame(size_t index) const;
+    ID3D11Device* m_Device = nullptr;
+    ID3D11DeviceContext* m_Context = nullptr;
+    MemoryBudget* m_Budget = nullptr;
+};
+
+/**
+ * Pool of render textures shared by the frame generators
+ * 
+ * Owned outside the generator so that allocations survive a backend switch
+ * as well as a Reset. The memory budget travels with it, so everything the
+ * generators allocate is counted in one place.
+ */
+class TexturePool {
+public:
+    TexturePool();
+    ~TexturePool();
     
     /**
-     * Get shader resource view for a frame
+     * @param budget Budget to register textures with; without one the pool
+     *               keeps an unlimited budget of its own
      */
-    ID3D11ShaderResourceView* GetFrameSRV(size_t index) const;
+    bool Initialize(ID3D11Device* device, MemoryBudget* budget = nullptr);
+    void Shutdown();
     
-    /**
-     * Get the number of available frames
-     */
-    size_t GetFrameCount() const { return m_FrameCount; }
+    PooledTexture* Acquire(UINT width, UINT height, DXGI_FORMAT format, UINT bindFlags);
+    void Release(PooledTexture* texture);
     
     /**
-     * Get buffer dimensions
+     * Drop textures nobody has asked for in a while, or every idle one when
+     * the budget says so; call once per frame
      */
-    UINT GetWidth() const { return m_Width; }
-    UINT GetHeight() const { return m_Height; }
+    void EndFrame();
+    
+    ID3D11Device* GetDevice() const { return m_Device; }
+    MemoryBudget* GetBudget() const { return m_Budget; }
+    const ResourcePool::Stats& GetStats() const { return m_Pool.GetStats(); }
 
 private:
-    ID3D11Texture2D* m_Frames[MAX_FRAMES] = {};
-    ID3D11ShaderResourceView* m_FrameSRVs[MAX_FRAMES] = {};
-    
-    size_t m_CurrentIndex = 0;
-    size_t m_FrameCount = 0;
-    
-    UINT m_Width = 0;
-    UINT m_Height = 0;
-    DXGI_FORMAT m_Format = DXGI_FORMAT_UNKNOWN;
-    
+    D3D11TextureAllocator m_Allocator;
+    ResourcePool m_Pool;
     ID3D11Device* m_Device = nullptr;
+    MemoryBudget m_OwnedBudget;
+    MemoryBudget* m_Budget = nullptr;
+};
+
+/**
+ * GPU frame history slot: a copy target for the back buffer and its view
+ */
+struct GpuFrame {
+    PooledTexture* texture = nullptr;
+    TexturePool* pool = nullptr;
+    
+    bool Create(TexturePool* texturePool, UINT width, UINT height, DXGI_FORMAT format);
+    void Release();
 };
 
 /**
@@ -179,6 +315,11 @@ public:
      * Get motion vector SRV
      */
     ID3D11ShaderResourceView* GetMotionVectorsSRV() const { return m_MotionVectorsSRV; }
+    
+    /**
+     * Bytes held in textures and shaders, for the memory budget
+     */
+    uint64_t GetMemoryBytes() const { return m_MemoryBytes; }
 
 private:
     bool CreateShader();
@@ -188,7 +329,184 @@ private:
     ID3D11Texture2D* m_MotionVectors = nullptr;
     ID3D11ShaderResourceView* m_MotionVectorsSRV = nullptr;
     ID3D11UnorderedAccessView* m_MotionVectorsUAV = nullptr;
+    uint64_t m_MemoryBytes = 0;
+    
+    UINT m_Width = 0;
+    UINT m_Height = 0;
+};
+
+/**
+ * HUD mask from per-pixel temporal stability
+ * 
+ * GPU counterpart of HudMaskTracker: keeps a count of consecutive unchanged
+ * updates per pixel, sweeping one band of tile rows per frame.
+ */
+class HudMaskCalculator {
+public:
+    HudMaskCalculator();
+    ~HudMaskCalculator();
+    
+    bool Initialize(ID3D11Device* device, UINT width, UINT height);
+    void Shutdown();
+    
+    /**
+     * Update stability counters for the next band of tile rows
+     */
+    void Update(
+        ID3D11DeviceContext* context,
+        ID3D11ShaderResourceView* framePrev,
+        ID3D11ShaderResourceView* frameCurrent
+    );
+    
+    /**
+     * Forget all stability history (scene change)
+     */
+    void Reset(ID3D11DeviceContext* context);
+    
+    /**
+     * Get stability counter SRV (R32_UINT, swap chain size)
+     */
+    ID3D11ShaderResourceView* GetStabilitySRV() const { return m_StabilitySRV; }
+    
+    /**
+     * Bytes held in textures, buffers and shaders, for the memory budget
+     */
+    uint64_t GetMemoryBytes() const { return m_MemoryBytes; }
+
+private:
+    bool CreateShader();
+    
+    ID3D11Device* m_Device = nullptr;
+    ID3D11ComputeShader* m_StabilityCS = nullptr;
+    ID3D11Buffer* m_ConstantBuffer = nullptr;
+    ID3D11Texture2D* m_Stability = nullptr;
+    ID3D11ShaderResourceView* m_StabilitySRV = nullptr;
+    ID3D11UnorderedAccessView* m_StabilityUAV = nullptr;
+    uint64_t m_MemoryBytes = 0;
+    
+    UINT m_NextTileRow = 0;
+    UINT m_Width = 0;
+    UINT m_Height = 0;
+};
+
+/**
+ * Per-tile interpolation kernel selection on the GPU
+ * 
+ * GPU counterpart of TileClassifier: one thread per tile reads the motion
+ * vectors that can reach it and, for a still tile, compares its pixels in
+ * both frames. It picks Static, Blend, Warp or Dynamic and appends the tile
+ * to that class's list. Each list is then drawn with DrawInstancedIndirect,
+ * one quad per tile, so a class's kernel only runs on its own tiles and the
+ * CPU never waits for the classification.
+ * 
+ * With tile reuse, a first pass hashes each tile's pixels in both frames,
+ * its motion texels and HUD mask; a tile's key mixes those hashes over
+ * every tile its output can read from, as TileCache does on the CPU. A tile
+ * whose key matches the one stored last time is in no list, so the target
+ * keeps the pixels the previous generated frame drew there.
+ */
+class TileClassCalculator {
+public:
+    static constexpr UINT TILE_SIZE = TileClassifier::TILE_SIZE;
+    
+    // One list per class, Static included
+    static constexpr UINT CLASS_COUNT = TILE_CLASS_COUNT;
+    
+    TileClassCalculator();
+    ~TileClassCalculator();
+    
+    /**
+     * Allocate lists for the largest output (swap chain size)
+     */
+    bool Initialize(ID3D11Device* device, UINT width, UINT height);
+    void Shutdown();
+    
+    /**
+     * Tile reuse inputs for Classify
+     */
+    struct ReuseParams {
+        ID3D11ShaderResourceView* hudStability = nullptr;  // Mask the kernels read, or null
+        uint64_t settingsKey = 0;   // Hash of every setting that changes the output
+        bool targetValid = false;   // The target still holds the last Classify's frame
+    };
+    
+    /**
+     * Classify every tile of an output and rebuild the work lists
+     * 
+     * @param motionVectors Motion field (UV units)
+     * @param framePrev Frames compared for static tiles; may be null when
+     *                  staticDetection is off
+     * @param outputWidth Size of the target the lists will be drawn into
+     * @param staticDetection List still tiles whose pixels match in both
+     *                        frames as Static
+     * @param motionClasses Split moving tiles into Blend / Warp / Dynamic;
+     *                      off lists them all as Dynamic
+     * @param reuse Leave tiles whose inputs hash as last time out of every
+     *              list; null draws every tile. Needs both frames.
+     */
+    void Classify(
+        ID3D11DeviceContext* context,
+        ID3D11ShaderResourceView* motionVectors,
+        ID3D11ShaderResourceView* framePrev,
+        ID3D11ShaderResourceView* frameCurrent,
+        UINT outputWidth,
+        UINT outputHeight,
+        bool staticDetection,
+        bool motionClasses,
+        const ReuseParams* reuse = nullptr
+    );
+    
+    /**
+     * Draw one quad per tile of a class with the bound pixel shader,
+     * render target and viewport
+     */
+    void DrawTiles(ID3D11DeviceContext* context, TileClass cls);
+    
+    /**
+     * Tile counts of an earlier Classify, read back without stalling
+     * 
+     * @return False until a readback has completed
+     */
+    bool ReadCounts(ID3D11DeviceContext* context, TileKernelCounts& counts);
+    
+    /**
+     * Bytes held in buffers and shaders, for the memory budget
+     */
+    uint64_t GetMemoryBytes() const { return m_MemoryBytes; }
+
+private:
+    bool CreateShaders();
+    
+    static UINT ListIndex(TileClass cls) { return static_cast<UINT>(cls); }
+    
+    ID3D11Device* m_Device = nullptr;
+    ID3D11ComputeShader* m_ClassifyCS = nullptr;
+    ID3D11ComputeShader* m_HashCS = nullptr;
+    ID3D11VertexShader* m_TileVS = nullptr;
+    ID3D11Buffer* m_ConstantBuffer = nullptr;
+    ID3D11Buffer* m_DrawConstants[CLASS_COUNT] = {};
+    
+    // Tile lists: CLASS_COUNT runs of m_ListCapacity packed tile coordinates
+    ID3D11Buffer* m_TileLists = nullptr;
+    ID3D11ShaderResourceView* m_TileListsSRV = nullptr;
+    ID3D11UnorderedAccessView* m_TileListsUAV = nullptr;
+    
+    // Tile reuse: this frame's content hash and largest motion per tile, and
+    // the key each tile of the target was last drawn with
+    ID3D11Buffer* m_TileHashes = nullptr;
+    ID3D11UnorderedAccessView* m_TileHashesUAV = nullptr;
+    ID3D11Buffer* m_TileKeys = nullptr;
+    ID3D11UnorderedAccessView* m_TileKeysUAV = nullptr;
+    
+    // DrawInstancedIndirect arguments per class; the instance count is the
+    // list length. One more row after them holds the reuse counters.
+    ID3D11Buffer* m_DrawArgs = nullptr;
+    ID3D11UnorderedAccessView* m_DrawArgsUAV = nullptr;
+    ID3D11Buffer* m_DrawArgsReadback = nullptr;
+    bool m_ReadbackPending = false;
+    uint64_t m_MemoryBytes = 0;
     
+    UINT m_ListCapacity = 0;
     UINT m_Width = 0;
     UINT m_Height = 0;
 };
@@ -0,0 +1,136 @@
+/**
+ * Frame Handle Implementation
+ */
+
+#include "frame_handle.h"
+#include "../utils/logger.h"
+
+#include <utility>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+// ============================================================================
+// FrameHandle Implementation
+// ============================================================================
+
+FrameHandle::FrameHandle(const FrameHandle& other) : m_Table(other.m_Table), m_Index(other.m_Index) {
+    if (m_Table) {
+        m_Table->AddRef(m_Index);
+    }
+}
+
+FrameHandle::FrameHandle(FrameHandle&& other) noexcept : m_Table(other.m_Table), m_Index(other.m_Index) {
+    other.m_Table = nullptr;
+}
+
+FrameHandle& FrameHandle::operator=(const FrameHandle& other) {
+    if (this != &other) {
+        FrameHandle copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+FrameHandle& FrameHandle::operator=(FrameHandle&& other) noexcept {
+    if (this != &other) {
+        Reset();
+        m_Table = other.m_Table;
+        m_Index = other.m_Index;
+        other.m_Table = nullptr;
+    }
+    return *this;
+}
+
+FrameHandle::~FrameHandle() {
+    Reset();
+}
+
+void FrameHandle::Reset() {
+    if (m_Table) {
+        m_Table->Release(m_Index);
+        m_Table = nullptr;
+    }
+}
+
+void* FrameHandle::Get() const {
+    return m_Table ? m_Table->m_Entries[m_Index].resource : nullptr;
+}
+
+uint64_t FrameHandle::GetBytes() const {
+    return m_Table ? m_Table->m_Entries[m_Index].bytes : 0;
+}
+
+uint32_t FrameHandle::GetRefCount() const {
+    return m_Table ? m_Table->m_Entries[m_Index].refs : 0;
+}
+
+// ============================================================================
+// FrameTable Implementation
+// ============================================================================
+
+FrameHandle FrameTable::Adopt(void* resource, uint64_t bytes, ReleaseFn release) {
+    if (!resource) return {};
+
+    uint32_t free = CAPACITY;
+    for (uint32_t i = 0; i < CAPACITY; ++i) {
+        if (m_Entries[i].resource == resource) {
+            // One reference per resource is enough; the caller's is extra
+            if (release) {
+                release(resource);
+            }
+            AddRef(i);
+            return FrameHandle(this, i);
+        }
+        if (!m_Entries[i].resource && free == CAPACITY) {
+            free = i;
+        }
+    }
+
+    if (free == CAPACITY) {
+        Utils::Logger::Error("Frame table full (%u resources)", CAPACITY);
+        if (release) {
+            release(resource);
+        }
+        return {};
+    }
+
+    m_Entries[free] = { resource, bytes, release, 1 };
+    ++m_Live;
+    return FrameHandle(this, free);
+}
+
+void FrameTable::Release(uint32_t index) {
+    Entry& entry = m_Entries[index];
+    if (--entry.refs > 0) return;
+
+    if (entry.release) {
+        entry.release(entry.resource);
+    }
+    entry = {};
+    --m_Live;
+}
+
+// ============================================================================
+// FrameTransfer Implementation
+// ============================================================================
+
+bool FrameTransfer::Copy(const FrameHandle& target, const FrameHandle& source) {
+    if (!target || !source) return false;
+
+    if (target.Aliases(source)) {
+        ++m_Counters.aliased;
+        return true;
+    }
+
+    if (!m_Device || !m_Device->CopyFrame(target.Get(), source.Get())) {
+        return false;
+    }
+
+    ++m_Counters.copies;
+    m_Counters.bytesMoved += source.GetBytes();
+    return true;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * Frame Handles
+ *
+ * Ownership of the frames on the capture/present path. History slots,
+ * the generated output and the swap chain's back buffer are passed around
+ * as refcounted handles; every reference to one resource shares a table
+ * entry, so two stages that can use the same resource alias it instead of
+ * copying. Copies that are still needed go through FrameTransfer, which
+ * counts them.
+ */
+
+#ifndef FIVEM_FRAMEGEN_FRAME_HANDLE_H
+#define FIVEM_FRAMEGEN_FRAME_HANDLE_H
+
+#include "staging_device.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+class FrameTable;
+
+/**
+ * Refcounted reference to a frame resource in a FrameTable
+ */
+class FrameHandle {
+public:
+    FrameHandle() = default;
+    FrameHandle(const FrameHandle& other);
+    FrameHandle(FrameHandle&& other) noexcept;
+    FrameHandle& operator=(const FrameHandle& other);
+    FrameHandle& operator=(FrameHandle&& other) noexcept;
+    ~FrameHandle();
+
+    /**
+     * Drop this reference; the last one releases the resource
+     */
+    void Reset();
+
+    void* Get() const;
+    uint64_t GetBytes() const;
+    uint32_t GetRefCount() const;
+
+    /**
+     * True if both refer to the same resource
+     */
+    bool Aliases(const FrameHandle& other) const {
+        return m_Table && m_Table == other.m_Table && m_Index == other.m_Index;
+    }
+
+    explicit operator bool() const { return m_Table != nullptr; }
+
+private:
+    friend class FrameTable;
+
+    // Takes over a reference already counted by the table
+    FrameHandle(FrameTable* table, uint32_t index) : m_Table(table), m_Index(index) {}
+
+    FrameTable* m_Table = nullptr;
+    uint32_t m_Index = 0;
+};
+
+/**
+ * Fixed-size registry of frame resources and their reference counts
+ *
+ * Entries live in the table itself, so handing out handles never
+ * allocates. The table must outlive its handles.
+ */
+class FrameTable {
+public:
+    static constexpr uint32_t CAPACITY = 16;
+
+    /**
+     * Drops the table's reference to an owned resource (e.g. COM Release)
+     */
+    using ReleaseFn = void (*)(void* resource);
+
+    FrameTable() = default;
+    ~FrameTable() = default;
+
+    FrameTable(const FrameTable&) = delete;
+    FrameTable& operator=(const FrameTable&) = delete;
+
+    /**
+     * Handle to a resource, registering it on first use
+     *
+     * @param bytes Size of one full copy of the frame
+     * @param release Takes over one reference from the caller, dropped
+     *                when the last handle goes; pass nullptr for resources
+     *                owned elsewhere (e.g. pooled textures). A resource
+     *                already in the table has the caller's extra reference
+     *                dropped right away.
+     * @return Empty handle if resource is null or the table is full
+     */
+    FrameHandle Adopt(void* resource, uint64_t bytes, ReleaseFn release = nullptr);
+
+    /**
+     * Resources with at least one handle
+     */
+    uint32_t GetLive() const { return m_Live; }
+
+private:
+    friend class FrameHandle;
+
+    struct Entry {
+        void* resource = nullptr;
+        uint64_t bytes = 0;
+        ReleaseFn release = nullptr;
+        uint32_t refs = 0;
+    };
+
+    void AddRef(uint32_t index) { ++m_Entries[index].refs; }
+    void Release(uint32_t index);
+
+    Entry m_Entries[CAPACITY];
+    uint32_t m_Live = 0;
+};
+
+/**
+ * Moves frames between resources, eliding copies between aliases
+ */
+class FrameTransfer {
+public:
+    struct Counters {
+        uint64_t copies = 0;        // Full-frame GPU copies made
+        uint64_t bytesMoved = 0;
+        uint64_t aliased = 0;       // Copies skipped because both ends were one resource
+    };
+
+    void SetDevice(IStagingDevice* device) { m_Device = device; }
+
+    /**
+     * Make target hold source's frame: nothing to do when they alias,
+     * otherwise a GPU copy
+     */
+    bool Copy(const FrameHandle& target, const FrameHandle& source);
+
+    const Counters& GetCounters() const { return m_Counters; }
+    void ResetCounters() { m_Counters = {}; }
+
+private:
+    IStagingDevice* m_Device = nullptr;
+    Counters m_Counters;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_FRAME_HANDLE_H
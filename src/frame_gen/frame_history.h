@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * Frame History
+ *
+ * Fixed-depth ring of captured frames. Depth and slot type are template
+ * parameters, so a consumer allocates only the frames it reads and slot
+ * lookup compiles to a mask (power-of-two depths) or a single compare.
+ */
+
+#ifndef FIVEM_FRAMEGEN_FRAME_HISTORY_H
+#define FIVEM_FRAMEGEN_FRAME_HISTORY_H
+
+#include <array>
+#include <cstddef>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Ring of the Depth most recent frames
+ *
+ * Frame is the slot type. It must be default-constructible and provide
+ * bool Create(...) taking the arguments given to Initialize, and a
+ * Release() that is safe on a slot that was never created.
+ */
+template <size_t Depth, typename Frame>
+class FrameHistory {
+public:
+    static_assert(Depth >= 2, "interpolation reads two frames");
+
+    static constexpr size_t DEPTH = Depth;
+
+    FrameHistory() = default;
+    ~FrameHistory() { Shutdown(); }
+
+    FrameHistory(const FrameHistory&) = delete;
+    FrameHistory& operator=(const FrameHistory&) = delete;
+
+    /**
+     * Create every slot, forwarding the arguments to Frame::Create
+     */
+    template <typename... Args>
+    bool Initialize(const Args&... args) {
+        Shutdown();
+        for (Frame& frame : m_Frames) {
+            if (!frame.Create(args...)) {
+                Shutdown();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Shutdown() {
+        for (Frame& frame : m_Frames) {
+            frame.Release();
+        }
+        Clear();
+    }
+
+    /**
+     * Forget the captured frames, keeping the slots
+     */
+    void Clear() {
+        m_Current = 0;
+        m_Count = 0;
+    }
+
+    /**
+     * Slot the next Advance hands out, without taking it; fill it first
+     * and Advance once that succeeded, so a failed capture leaves the
+     * frame count and order as they were
+     */
+    Frame& Next() {
+        return m_Frames[Wrap(m_Current + 1)];
+    }
+
+    /**
+     * Slot for a new frame; it becomes index 0 and replaces the oldest
+     */
+    Frame& Advance() {
+        m_Current = Wrap(m_Current + 1);
+        if (m_Count < Depth) {
+            m_Count++;
+        }
+        return m_Frames[m_Current];
+    }
+
+    /**
+     * Frame by age (0 = current, 1 = previous, etc.), nullptr if not captured
+     */
+    const Frame* Get(size_t index) const {
+        return index < m_Count ? &m_Frames[Wrap(m_Current + Depth - index)] : nullptr;
+    }
+
+    /**
+     * Get the number of captured frames (at most Depth)
+     */
+    size_t GetFrameCount() const { return m_Count; }
+
+private:
+    static constexpr bool POWER_OF_TWO = (Depth & (Depth - 1)) == 0;
+
+    /**
+     * Index into the ring; callers never pass 2 * Depth or more
+     */
+    static constexpr size_t Wrap(size_t index) {
+        if constexpr (POWER_OF_TWO) {
+            return index & (Depth - 1);
+        } else {
+            return index >= Depth ? index - Depth : index;
+        }
+    }
+
+    std::array<Frame, Depth> m_Frames = {};
+    size_t m_Current = 0;
+    size_t m_Count = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_FRAME_HISTORY_H
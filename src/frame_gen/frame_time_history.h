@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Frame Time History
+ *
+ * Rolling average of the most recent frame times for the FPS stats.
+ * A fixed ring, so recording a frame on the present path never allocates.
+ */
+
+#ifndef FIVEM_FRAMEGEN_FRAME_TIME_HISTORY_H
+#define FIVEM_FRAMEGEN_FRAME_TIME_HISTORY_H
+
+#include <cstddef>
+#include <numeric>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * The last Size frame times in milliseconds
+ */
+template <size_t Size>
+class FrameTimeHistory {
+public:
+    static_assert(Size > 0, "history needs at least one frame");
+
+    static constexpr size_t SIZE = Size;
+
+    /**
+     * Record a frame, replacing the oldest once the ring is full
+     */
+    void Push(float ms) {
+        m_Times[m_Next] = ms;
+        m_Next = (m_Next + 1) % Size;
+        if (m_Count < Size) {
+            m_Count++;
+        }
+    }
+
+    void Clear() {
+        m_Count = 0;
+        m_Next = 0;
+    }
+
+    /**
+     * Mean of the recorded frames, 0 if there are none
+     */
+    float GetAverage() const {
+        if (m_Count == 0) return 0.0f;
+        return std::accumulate(m_Times, m_Times + m_Count, 0.0f) / m_Count;
+    }
+
+    size_t GetCount() const { return m_Count; }
+
+private:
+    float m_Times[Size] = {};
+    size_t m_Count = 0;
+    size_t m_Next = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_FRAME_TIME_HISTORY_H
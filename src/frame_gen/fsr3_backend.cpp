@@ -6,7 +6,7 @@
 #include "../utils/logger.h"
 
 #include <algorithm>
-#include <numeric>
+#include <bit>
 #include <d3dcompiler.h>
 
 #pragma comment(lib, "d3dcompiler.lib")
@@ -41,48 +41,331 @@ static const char* g_InterpolationPS = R"(
 Texture2D<float4> framePrev : register(t0);
 Texture2D<float4> frameCurr : register(t1);
 Texture2D<float2> motionVectors : register(t2);
+Texture2D<uint> hudStability : register(t3);
 SamplerState linearSampler : register(s0);
 
 cbuffer Constants : register(b0) {
     float interpolationFactor;
-    float sharpness;
+    float occlusionStrength;
     float2 texelSize;
+    float2 motionTexelSize;
+    float linearBlend;
+    float hudLess;
+    float warpFilter;
+    float roiMode;
+    float roiFeather;
+    float roiRectCount;
+    float2 roiRadius;
+    float2 padding;
+    float4 roiRects[4];     // x0, y0, x1, y1 in UV
 };
 
+// Per-tile kernels (keep in sync with TileClass in tile_classifier.h). The
+// full kernel is the default; the cheaper ones are drawn over tile lists.
+#define TILE_KERNEL_BLEND 0
+#define TILE_KERNEL_WARP 1
+#define TILE_KERNEL_FULL 2
+#ifndef TILE_KERNEL
+#define TILE_KERNEL TILE_KERNEL_FULL
+#endif
+
+// ROI shapes (keep in sync with RoiMode in fivem_framegen.h)
+static const float ROI_ELLIPSE = 1.0;
+static const float ROI_RECTANGLES = 2.0;
+
+// HUD mask thresholds (keep in sync with hud_mask.h)
+static const uint HUD_STABLE_UPDATES = 4;
+static const float HUD_LUMA_TOLERANCE = 2.0 / 255.0;
+
+// Scales divergence into the warp-back error range (keep in sync with occlusion.cpp)
+static const float DIVERGENCE_SCALE = 8.0;
+
 struct PSInput {
     float4 position : SV_Position;
     float2 texcoord : TEXCOORD0;
 };
 
+// IEC 61966-2-1 transfer functions (the CPU path uses color_space.h tables)
+float3 SrgbToLinear(float3 c) {
+    return lerp(c / 12.92, pow((c + 0.055) / 1.055, 2.4), step(0.04045, c));
+}
+
+float3 LinearToSrgb(float3 c) {
+    return lerp(c * 12.92, 1.055 * pow(c, 1.0 / 2.4) - 0.055, step(0.0031308, c));
+}
+
+// Positive where the motion field expands (disocclusion), negative where it contracts
+float MotionDivergence(float2 uv) {
+    float2 mL = motionVectors.SampleLevel(linearSampler, uv - float2(motionTexelSize.x, 0), 0);
+    float2 mR = motionVectors.SampleLevel(linearSampler, uv + float2(motionTexelSize.x, 0), 0);
+    float2 mU = motionVectors.SampleLevel(linearSampler, uv - float2(0, motionTexelSize.y), 0);
+    float2 mD = motionVectors.SampleLevel(linearSampler, uv + float2(0, motionTexelSize.y), 0);
+    
+    return (mR.x - mL.x) / (2.0 * motionTexelSize.x) + (mD.y - mU.y) / (2.0 * motionTexelSize.y);
+}
+
+// 4-tap reconstruction kernels (keep in sync with WarpFilter in sampling.h)
+static const float WARP_CATMULL_ROM = 1.0;
+static const float PI = 3.14159265;
+
+float CatmullRom(float x) {
+    x = abs(x);
+    return x < 1.0 ? (1.5 * x - 2.5) * x * x + 1.0
+         : x < 2.0 ? ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0 : 0.0;
+}
+
+float Lanczos2(float x) {
+    x = max(abs(x), 1e-5);
+    return x < 2.0 ? 2.0 * sin(PI * x) * sin(PI * x * 0.5) / (PI * PI * x * x) : 0.0;
+}
+
+// Taps at distances 1 + f, f, 1 - f, 2 - f, normalised
+float4 FilterWeights(float f) {
+    float4 d = float4(1.0 + f, f, 1.0 - f, 2.0 - f);
+    float4 w = warpFilter == WARP_CATMULL_ROM
+        ? float4(CatmullRom(d.x), CatmullRom(d.y), CatmullRom(d.z), CatmullRom(d.w))
+        : float4(Lanczos2(d.x), Lanczos2(d.y), Lanczos2(d.z), Lanczos2(d.w));
+    return w / dot(w, float4(1.0, 1.0, 1.0, 1.0));
+}
+
+// Separable 4x4 fetch with clamped addressing (Quality preset)
+float4 SampleFiltered(Texture2D<float4> tex, float2 uv) {
+    float2 size;
+    tex.GetDimensions(size.x, size.y);
+    float2 pos = uv * size - 0.5;
+    float2 base = floor(pos);
+    float4 wx = FilterWeights(pos.x - base.x);
+    float4 wy = FilterWeights(pos.y - base.y);
+    int2 maxPos = int2(size) - 1;
+    
+    float4 color = 0.0;
+    [unroll]
+    for (int j = 0; j < 4; j++) {
+        float4 row = 0.0;
+        [unroll]
+        for (int i = 0; i < 4; i++) {
+            int2 texel = clamp(int2(base) + int2(i - 1, j - 1), 0, maxPos);
+            row += wx[i] * tex.Load(int3(texel, 0));
+        }
+        color += wy[j] * row;
+    }
+    return color;
+}
+
+// 1 inside the focus region, 0 outside, smooth across the feather band
+// (keep in sync with RoiMap in roi_map.cpp)
+float RoiWeight(float2 uv) {
+    float dist;
+    if (roiMode == ROI_ELLIPSE) {
+        // Radial distance past the ellipse edge
+        float2 p = uv - 0.5;
+        float d = max(length(p / roiRadius), 1e-5);
+        dist = length(p) * (1.0 - 1.0 / d);
+    } else if (roiMode == ROI_RECTANGLES) {
+        dist = 1e5;
+        for (int i = 0; i < (int)roiRectCount; i++) {
+            float2 halfSize = (roiRects[i].zw - roiRects[i].xy) * 0.5;
+            float2 outside = max(abs(uv - (roiRects[i].xy + halfSize)) - halfSize, 0.0);
+            dist = min(dist, length(outside));
+        }
+    } else {
+        return 1.0;
+    }
+    return dist <= 0.0 ? 1.0 : 1.0 - smoothstep(0.0, max(roiFeather, 1e-5), dist);
+}
+
+// Masked by the stability sweep and still unchanged this frame
+bool IsHud(int3 pos) {
+    float diff = dot(frameCurr.Load(pos).rgb - framePrev.Load(pos).rgb, float3(0.299, 0.587, 0.114));
+    return hudStability.Load(pos) >= HUD_STABLE_UPDATES && abs(diff) <= HUD_LUMA_TOLERANCE;
+}
+
 // Motion-compensated interpolation
 float4 main(PSInput input) : SV_Target {
+    // HUD-less mode: overlays come straight from the current frame, skipping the warp
+    if (hudLess > 0.0) {
+        uint2 hudSize;
+        hudStability.GetDimensions(hudSize.x, hudSize.y);
+        int3 pos = int3(input.texcoord * hudSize, 0);
+        if (IsHud(pos)) {
+            return frameCurr.Load(pos);
+        }
+    }
+    
+#if TILE_KERNEL == TILE_KERNEL_BLEND
+    // Sub-texel motion: a plain cross-fade matches the warp
+    float2 motion = 0.0;
+#else
     // Sample motion at this location
     float2 motion = motionVectors.Sample(linearSampler, input.texcoord);
+#endif
+    
+    // Motion is prev -> curr, so content here was motion * t back along the
+    // vector in the previous frame and is motion * (1 - t) ahead in the
+    // current one (same positions as the CPU engine and OcclusionEstimator)
+    float2 prevUV = input.texcoord - motion * interpolationFactor;
+    float2 currUV = input.texcoord + motion * (1.0 - interpolationFactor);
     
-    // Calculate sample positions for both frames
-    float2 prevUV = input.texcoord - motion * (1.0 - interpolationFactor);
-    float2 currUV = input.texcoord + motion * interpolationFactor;
+    // Outside the focus region only the bilinear warp and plain lerp run;
+    // the full-quality terms fade in across the feather band
+#if TILE_KERNEL == TILE_KERNEL_FULL
+    float roi = RoiWeight(input.texcoord);
+#else
+    // Smooth motion without occlusion needs only the cheap terms
+    float roi = 0.0;
+#endif
     
     // Sample both frames
     float4 prevColor = framePrev.Sample(linearSampler, prevUV);
     float4 currColor = frameCurr.Sample(linearSampler, currUV);
+    if (warpFilter > 0.0 && roi > 0.0) {
+        prevColor = lerp(prevColor, SampleFiltered(framePrev, prevUV), roi);
+        currColor = lerp(currColor, SampleFiltered(frameCurr, currUV), roi);
+    }
     
-    // Blend based on interpolation factor
-    float4 color = lerp(prevColor, currColor, interpolationFactor);
-    
-    // Optional sharpening pass
-    if (sharpness > 0.0) {
-        float4 blur = float4(0, 0, 0, 0);
-        blur += frameCurr.Sample(linearSampler, input.texcoord + float2(-texelSize.x, 0));
-        blur += frameCurr.Sample(linearSampler, input.texcoord + float2( texelSize.x, 0));
-        blur += frameCurr.Sample(linearSampler, input.texcoord + float2(0, -texelSize.y));
-        blur += frameCurr.Sample(linearSampler, input.texcoord + float2(0,  texelSize.y));
-        blur *= 0.25;
+    // Occlusion-aware blend weight: a sample whose own vector disagrees with
+    // ours (warp-back error) is occluded, and divergence tells us whether
+    // content is being covered (trust prev) or revealed (trust curr)
+    float weight = interpolationFactor;
+    if (occlusionStrength > 0.0 && roi > 0.0) {
+        float2 motionPrev = motionVectors.Sample(linearSampler, prevUV);
+        float2 motionCurr = motionVectors.Sample(linearSampler, currUV);
+        float errPrev = dot(abs(motionPrev - motion) / texelSize, float2(1, 1));
+        float errCurr = dot(abs(motionCurr - motion) / texelSize, float2(1, 1));
+        float div = MotionDivergence(input.texcoord) * DIVERGENCE_SCALE;
         
-        color = color + (color - blur) * sharpness;
+        float wPrev = (1.0 - interpolationFactor) / (1.0 + occlusionStrength * (errPrev + max(div, 0.0)));
+        float wCurr = interpolationFactor / (1.0 + occlusionStrength * (errCurr + max(-div, 0.0)));
+        weight = lerp(interpolationFactor, wCurr / max(wPrev + wCurr, 1e-5), roi);
     }
     
-    return saturate(color);
+    // Gamma-space lerp darkens bright/dark edges; optionally blend linear light
+    if (linearBlend > 0.0) {
+        prevColor.rgb = SrgbToLinear(saturate(prevColor.rgb));
+        currColor.rgb = SrgbToLinear(saturate(currColor.rgb));
+    }
+    
+    float4 color = lerp(prevColor, currColor, weight);
+    
+    if (linearBlend > 0.0) {
+        color.rgb = LinearToSrgb(color.rgb);
+    }
+    
+    // UNORM targets clamp on write; float targets keep HDR highlights
+    return max(color, 0.0);
+}
+)";
+
+// Edge-guided 2x upsample (joint bilateral, current frame as guide)
+static const char* g_UpsamplePS = R"(
+Texture2D<float4> lowRes : register(t0);
+Texture2D<float4> guide : register(t1);
+Texture2D<float4> framePrev : register(t2);
+Texture2D<uint> hudStability : register(t3);
+SamplerState linearSampler : register(s0);
+
+cbuffer Constants : register(b0) {
+    float2 lowTexelSize;
+    float rangeSigma;
+    float hudLess;
+};
+
+// HUD mask thresholds (keep in sync with hud_mask.h)
+static const uint HUD_STABLE_UPDATES = 4;
+static const float HUD_LUMA_TOLERANCE = 2.0 / 255.0;
+
+struct PSInput {
+    float4 position : SV_Position;
+    float2 texcoord : TEXCOORD0;
+};
+
+float Luminance(float3 color) {
+    return dot(color, float3(0.299, 0.587, 0.114));
+}
+
+float4 main(PSInput input) : SV_Target {
+    // The half-res pass blurs HUD edges; restore them from the current frame
+    if (hudLess > 0.0) {
+        int3 pos = int3(input.position.xy, 0);
+        float4 current = guide.Load(pos);
+        float diff = Luminance(current.rgb) - Luminance(framePrev.Load(pos).rgb);
+        if (hudStability.Load(pos) >= HUD_STABLE_UPDATES && abs(diff) <= HUD_LUMA_TOLERANCE) {
+            return current;
+        }
+    }
+    
+    float2 lowPos = input.texcoord / lowTexelSize - 0.5;
+    float2 base = floor(lowPos);
+    float2 f = lowPos - base;
+    
+    float guideLuma = Luminance(guide.SampleLevel(linearSampler, input.texcoord, 0).rgb);
+    
+    float4 sum = float4(0, 0, 0, 0);
+    float weightSum = 0.0;
+    
+    [unroll]
+    for (int j = 0; j < 2; j++) {
+        [unroll]
+        for (int i = 0; i < 2; i++) {
+            float2 tapUV = (base + float2(i, j) + 0.5) * lowTexelSize;
+            float spatial = (i ? f.x : 1.0 - f.x) * (j ? f.y : 1.0 - f.y);
+            
+            // Linear fetch at a low-res texel centre averages the guide's 2x2 footprint
+            float tapLuma = Luminance(guide.SampleLevel(linearSampler, tapUV, 0).rgb);
+            float d = (guideLuma - tapLuma) / rangeSigma;
+            float w = spatial * max(exp(-0.5 * d * d), 1.0 / 256.0);
+            
+            sum += lowRes.SampleLevel(linearSampler, tapUV, 0) * w;
+            weightSum += w;
+        }
+    }
+    
+    return sum / max(weightSum, 1e-5);
+}
+)";
+
+// Contrast-adaptive sharpening (RCAS-style), keep in sync with sharpen.cpp
+static const char* g_SharpenPS = R"(
+Texture2D<float4> source : register(t0);
+
+cbuffer Constants : register(b0) {
+    float sharpness;
+    float3 padding;
+};
+
+// Strongest lobe the limiter allows
+static const float LOBE_LIMIT = 0.25 - 1.0 / 16.0;
+static const float LIMITER_EPSILON = 1.0 / (256.0 * 255.0);
+
+struct PSInput {
+    float4 position : SV_Position;
+    float2 texcoord : TEXCOORD0;
+};
+
+float4 main(PSInput input) : SV_Target {
+    int2 pos = int2(input.position.xy);
+    int2 maxPos;
+    source.GetDimensions(maxPos.x, maxPos.y);
+    maxPos -= 1;
+    
+    // Cross: b = up, d = left, e = centre, f = right, h = down
+    float4 e = source.Load(int3(pos, 0));
+    float3 b = source.Load(int3(pos.x, max(pos.y - 1, 0), 0)).rgb;
+    float3 d = source.Load(int3(max(pos.x - 1, 0), pos.y, 0)).rgb;
+    float3 f = source.Load(int3(min(pos.x + 1, maxPos.x), pos.y, 0)).rgb;
+    float3 h = source.Load(int3(pos.x, min(pos.y + 1, maxPos.y), 0)).rgb;
+    
+    float3 mn4 = min(min(b, d), min(f, h));
+    float3 mx4 = max(max(b, d), max(f, h));
+    
+    // Largest negative lobe that keeps each channel inside [0, 1]
+    float3 hitMin = min(mn4, e.rgb) / (4.0 * mx4 + LIMITER_EPSILON);
+    float3 hitMax = (1.0 - max(mx4, e.rgb)) / (4.0 * mn4 - 4.0 - LIMITER_EPSILON);
+    float3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-LOBE_LIMIT, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * sharpness;
+    
+    float3 color = (lobe * (b + d + f + h) + e.rgb) / (4.0 * lobe + 1.0);
+    return float4(saturate(color), e.a);
 }
 )";
 
@@ -133,15 +416,49 @@ bool FSR3FrameGenerator::Initialize(
     swapChain->GetDesc(&swapDesc);
     m_Width = swapDesc.BufferDesc.Width;
     m_Height = swapDesc.BufferDesc.Height;
+    m_Format = swapDesc.BufferDesc.Format;
     
     Utils::Logger::Info("Initializing FSR3 backend (%dx%d)", m_Width, m_Height);
     
-    // Initialize frame buffer
-    m_FrameBuffer = std::make_unique<FrameBuffer>();
-    if (!m_FrameBuffer->Initialize(device, m_Width, m_Height, swapDesc.BufferDesc.Format)) {
-        Utils::Logger::Error("Failed to initialize frame buffer");
+    // CPU-side kernels are selected by this; the GPU path handles any format
+    m_HasPixelFormat = ToPixelFormat(m_Format, m_PixelFormat);
+    if (m_HasPixelFormat) {
+        Utils::Logger::Info("Swap chain format: %s", GetPixelFormatName(m_PixelFormat));
+    } else {
+        Utils::Logger::Warn("Swap chain format %d has no CPU pixel format", static_cast<int>(m_Format));
+    }
+    
+    // Textures of a shared pool made on another device cannot be used here
+    if (m_TexturePool && m_TexturePool->GetDevice() != device) {
+        Utils::Logger::Warn("Texture pool belongs to another device, using a private pool");
+        m_TexturePool = nullptr;
+    }
+    if (!m_TexturePool) {
+        m_OwnedTexturePool = std::make_unique<TexturePool>();
+        if (!m_OwnedTexturePool->Initialize(device)) {
+            Utils::Logger::Error("Failed to initialize texture pool");
+            return false;
+        }
+        m_TexturePool = m_OwnedTexturePool.get();
+    }
+    m_MemoryBudget = m_TexturePool->GetBudget();
+    m_StagingDevice.SetDevice(device, context);
+    m_StagingDevice.SetBudget(m_MemoryBudget);
+    m_Transfer.SetDevice(&m_StagingDevice);
+    m_FrameBytes = GetTextureBytes(m_Width, m_Height, m_Format);
+    
+    // Initialize frame history
+    m_FrameHistory = std::make_unique<FrameHistory<HISTORY_DEPTH, GpuFrame>>();
+    if (!m_FrameHistory->Initialize(m_TexturePool, m_Width, m_Height, swapDesc.BufferDesc.Format)) {
+        Utils::Logger::Error("Failed to initialize frame history");
         return false;
     }
+    Utils::Logger::Info("Frame history initialized (%zu frames)", HISTORY_DEPTH);
+    
+    if (m_ReadbackDepth > 0 && !CreateReadbackRing()) {
+        Utils::Logger::Warn("CPU readback unavailable");
+        m_ReadbackDepth = 0;
+    }
     
     // Initialize motion vector calculator
     m_MotionCalc = std::make_unique<MotionVectorCalculator>();
@@ -149,33 +466,20 @@ bool FSR3FrameGenerator::Initialize(
         Utils::Logger::Error("Failed to initialize motion calculator");
         return false;
     }
+    m_MemoryBudget->Register(m_MotionCalc.get(), MemoryCategory::Buffers, m_MotionCalc->GetMemoryBytes());
     
-    // Create interpolated frame texture
-    D3D11_TEXTURE2D_DESC texDesc = {};
-    texDesc.Width = m_Width;
-    texDesc.Height = m_Height;
-    texDesc.MipLevels = 1;
-    texDesc.ArraySize = 1;
-    texDesc.Format = swapDesc.BufferDesc.Format;
-    texDesc.SampleDesc.Count = 1;
-    texDesc.Usage = D3D11_USAGE_DEFAULT;
-    texDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-    
-    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &m_InterpolatedFrame);
-    if (FAILED(hr)) {
-        Utils::Logger::Error("Failed to create interpolated frame: 0x%08X", hr);
-        return false;
-    }
-    
-    hr = device->CreateRenderTargetView(m_InterpolatedFrame, nullptr, &m_InterpolatedRTV);
-    if (FAILED(hr)) {
-        Utils::Logger::Error("Failed to create interpolated RTV: 0x%08X", hr);
+    // Interpolation target, and the sharpen pass input
+    const UINT targetBindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    m_InterpolatedFrame = m_TexturePool->Acquire(m_Width, m_Height, m_Format, targetBindFlags);
+    if (!m_InterpolatedFrame) {
+        Utils::Logger::Error("Failed to create interpolated frame");
         return false;
     }
+    m_Output = m_Frames.Adopt(m_InterpolatedFrame->texture, m_FrameBytes);
     
-    hr = device->CreateShaderResourceView(m_InterpolatedFrame, nullptr, &m_InterpolatedSRV);
-    if (FAILED(hr)) {
-        Utils::Logger::Error("Failed to create interpolated SRV: 0x%08X", hr);
+    m_UnsharpenedFrame = m_TexturePool->Acquire(m_Width, m_Height, m_Format, targetBindFlags);
+    if (!m_UnsharpenedFrame) {
+        Utils::Logger::Error("Failed to create unsharpened frame");
         return false;
     }
     
@@ -185,7 +489,7 @@ bool FSR3FrameGenerator::Initialize(
     ID3DBlob* errorBlob = nullptr;
     
     // Compile vertex shader
-    hr = D3DCompile(g_FullscreenVS, strlen(g_FullscreenVS), "FullscreenVS",
+    HRESULT hr = D3DCompile(g_FullscreenVS, strlen(g_FullscreenVS), "FullscreenVS",
         nullptr, nullptr, "main", "vs_5_0", 0, 0, &vsBlob, &errorBlob);
     if (FAILED(hr)) {
         if (errorBlob) {
@@ -197,6 +501,9 @@ bool FSR3FrameGenerator::Initialize(
     
     hr = device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(),
         nullptr, &m_FullscreenVS);
+    if (SUCCEEDED(hr)) {
+        m_MemoryBudget->Register(m_FullscreenVS, MemoryCategory::Shaders, vsBlob->GetBufferSize());
+    }
     vsBlob->Release();
     if (FAILED(hr)) {
         Utils::Logger::Error("Failed to create vertex shader: 0x%08X", hr);
@@ -216,12 +523,48 @@ bool FSR3FrameGenerator::Initialize(
     
     hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
         nullptr, &m_InterpolationPS);
+    if (SUCCEEDED(hr)) {
+        m_MemoryBudget->Register(m_InterpolationPS, MemoryCategory::Shaders, psBlob->GetBufferSize());
+    }
     psBlob->Release();
     if (FAILED(hr)) {
         Utils::Logger::Error("Failed to create interpolation shader: 0x%08X", hr);
         return false;
     }
     
+    // Cheaper variants for the Blend and Warp tile lists
+    struct TileKernel {
+        const char* define;
+        ID3D11PixelShader** shader;
+    };
+    const TileKernel tileKernels[] = {
+        { "0", &m_BlendTilePS },
+        { "1", &m_WarpTilePS },
+    };
+    for (const TileKernel& kernel : tileKernels) {
+        const D3D_SHADER_MACRO macros[] = { { "TILE_KERNEL", kernel.define }, { nullptr, nullptr } };
+        hr = D3DCompile(g_InterpolationPS, strlen(g_InterpolationPS), "InterpolationPS",
+            macros, nullptr, "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+        if (FAILED(hr)) {
+            if (errorBlob) {
+                Utils::Logger::Error("Tile kernel PS compile error: %s", (char*)errorBlob->GetBufferPointer());
+                errorBlob->Release();
+            }
+            return false;
+        }
+        
+        hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
+            nullptr, kernel.shader);
+        if (SUCCEEDED(hr)) {
+            m_MemoryBudget->Register(*kernel.shader, MemoryCategory::Shaders, psBlob->GetBufferSize());
+        }
+        psBlob->Release();
+        if (FAILED(hr)) {
+            Utils::Logger::Error("Failed to create tile kernel shader: 0x%08X", hr);
+            return false;
+        }
+    }
+    
     // Compile present pixel shader
     hr = D3DCompile(g_PresentPS, strlen(g_PresentPS), "PresentPS",
         nullptr, nullptr, "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
@@ -235,12 +578,59 @@ bool FSR3FrameGenerator::Initialize(
     
     hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
         nullptr, &m_PresentPS);
+    if (SUCCEEDED(hr)) {
+        m_MemoryBudget->Register(m_PresentPS, MemoryCategory::Shaders, psBlob->GetBufferSize());
+    }
     psBlob->Release();
     if (FAILED(hr)) {
         Utils::Logger::Error("Failed to create present shader: 0x%08X", hr);
         return false;
     }
     
+    // Compile upsample pixel shader
+    hr = D3DCompile(g_UpsamplePS, strlen(g_UpsamplePS), "UpsamplePS",
+        nullptr, nullptr, "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+    if (FAILED(hr)) {
+        if (errorBlob) {
+            Utils::Logger::Error("Upsample PS compile error: %s", (char*)errorBlob->GetBufferPointer());
+            errorBlob->Release();
+        }
+        return false;
+    }
+    
+    hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
+        nullptr, &m_UpsamplePS);
+    if (SUCCEEDED(hr)) {
+        m_MemoryBudget->Register(m_UpsamplePS, MemoryCategory::Shaders, psBlob->GetBufferSize());
+    }
+    psBlob->Release();
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create upsample shader: 0x%08X", hr);
+        return false;
+    }
+    
+    // Compile sharpen pixel shader
+    hr = D3DCompile(g_SharpenPS, strlen(g_SharpenPS), "SharpenPS",
+        nullptr, nullptr, "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+    if (FAILED(hr)) {
+        if (errorBlob) {
+            Utils::Logger::Error("Sharpen PS compile error: %s", (char*)errorBlob->GetBufferPointer());
+            errorBlob->Release();
+        }
+        return false;
+    }
+    
+    hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
+        nullptr, &m_SharpenPS);
+    if (SUCCEEDED(hr)) {
+        m_MemoryBudget->Register(m_SharpenPS, MemoryCategory::Shaders, psBlob->GetBufferSize());
+    }
+    psBlob->Release();
+    if (FAILED(hr)) {
+        Utils::Logger::Error("Failed to create sharpen shader: 0x%08X", hr);
+        return false;
+    }
+    
     // Create sampler
     D3D11_SAMPLER_DESC samplerDesc = {};
     samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -258,7 +648,7 @@ bool FSR3FrameGenerator::Initialize(
     
     // Create constant buffer
     D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = 16;  // 4 floats
+    cbDesc.ByteWidth = 128;  // 32 floats (largest pass: interpolation)
     cbDesc.Usage = D3D11_USAGE_DYNAMIC;
     cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
     cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -268,6 +658,27 @@ bool FSR3FrameGenerator::Initialize(
         Utils::Logger::Error("Failed to create constant buffer: 0x%08X", hr);
         return false;
     }
+    m_MemoryBudget->Register(m_ConstantBuffer, MemoryCategory::Buffers, cbDesc.ByteWidth);
+    
+    if (m_HalfResolution && !CreateHalfResTarget()) {
+        Utils::Logger::Warn("Half-resolution target unavailable, interpolating at full resolution");
+        m_HalfResolution = false;
+    }
+    
+    if (m_HudLessMode && !CreateHudMask()) {
+        Utils::Logger::Warn("HUD mask unavailable, interpolating HUD with the scene");
+        m_HudLessMode = false;
+    }
+    
+    if ((m_MotionTiers || m_StaticTileSkip || m_TileReuse) && !CreateTileClassifier()) {
+        Utils::Logger::Warn("Tile classifier unavailable, using the full kernel everywhere");
+        m_MotionTiers = false;
+        m_StaticTileSkip = false;
+        m_TileReuse = false;
+    }
+    
+    // A shared budget may already be degraded by the previous backend
+    ApplyMemoryDegradation();
     
     m_Initialized = true;
     Utils::Logger::Info("FSR3 backend initialized successfully");
@@ -280,22 +691,56 @@ void FSR3FrameGenerator::Shutdown() {
     
     Utils::Logger::Info("Shutting down FSR3 backend...");
     
+    // Nothing below is counted once released
+    const void* tracked[] = {
+        m_FullscreenVS, m_InterpolationPS, m_BlendTilePS, m_WarpTilePS, m_PresentPS,
+        m_UpsamplePS, m_SharpenPS, m_ConstantBuffer,
+        m_MotionCalc.get(), m_HudMask.get(), m_TileClasses.get()
+    };
+    for (const void* owner : tracked) {
+        m_MemoryBudget->Unregister(owner);
+    }
+    
     // Release resources
+    m_Upload.Shutdown();
+    ReleaseReadbackRing();
+    ReleaseHalfResTarget();
+    m_HudMask.reset();
+    m_TileClasses.reset();
     if (m_ConstantBuffer) { m_ConstantBuffer->Release(); m_ConstantBuffer = nullptr; }
     if (m_LinearSampler) { m_LinearSampler->Release(); m_LinearSampler = nullptr; }
+    if (m_SharpenPS) { m_SharpenPS->Release(); m_SharpenPS = nullptr; }
+    if (m_UpsamplePS) { m_UpsamplePS->Release(); m_UpsamplePS = nullptr; }
     if (m_PresentPS) { m_PresentPS->Release(); m_PresentPS = nullptr; }
     if (m_InterpolationPS) { m_InterpolationPS->Release(); m_InterpolationPS = nullptr; }
+    if (m_BlendTilePS) { m_BlendTilePS->Release(); m_BlendTilePS = nullptr; }
+    if (m_WarpTilePS) { m_WarpTilePS->Release(); m_WarpTilePS = nullptr; }
     if (m_FullscreenVS) { m_FullscreenVS->Release(); m_FullscreenVS = nullptr; }
-    if (m_InterpolatedSRV) { m_InterpolatedSRV->Release(); m_InterpolatedSRV = nullptr; }
-    if (m_InterpolatedRTV) { m_InterpolatedRTV->Release(); m_InterpolatedRTV = nullptr; }
-    if (m_InterpolatedFrame) { m_InterpolatedFrame->Release(); m_InterpolatedFrame = nullptr; }
+    m_Output.Reset();
+    if (m_InterpolatedFrame) { m_TexturePool->Release(m_InterpolatedFrame); m_InterpolatedFrame = nullptr; }
+    if (m_UnsharpenedFrame) { m_TexturePool->Release(m_UnsharpenedFrame); m_UnsharpenedFrame = nullptr; }
     
     m_MotionCalc.reset();
-    m_FrameBuffer.reset();
+    m_FrameHistory.reset();
+    
+    // A shared pool keeps the textures for the next generator
+    m_OwnedTexturePool.reset();
+    m_TexturePool = nullptr;
+    m_MemoryBudget = nullptr;
+    m_BudgetHalfRes = false;
+    m_TileReuseTarget = nullptr;
     
     m_Initialized = false;
 }
 
+void FSR3FrameGenerator::SetTexturePool(TexturePool* pool) {
+    if (m_Initialized) {
+        Utils::Logger::Warn("Texture pool must be set before Initialize");
+        return;
+    }
+    m_TexturePool = pool;
+}
+
 void FSR3FrameGenerator::ProcessFrame() {
     if (!m_Initialized) return;
     
@@ -304,56 +749,180 @@ void FSR3FrameGenerator::ProcessFrame() {
     float deltaMs = std::chrono::duration<float, std::milli>(now - m_LastFrameTime).count();
     m_LastFrameTime = now;
     
-    // Capture current back buffer
-    if (!CaptureBackBuffer()) {
+    // Last frame's readback has had its frame; its staging copy is reused
+    if (m_HasReadbackFrame) {
+        m_Readback.Release();
+        m_HasReadbackFrame = false;
+    }
+    
+    // One reference to the back buffer for the whole cycle
+    FrameHandle backBuffer = AcquireBackBuffer();
+    if (!backBuffer || !CaptureBackBuffer(backBuffer)) {
         return;
     }
     
     // Need at least 2 frames for interpolation
-    if (m_FrameBuffer->GetFrameCount() < 2) {
+    if (m_FrameHistory->GetFrameCount() < 2) {
         m_FirstFrame = false;
         return;
     }
     
     // Check if we should generate a frame
     if (ShouldGenerateFrame()) {
-        if (GenerateInterpolatedFrame()) {
-            PresentGeneratedFrame();
+        // The real frame is safe in the history, so the generated one can
+        // be rendered straight into the back buffer and presented as is,
+        // unless reused tiles have to find this frame there next time
+        ID3D11RenderTargetView* backBufferTarget = ReusesTilesInOutput() ? nullptr : CreateBackBufferTarget(backBuffer);
+        const FrameHandle& output = backBufferTarget ? backBuffer : m_Output;
+        if (GenerateInterpolatedFrame(backBufferTarget ? backBufferTarget : m_InterpolatedFrame->rtv)) {
+            PresentGeneratedFrame(backBuffer, output);
             m_FramesGenerated++;
         }
+        if (backBufferTarget) {
+            backBufferTarget->Release();
+        }
     }
     
     // Update stats
-    m_FrameTimeHistory.push_back(deltaMs);
-    if (m_FrameTimeHistory.size() > FRAME_HISTORY_SIZE) {
-        m_FrameTimeHistory.pop_front();
-    }
+    m_FrameTimeHistory.Push(deltaMs);
     
     UpdateStats();
+    if (m_MemoryBudget->Update()) {
+        ApplyMemoryDegradation();
+    }
+    m_TexturePool->EndFrame();
     m_TotalFrames++;
 }
 
-bool FSR3FrameGenerator::CaptureBackBuffer() {
-    // Get back buffer
+FrameHandle FSR3FrameGenerator::AcquireBackBuffer() {
     ID3D11Texture2D* backBuffer = nullptr;
     HRESULT hr = m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer);
     if (FAILED(hr)) {
+        return {};
+    }
+    
+    // The table takes over this reference and drops it with the last handle
+    return m_Frames.Adopt(backBuffer, m_FrameBytes, [](void* resource) {
+        static_cast<ID3D11Texture2D*>(resource)->Release();
+    });
+}
+
+ID3D11RenderTargetView* FSR3FrameGenerator::CreateBackBufferTarget(const FrameHandle& backBuffer) {
+    auto* texture = static_cast<ID3D11Texture2D*>(backBuffer.Get());
+    D3D11_TEXTURE2D_DESC desc;
+    texture->GetDesc(&desc);
+    
+    // The passes render single-sampled at the size they were set up for
+    if (!(desc.BindFlags & D3D11_BIND_RENDER_TARGET) || desc.SampleDesc.Count != 1 ||
+        desc.Width != m_Width || desc.Height != m_Height) {
+        return nullptr;
+    }
+    
+    ID3D11RenderTargetView* rtv = nullptr;
+    if (FAILED(m_Device->CreateRenderTargetView(texture, nullptr, &rtv))) {
+        return nullptr;
+    }
+    return rtv;
+}
+
+bool FSR3FrameGenerator::CaptureBackBuffer(const FrameHandle& backBuffer) {
+    // Copy into the oldest history slot; the one copy a real frame needs,
+    // as the swap chain reuses the back buffer. The history only moves on
+    // once the copy is made, so a failure never shows a stale slot as current
+    ID3D11Texture2D* slot = m_FrameHistory->Next().texture->texture;
+    if (!m_Transfer.Copy(m_Frames.Adopt(slot, m_FrameBytes), backBuffer)) {
+        return false;
+    }
+    m_FrameHistory->Advance();
+    
+    // Queue this frame for the CPU and pick up one captured a few frames ago
+    if (m_Readback.IsInitialized()) {
+        m_Readback.Submit(slot);
+        m_HasReadbackFrame = m_Readback.Acquire(m_ReadbackFrame);
+    }
+    
+    return true;
+}
+
+void FSR3FrameGenerator::SetReadbackDepth(uint32_t depth) {
+    depth = (std::min)(depth, ReadbackRing::MAX_DEPTH);
+    if (depth == m_ReadbackDepth) return;
+    
+    m_ReadbackDepth = depth;
+    if (!m_Initialized) return;
+    
+    ReleaseReadbackRing();
+    if (depth > 0 && !CreateReadbackRing()) {
+        Utils::Logger::Warn("CPU readback unavailable");
+        m_ReadbackDepth = 0;
+    }
+}
+
+bool FSR3FrameGenerator::CreateReadbackRing() {
+    if (!m_Readback.Initialize(&m_StagingDevice, GetStagingDesc(), m_ReadbackDepth)) {
         return false;
     }
     
-    // Push to frame buffer
-    m_FrameBuffer->PushFrame(m_Context, backBuffer);
-    backBuffer->Release();
+    Utils::Logger::Info("CPU readback ring created (%u copies)", m_ReadbackDepth);
+    return true;
+}
+
+StagingDesc FSR3FrameGenerator::GetStagingDesc() const {
+    StagingDesc desc;
+    desc.width = m_Width;
+    desc.height = m_Height;
+    desc.format = static_cast<uint32_t>(m_Format);
+    desc.bytesPerPixel = static_cast<uint32_t>(GetTextureBytes(1, 1, m_Format));
+    return desc;
+}
+
+bool FSR3FrameGenerator::PresentCpuFrame(const ConstImageView& frame) {
+    if (!m_Initialized || frame.width != m_Width || frame.height != m_Height) return false;
+    
+    // Created on first use; only CPU generation pays for the copies
+    if (!m_Upload.IsInitialized()) {
+        if (!m_Upload.Initialize(&m_StagingDevice, GetStagingDesc())) {
+            Utils::Logger::Error("Failed to create upload ring");
+            return false;
+        }
+        Utils::Logger::Info("CPU upload ring created (%u copies)", m_Upload.GetDepth());
+    }
+    
+    FrameHandle backBuffer = AcquireBackBuffer();
+    ImageView upload;
+    if (!backBuffer || !m_Upload.Begin(upload)) {
+        return false;
+    }
+    if (!CopyImage(upload, frame, m_Upload.GetDesc().bytesPerPixel)) {
+        m_Upload.Cancel();
+        return false;
+    }
+    
+    // The GPU copy runs behind the CPU, straight into the back buffer; the
+    // next upload goes to another copy
+    if (!m_Upload.Commit(backBuffer.Get())) {
+        return false;
+    }
     
+    PresentGeneratedFrame(backBuffer, backBuffer);
+    m_FramesGenerated++;
     return true;
 }
 
-bool FSR3FrameGenerator::GenerateInterpolatedFrame() {
+void FSR3FrameGenerator::ReleaseReadbackRing() {
+    m_HasReadbackFrame = false;
+    m_Readback.Shutdown();
+}
+
+bool FSR3FrameGenerator::GenerateInterpolatedFrame(ID3D11RenderTargetView* output) {
     // Get previous and current frames
-    auto* prevSRV = m_FrameBuffer->GetFrameSRV(1);
-    auto* currSRV = m_FrameBuffer->GetFrameSRV(0);
+    const GpuFrame* prev = m_FrameHistory->Get(1);
+    const GpuFrame* curr = m_FrameHistory->Get(0);
+    
+    if (!prev || !curr) return false;
     
-    if (!prevSRV || !currSRV) return false;
+    auto* prevSRV = prev->texture->srv;
+    auto* currSRV = curr->texture->srv;
     
     // Calculate motion vectors
     m_MotionCalc->Calculate(m_Context, prevSRV, currSRV);
@@ -361,8 +930,252 @@ bool FSR3FrameGenerator::GenerateInterpolatedFrame() {
     
     if (!motionSRV) return false;
     
-    // Interpolate with factor 0.5 (middle frame)
-    return Interpolate(prevSRV, currSRV, motionSRV, m_InterpolatedRTV, 0.5f);
+    // Advance the HUD stability sweep before anything reads the mask
+    if (m_HudLessMode && m_HudMask) {
+        m_HudMask->Update(m_Context, prevSRV, currSRV);
+    }
+    
+    // Sharpening is a separate pass over the finished frame, so render into
+    // the intermediate target only when it will run
+    // RCAS limits its lobe against a [0, 1] range, which would clip HDR
+    const bool sharpen = UseSharpenPass();
+    ID3D11RenderTargetView* target = sharpen ? m_UnsharpenedFrame->rtv : output;
+    
+    // Performance preset or memory budget: interpolate at half resolution,
+    // then upsample guided by the current real frame's edges
+    if (UseHalfResolution() && m_HalfResFrame) {
+        if (!Interpolate(prevSRV, currSRV, motionSRV, m_HalfResFrame->rtv, 0.5f,
+                m_Width / 2, m_Height / 2)) {
+            return false;
+        }
+        if (!Upsample(m_HalfResFrame->srv, currSRV, prevSRV, target)) {
+            return false;
+        }
+    } else {
+        // Interpolate with factor 0.5 (middle frame)
+        if (!Interpolate(prevSRV, currSRV, motionSRV, target, 0.5f, m_Width, m_Height)) {
+            return false;
+        }
+    }
+    
+    return sharpen ? Sharpen(m_UnsharpenedFrame->srv, output) : true;
+}
+
+bool FSR3FrameGenerator::Upsample(
+    ID3D11ShaderResourceView* lowRes,
+    ID3D11ShaderResourceView* guide,
+    ID3D11ShaderResourceView* framePrev,
+    ID3D11RenderTargetView* output
+) {
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = m_Context->Map(m_ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (SUCCEEDED(hr)) {
+        struct Constants {
+            float lowTexelSizeX;
+            float lowTexelSizeY;
+            float rangeSigma;
+            float hudLess;
+        };
+        
+        Constants* constants = static_cast<Constants*>(mapped.pData);
+        constants->lowTexelSizeX = 1.0f / (m_Width / 2);
+        constants->lowTexelSizeY = 1.0f / (m_Height / 2);
+        constants->rangeSigma = 24.0f / 255.0f;
+        constants->hudLess = UseHudMask() ? 1.0f : 0.0f;
+        
+        m_Context->Unmap(m_ConstantBuffer, 0);
+    }
+    
+    m_Context->OMSetRenderTargets(1, &output, nullptr);
+    
+    D3D11_VIEWPORT vp = {};
+    vp.Width = static_cast<float>(m_Width);
+    vp.Height = static_cast<float>(m_Height);
+    vp.MaxDepth = 1.0f;
+    m_Context->RSSetViewports(1, &vp);
+    
+    m_Context->VSSetShader(m_FullscreenVS, nullptr, 0);
+    m_Context->PSSetShader(m_UpsamplePS, nullptr, 0);
+    
+    ID3D11ShaderResourceView* hudSRV = UseHudMask() ? m_HudMask->GetStabilitySRV() : nullptr;
+    ID3D11ShaderResourceView* srvs[] = { lowRes, guide, framePrev, hudSRV };
+    m_Context->PSSetShaderResources(0, 4, srvs);
+    m_Context->PSSetSamplers(0, 1, &m_LinearSampler);
+    m_Context->PSSetConstantBuffers(0, 1, &m_ConstantBuffer);
+    
+    m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_Context->IASetInputLayout(nullptr);
+    m_Context->Draw(3, 0);
+    
+    ID3D11ShaderResourceView* nullSRVs[4] = { nullptr, nullptr, nullptr, nullptr };
+    m_Context->PSSetShaderResources(0, 4, nullSRVs);
+    
+    return true;
+}
+
+bool FSR3FrameGenerator::Sharpen(
+    ID3D11ShaderResourceView* source,
+    ID3D11RenderTargetView* output
+) {
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = m_Context->Map(m_ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (SUCCEEDED(hr)) {
+        struct Constants {
+            float sharpness;
+            float padding[3];
+        };
+        
+        Constants* constants = static_cast<Constants*>(mapped.pData);
+        constants->sharpness = m_Sharpness;
+        constants->padding[0] = constants->padding[1] = constants->padding[2] = 0.0f;
+        
+        m_Context->Unmap(m_ConstantBuffer, 0);
+    }
+    
+    m_Context->OMSetRenderTargets(1, &output, nullptr);
+    
+    D3D11_VIEWPORT vp = {};
+    vp.Width = static_cast<float>(m_Width);
+    vp.Height = static_cast<float>(m_Height);
+    vp.MaxDepth = 1.0f;
+    m_Context->RSSetViewports(1, &vp);
+    
+    m_Context->VSSetShader(m_FullscreenVS, nullptr, 0);
+    m_Context->PSSetShader(m_SharpenPS, nullptr, 0);
+    m_Context->PSSetShaderResources(0, 1, &source);
+    m_Context->PSSetConstantBuffers(0, 1, &m_ConstantBuffer);
+    
+    m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_Context->IASetInputLayout(nullptr);
+    m_Context->Draw(3, 0);
+    
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    m_Context->PSSetShaderResources(0, 1, &nullSRV);
+    
+    return true;
+}
+
+bool FSR3FrameGenerator::CreateHalfResTarget() {
+    if (m_HalfResFrame) return true;
+    if (m_Width < 2 || m_Height < 2) return false;
+    
+    m_HalfResFrame = m_TexturePool->Acquire(m_Width / 2, m_Height / 2, m_Format,
+        D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE);
+    if (!m_HalfResFrame) {
+        Utils::Logger::Error("Failed to create half-res frame");
+        return false;
+    }
+    
+    Utils::Logger::Info("Half-resolution interpolation target created (%dx%d)", m_Width / 2, m_Height / 2);
+    return true;
+}
+
+bool FSR3FrameGenerator::CreateHudMask() {
+    if (m_HudMask) return true;
+    
+    m_HudMask = std::make_unique<HudMaskCalculator>();
+    if (!m_HudMask->Initialize(m_Device, m_Width, m_Height)) {
+        m_HudMask.reset();
+        return false;
+    }
+    m_HudMask->Reset(m_Context);
+    m_MemoryBudget->Register(m_HudMask.get(), MemoryCategory::Buffers, m_HudMask->GetMemoryBytes());
+    return true;
+}
+
+bool FSR3FrameGenerator::CreateTileClassifier() {
+    if (m_TileClasses) return true;
+    
+    m_TileClasses = std::make_unique<TileClassCalculator>();
+    if (!m_TileClasses->Initialize(m_Device, m_Width, m_Height)) {
+        m_TileClasses.reset();
+        return false;
+    }
+    m_MemoryBudget->Register(m_TileClasses.get(), MemoryCategory::Buffers, m_TileClasses->GetMemoryBytes());
+    return true;
+}
+
+void FSR3FrameGenerator::SetMotionTiers(bool enabled) {
+    m_MotionTiers = enabled;
+    UpdateTileClassifier();
+}
+
+void FSR3FrameGenerator::SetStaticTileSkip(bool enabled) {
+    m_StaticTileSkip = enabled;
+    UpdateTileClassifier();
+}
+
+void FSR3FrameGenerator::SetTileReuse(bool enabled) {
+    m_TileReuse = enabled;
+    m_TileReuseTarget = nullptr;
+    UpdateTileClassifier();
+}
+
+void FSR3FrameGenerator::UpdateTileClassifier() {
+    m_TileKernelCounts = {};
+    if (!m_Initialized) return;
+    
+    // One classifier serves every tile setting; it goes when none needs it
+    const bool needed = m_MotionTiers || m_StaticTileSkip || m_TileReuse;
+    if (needed && !CreateTileClassifier()) {
+        m_MotionTiers = false;
+        m_StaticTileSkip = false;
+        m_TileReuse = false;
+    } else if (!needed && m_TileClasses) {
+        m_MemoryBudget->Unregister(m_TileClasses.get());
+        m_TileClasses.reset();
+    }
+}
+
+void FSR3FrameGenerator::SetHudLessMode(bool enabled) {
+    if (enabled == m_HudLessMode) return;
+    
+    m_HudLessMode = enabled;
+    
+    // Created lazily like the half-res target; dropping it forgets the history
+    if (m_Initialized) {
+        if (m_HudLessMode && !CreateHudMask()) {
+            m_HudLessMode = false;
+        } else if (!m_HudLessMode) {
+            m_MemoryBudget->Unregister(m_HudMask.get());
+            m_HudMask.reset();
+        }
+    }
+}
+
+void FSR3FrameGenerator::ReleaseHalfResTarget() {
+    if (m_HalfResFrame) { m_TexturePool->Release(m_HalfResFrame); m_HalfResFrame = nullptr; }
+    m_TileReuseTarget = nullptr;
+}
+
+void FSR3FrameGenerator::ApplyMemoryDegradation() {
+    const bool halfRes = m_MemoryBudget->IsDegraded(MemoryDegradation::HalfResolution);
+    if (halfRes == m_BudgetHalfRes) return;
+    
+    // A pooled target that comes back may hold another user's pixels
+    m_TileReuseTarget = nullptr;
+    
+    // The quarter-size target stands in for the full-size sharpen input,
+    // which saves three quarters of a frame; released textures are trimmed
+    // by the pool at the end of the frame
+    if (halfRes) {
+        if (!CreateHalfResTarget()) {
+            Utils::Logger::Warn("Half-resolution target unavailable, memory budget cannot degrade further");
+            return;
+        }
+        if (m_UnsharpenedFrame) { m_TexturePool->Release(m_UnsharpenedFrame); m_UnsharpenedFrame = nullptr; }
+        m_BudgetHalfRes = true;
+    } else {
+        m_BudgetHalfRes = false;
+        if (!m_HalfResolution) {
+            ReleaseHalfResTarget();
+        }
+        m_UnsharpenedFrame = m_TexturePool->Acquire(m_Width, m_Height, m_Format,
+            D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE);
+        if (!m_UnsharpenedFrame) {
+            Utils::Logger::Warn("Failed to restore unsharpened frame, sharpening disabled");
+        }
+    }
 }
 
 bool FSR3FrameGenerator::Interpolate(
@@ -370,7 +1183,9 @@ bool FSR3FrameGenerator::Interpolate(
     ID3D11ShaderResourceView* frameCurrent,
     ID3D11ShaderResourceView* motionVectors,
     ID3D11RenderTargetView* output,
-    float interpolationFactor
+    float interpolationFactor,
+    UINT outputWidth,
+    UINT outputHeight
 ) {
     // Update constant buffer
     D3D11_MAPPED_SUBRESOURCE mapped;
@@ -378,16 +1193,47 @@ bool FSR3FrameGenerator::Interpolate(
     if (SUCCEEDED(hr)) {
         struct Constants {
             float interpolationFactor;
-            float sharpness;
+            float occlusionStrength;
             float texelSizeX;
             float texelSizeY;
+            float motionTexelSizeX;
+            float motionTexelSizeY;
+            float linearBlend;
+            float hudLess;
+            float warpFilter;
+            float roiMode;
+            float roiFeather;
+            float roiRectCount;
+            float roiRadiusX;
+            float roiRadiusY;
+            float padding[2];
+            float roiRects[MAX_ROI_RECTS][4];
         };
+        static_assert(sizeof(Constants) == 128, "must match the constant buffer size");
         
         Constants* constants = static_cast<Constants*>(mapped.pData);
         constants->interpolationFactor = interpolationFactor;
-        constants->sharpness = m_Sharpness;
-        constants->texelSizeX = 1.0f / m_Width;
-        constants->texelSizeY = 1.0f / m_Height;
+        constants->occlusionStrength = m_OcclusionStrength;
+        constants->texelSizeX = 1.0f / outputWidth;
+        constants->texelSizeY = 1.0f / outputHeight;
+        constants->motionTexelSizeX = 1.0f / (std::max)(m_Width / 8, 1u);
+        constants->motionTexelSizeY = 1.0f / (std::max)(m_Height / 8, 1u);
+        constants->linearBlend = (m_LinearBlending && !IsHdrFormat()) ? 1.0f : 0.0f;
+        constants->hudLess = UseHudMask() ? 1.0f : 0.0f;
+        constants->warpFilter = static_cast<float>(m_WarpFilter);
+        constants->roiMode = static_cast<float>(m_Roi.mode);
+        constants->roiFeather = m_Roi.feather;
+        constants->roiRectCount = static_cast<float>((std::min)(m_Roi.rectCount, MAX_ROI_RECTS));
+        constants->roiRadiusX = m_Roi.radiusX;
+        constants->roiRadiusY = m_Roi.radiusY;
+        constants->padding[0] = constants->padding[1] = 0.0f;
+        for (uint32_t i = 0; i < MAX_ROI_RECTS; ++i) {
+            const RoiRect& rect = m_Roi.rects[i];
+            constants->roiRects[i][0] = rect.x;
+            constants->roiRects[i][1] = rect.y;
+            constants->roiRects[i][2] = rect.x + rect.width;
+            constants->roiRects[i][3] = rect.y + rect.height;
+        }
         
         m_Context->Unmap(m_ConstantBuffer, 0);
     }
@@ -396,45 +1242,107 @@ bool FSR3FrameGenerator::Interpolate(
     m_Context->OMSetRenderTargets(1, &output, nullptr);
     
     D3D11_VIEWPORT vp = {};
-    vp.Width = static_cast<float>(m_Width);
-    vp.Height = static_cast<float>(m_Height);
+    vp.Width = static_cast<float>(outputWidth);
+    vp.Height = static_cast<float>(outputHeight);
     vp.MaxDepth = 1.0f;
     m_Context->RSSetViewports(1, &vp);
     
-    // Set shaders
-    m_Context->VSSetShader(m_FullscreenVS, nullptr, 0);
-    m_Context->PSSetShader(m_InterpolationPS, nullptr, 0);
-    
     // Set resources
-    ID3D11ShaderResourceView* srvs[] = { framePrev, frameCurrent, motionVectors };
-    m_Context->PSSetShaderResources(0, 3, srvs);
+    ID3D11ShaderResourceView* hudSRV = UseHudMask() ? m_HudMask->GetStabilitySRV() : nullptr;
+    ID3D11ShaderResourceView* srvs[] = { framePrev, frameCurrent, motionVectors, hudSRV };
+    m_Context->PSSetShaderResources(0, 4, srvs);
     m_Context->PSSetSamplers(0, 1, &m_LinearSampler);
     m_Context->PSSetConstantBuffers(0, 1, &m_ConstantBuffer);
     
-    // Draw fullscreen triangle
     m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     m_Context->IASetInputLayout(nullptr);
-    m_Context->Draw(3, 0);
+    
+    if (UseTileClasses()) {
+        // Every tile is in exactly one list or reused, so the four draws and
+        // what they leave untouched cover the target
+        m_TileClasses->ReadCounts(m_Context, m_TileKernelCounts);
+        
+        // Reused tiles keep what the last generated frame drew into this
+        // target; the keys only hold if that was this target, with the same
+        // settings, and nothing has written it since
+        TileClassCalculator::ReuseParams reuse;
+        if (UseTileReuse()) {
+            reuse.hudStability = hudSRV;
+            reuse.settingsKey = GetTileSettingsKey(interpolationFactor, outputWidth, outputHeight);
+            reuse.targetValid = output == m_TileReuseTarget && reuse.settingsKey == m_TileReuseKey;
+            m_TileReuseKey = reuse.settingsKey;
+        }
+        m_TileReuseTarget = UseTileReuse() ? output : nullptr;
+        
+        m_TileClasses->Classify(m_Context, motionVectors, framePrev, frameCurrent,
+            outputWidth, outputHeight, m_StaticTileSkip, m_MotionTiers,
+            UseTileReuse() ? &reuse : nullptr);
+        
+        // Static tiles hold the same pixels in both frames, so the present
+        // shader's plain copy of t0 reproduces them without the warp
+        const struct {
+            TileClass cls;
+            ID3D11PixelShader* shader;
+        } kernels[] = {
+            { TileClass::Static, m_PresentPS },
+            { TileClass::Blend, m_BlendTilePS },
+            { TileClass::Warp, m_WarpTilePS },
+            { TileClass::Dynamic, m_InterpolationPS },
+        };
+        for (const auto& kernel : kernels) {
+            m_Context->PSSetShader(kernel.shader, nullptr, 0);
+            m_TileClasses->DrawTiles(m_Context, kernel.cls);
+        }
+    } else {
+        // Draw fullscreen triangle
+        m_Context->VSSetShader(m_FullscreenVS, nullptr, 0);
+        m_Context->PSSetShader(m_InterpolationPS, nullptr, 0);
+        m_Context->Draw(3, 0);
+    }
     
     // Cleanup
-    ID3D11ShaderResourceView* nullSRVs[3] = { nullptr, nullptr, nullptr };
-    m_Context->PSSetShaderResources(0, 3, nullSRVs);
+    ID3D11ShaderResourceView* nullSRVs[4] = { nullptr, nullptr, nullptr, nullptr };
+    m_Context->PSSetShaderResources(0, 4, nullSRVs);
     
     return true;
 }
 
-void FSR3FrameGenerator::PresentGeneratedFrame() {
-    // Present the interpolated frame to the swap chain
-    // This is done before the actual Present call
+uint64_t FSR3FrameGenerator::GetTileSettingsKey(float interpolationFactor, UINT outputWidth, UINT outputHeight) const {
+    uint64_t modes = ((m_LinearBlending && !IsHdrFormat()) ? 1u : 0u) |
+                     (UseHudMask() ? 2u : 0u) |
+                     (m_StaticTileSkip ? 4u : 0u) |
+                     (m_MotionTiers ? 8u : 0u) |
+                     (static_cast<uint32_t>(m_WarpFilter) << 8) |
+                     (static_cast<uint32_t>(m_Roi.mode) << 12);
+    uint64_t key = (static_cast<uint64_t>(std::bit_cast<uint32_t>(interpolationFactor)) << 32) | modes;
     
-    ID3D11Texture2D* backBuffer = nullptr;
-    HRESULT hr = m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer);
-    if (FAILED(hr)) return;
+    // Tile indices and UVs follow the output size
+    key ^= ((static_cast<uint64_t>(outputWidth) << 32) | outputHeight) * 0xC2B2AE3D27D4EB4Full;
     
-    // Copy interpolated frame to back buffer
-    m_Context->CopyResource(backBuffer, m_InterpolatedFrame);
+    // Weights and shape of the occlusion term and the ROI
+    const uint32_t rectCount = (std::min)(m_Roi.rectCount, MAX_ROI_RECTS);
+    float values[4 + 4 * MAX_ROI_RECTS] = {
+        m_OcclusionStrength, m_Roi.feather, m_Roi.radiusX, m_Roi.radiusY
+    };
+    for (uint32_t i = 0; i < rectCount; ++i) {
+        values[4 + i * 4 + 0] = m_Roi.rects[i].x;
+        values[4 + i * 4 + 1] = m_Roi.rects[i].y;
+        values[4 + i * 4 + 2] = m_Roi.rects[i].width;
+        values[4 + i * 4 + 3] = m_Roi.rects[i].height;
+    }
+    key ^= rectCount;
+    for (float value : values) {
+        key = (key ^ std::bit_cast<uint32_t>(value)) * 0x9E3779B97F4A7C15ull;
+    }
+    return key;
+}
+
+void FSR3FrameGenerator::PresentGeneratedFrame(const FrameHandle& backBuffer, const FrameHandle& output) {
+    // Present the interpolated frame to the swap chain
+    // This is done before the actual Present call
     
-    backBuffer->Release();
+    // Nothing to copy when the frame was rendered into the back buffer
+    if (!m_Transfer.Copy(backBuffer, output)) return;
     
     // Present the interpolated frame
     m_SwapChain->Present(0, 0);
@@ -447,11 +1355,10 @@ bool FSR3FrameGenerator::ShouldGenerateFrame() const {
 }
 
 void FSR3FrameGenerator::UpdateStats() {
-    if (m_FrameTimeHistory.empty()) return;
+    if (m_FrameTimeHistory.GetCount() == 0) return;
     
     // Calculate average frame time
-    float sum = std::accumulate(m_FrameTimeHistory.begin(), m_FrameTimeHistory.end(), 0.0f);
-    m_FrameTimeMs = sum / m_FrameTimeHistory.size();
+    m_FrameTimeMs = m_FrameTimeHistory.GetAverage();
     
     // Calculate FPS
     m_BaseFPS = 1000.0f / m_FrameTimeMs;
@@ -461,16 +1368,30 @@ void FSR3FrameGenerator::UpdateStats() {
 void FSR3FrameGenerator::SetQuality(QualityPreset preset) {
     m_Quality = preset;
     
-    // Adjust sharpness based on quality
+    // Performance interpolates at half resolution; the target is created
+    // lazily so other presets don't pay for it
+    m_HalfResolution = (preset == QualityPreset::Performance);
+    if (m_Initialized) {
+        if (m_HalfResolution && !CreateHalfResTarget()) {
+            m_HalfResolution = false;
+        } else if (!UseHalfResolution()) {
+            ReleaseHalfResTarget();
+        }
+    }
+    
+    // Adjust sharpness and warp filter based on quality (0 skips the sharpen pass)
     switch (preset) {
         case QualityPreset::Performance:
-            m_Sharpness = 0.3f;
+            m_Sharpness = 0.0f;
+            m_WarpFilter = WarpFilter::Bilinear;
             break;
         case QualityPreset::Balanced:
             m_Sharpness = 0.5f;
+            m_WarpFilter = WarpFilter::Bilinear;
             break;
         case QualityPreset::Quality:
             m_Sharpness = 0.7f;
+            m_WarpFilter = WarpFilter::CatmullRom;
             break;
     }
 }
@@ -486,14 +1407,24 @@ bool FSR3FrameGenerator::IsSupported() const {
 
 void FSR3FrameGenerator::Reset() {
     m_FirstFrame = true;
-    m_FrameTimeHistory.clear();
+    m_FrameTimeHistory.Clear();
+    
+    // Copies queued before the reset are of frames that no longer matter
+    m_HasReadbackFrame = false;
+    m_Readback.Discard();
+    
+    if (m_HudMask) {
+        m_HudMask->Reset(m_Context);
+    }
+    m_TileReuseTarget = nullptr;
     
-    if (m_FrameBuffer) {
-        m_FrameBuffer->Shutdown();
+    // The slots go back to the pool and same-sized ones come straight out again
+    if (m_FrameHistory) {
+        m_FrameHistory->Shutdown();
         
         DXGI_SWAP_CHAIN_DESC desc;
         m_SwapChain->GetDesc(&desc);
-        m_FrameBuffer->Initialize(m_Device, desc.BufferDesc.Width, desc.BufferDesc.Height, 
+        m_FrameHistory->Initialize(m_TexturePool, desc.BufferDesc.Width, desc.BufferDesc.Height, 
             desc.BufferDesc.Format);
     }
 }
@@ -10,8 +10,9 @@
 #define FIVEM_FRAMEGEN_FSR3_BACKEND_H
 
 #include "frame_generator.h"
+#include "frame_time_history.h"
+#include "sampling.h"
 #include <chrono>
-#include <deque>
 
 namespace FiveMFrameGen {
 namespace FrameGen {
@@ -35,34 +36,96 @@ public:
     ) override;
     
     void Shutdown() override;
+    void SetTexturePool(TexturePool* pool) override;
     void ProcessFrame() override;
     void SetQuality(QualityPreset preset) override;
     void SetSharpness(float sharpness) override;
+    void SetLinearBlending(bool enabled) override { m_LinearBlending = enabled; }
+    void SetHudLessMode(bool enabled) override;
+    void SetRegionOfInterest(const RoiConfig& roi) override { m_Roi = roi; }
+    void SetReadbackDepth(uint32_t depth) override;
+    
+    /**
+     * Override the warp filter chosen by the quality preset
+     */
+    void SetWarpFilter(WarpFilter filter) { m_WarpFilter = filter; }
+    
+    /**
+     * Pick the interpolation kernel per tile from its motion (on by default);
+     * off draws the full kernel over the whole frame
+     */
+    void SetMotionTiers(bool enabled);
+    
+    /**
+     * Copy tiles that neither move nor change between the two frames
+     * instead of interpolating them (on by default)
+     */
+    void SetStaticTileSkip(bool enabled);
+    
+    /**
+     * Keep last generated frame's pixels for tiles whose inputs, motion and
+     * settings hash the same as then (on by default). Without a sharpen or
+     * half-res pass this renders into the intermediate target, not the back
+     * buffer, so the pixels survive; the hit rate is in GetTileKernelCounts.
+     */
+    void SetTileReuse(bool enabled);
     
     float GetBaseFPS() const override { return m_BaseFPS; }
     float GetOutputFPS() const override { return m_OutputFPS; }
     float GetFrameTimeMs() const override { return m_FrameTimeMs; }
     uint64_t GetFramesGenerated() const override { return m_FramesGenerated; }
+    TileKernelCounts GetTileKernelCounts() const override { return m_TileKernelCounts; }
+    FrameTransfer::Counters GetFrameTraffic() const override { return m_Transfer.GetCounters(); }
+    ReadbackRing::Stats GetReadbackStats() const override {
+        return m_Readback.IsInitialized() ? m_Readback.GetStats() : ReadbackRing::Stats{};
+    }
+    
+    /**
+     * Most recent captured frame on the CPU, valid until the next
+     * ProcessFrame; nullptr when readback is off or nothing arrived
+     */
+    const ReadbackFrame* GetReadbackFrame() const { return m_HasReadbackFrame ? &m_ReadbackFrame : nullptr; }
+    
+    /**
+     * Upload a frame made on the CPU and present it as the generated frame
+     *
+     * @param frame Swap chain size and format
+     * @return False if it was skipped, e.g. because every upload copy is
+     *         still being read by the GPU
+     */
+    bool PresentCpuFrame(const ConstImageView& frame);
+    const UploadRing::Stats& GetUploadStats() const { return m_Upload.GetStats(); }
     
     Backend GetBackend() const override { return Backend::FSR3; }
     bool IsSupported() const override;
     void Reset() override;
 
 private:
+    /**
+     * Handle to the swap chain's back buffer, held for one present cycle
+     */
+    FrameHandle AcquireBackBuffer();
+    
+    /**
+     * Render target on the back buffer, or nullptr if the pipeline cannot
+     * render into it directly; the caller releases it
+     */
+    ID3D11RenderTargetView* CreateBackBufferTarget(const FrameHandle& backBuffer);
+    
     /**
      * Capture current back buffer
      */
-    bool CaptureBackBuffer();
+    bool CaptureBackBuffer(const FrameHandle& backBuffer);
     
     /**
-     * Generate interpolated frame
+     * Generate interpolated frame into output
      */
-    bool GenerateInterpolatedFrame();
+    bool GenerateInterpolatedFrame(ID3D11RenderTargetView* output);
     
     /**
-     * Present the generated frame
+     * Present the generated frame; no copy when output is the back buffer
      */
-    void PresentGeneratedFrame();
+    void PresentGeneratedFrame(const FrameHandle& backBuffer, const FrameHandle& output);
     
     /**
      * Update performance stats
@@ -82,40 +145,185 @@ private:
         ID3D11ShaderResourceView* frameCurrent,
         ID3D11ShaderResourceView* motionVectors,
         ID3D11RenderTargetView* output,
-        float interpolationFactor
+        float interpolationFactor,
+        UINT outputWidth,
+        UINT outputHeight
     );
+    
+    /**
+     * Hash of every setting the interpolation pass's output depends on,
+     * for the tile reuse keys
+     */
+    uint64_t GetTileSettingsKey(float interpolationFactor, UINT outputWidth, UINT outputHeight) const;
+    
+    /**
+     * Edge-guided 2x upsample of a half-resolution result to swap chain size
+     */
+    bool Upsample(
+        ID3D11ShaderResourceView* lowRes,
+        ID3D11ShaderResourceView* guide,
+        ID3D11ShaderResourceView* framePrev,
+        ID3D11RenderTargetView* output
+    );
+    
+    /**
+     * Contrast-adaptive sharpen pass over a generated frame
+     */
+    bool Sharpen(
+        ID3D11ShaderResourceView* source,
+        ID3D11RenderTargetView* output
+    );
+    
+    /**
+     * Sharpen pass after interpolation (renders into m_UnsharpenedFrame first)
+     */
+    bool UseSharpenPass() const { return m_Sharpness > 0.0f && !IsHdrFormat() && m_UnsharpenedFrame; }
+    
+    /**
+     * Create/release the half-resolution interpolation target
+     */
+    bool CreateHalfResTarget();
+    void ReleaseHalfResTarget();
+    
+    /**
+     * Interpolate at half resolution: Performance preset, or memory budget
+     */
+    bool UseHalfResolution() const { return m_HalfResolution || m_BudgetHalfRes; }
+    
+    /**
+     * Match the render targets to the memory budget's degradation level
+     */
+    void ApplyMemoryDegradation();
+    
+    /**
+     * Create/release the CPU readback ring for the captured frames
+     */
+    bool CreateReadbackRing();
+    void ReleaseReadbackRing();
+    
+    /**
+     * Describe a staging copy of the back buffer
+     */
+    StagingDesc GetStagingDesc() const;
+    
+    /**
+     * Create the HUD stability tracker (HUD-less mode)
+     */
+    bool CreateHudMask();
+    bool UseHudMask() const { return m_HudLessMode && m_HudMask; }
+    
+    /**
+     * Create the GPU tile classifier (motion tiers, static tile skip)
+     */
+    bool CreateTileClassifier();
+    bool UseTileClasses() const { return (m_MotionTiers || m_StaticTileSkip || m_TileReuse) && m_TileClasses; }
+    bool UseTileReuse() const { return m_TileReuse && m_TileClasses; }
+    
+    /**
+     * Tile reuse would interpolate straight into the generated frame, which
+     * then has to be m_InterpolatedFrame rather than the back buffer
+     */
+    bool ReusesTilesInOutput() const {
+        return UseTileReuse() && !UseSharpenPass() && !(UseHalfResolution() && m_HalfResFrame);
+    }
+    
+    /**
+     * Create or drop the classifier after a tile setting changed
+     */
+    void UpdateTileClassifier();
+    
+    /**
+     * Float swap chain (values may exceed 1.0, already linear)
+     */
+    bool IsHdrFormat() const {
+        return m_HasPixelFormat && m_PixelFormat == PixelFormat::RGBA16F;
+    }
 
 private:
+    // Frames every mode reads: current and previous
+    static constexpr size_t HISTORY_DEPTH = 2;
+    
     // D3D11 resources
     ID3D11Device* m_Device = nullptr;
     ID3D11DeviceContext* m_Context = nullptr;
     IDXGISwapChain* m_SwapChain = nullptr;
     
     // Frame buffers
-    std::unique_ptr<FrameBuffer> m_FrameBuffer;
+    std::unique_ptr<FrameHistory<HISTORY_DEPTH, GpuFrame>> m_FrameHistory;
     std::unique_ptr<MotionVectorCalculator> m_MotionCalc;
+    std::unique_ptr<HudMaskCalculator> m_HudMask;
+    std::unique_ptr<TileClassCalculator> m_TileClasses;
+    
+    // Render textures come from here (shared, or m_OwnedTexturePool)
+    TexturePool* m_TexturePool = nullptr;
+    std::unique_ptr<TexturePool> m_OwnedTexturePool;
+    
+    // The texture pool's budget; shaders and calculators register here too
+    MemoryBudget* m_MemoryBudget = nullptr;
+    
+    // Interpolation target
+    PooledTexture* m_InterpolatedFrame = nullptr;
+    
+    // Generated frame before sharpening (sharpen pass input)
+    PooledTexture* m_UnsharpenedFrame = nullptr;
     
-    // Interpolation resources
-    ID3D11Texture2D* m_InterpolatedFrame = nullptr;
-    ID3D11RenderTargetView* m_InterpolatedRTV = nullptr;
-    ID3D11ShaderResourceView* m_InterpolatedSRV = nullptr;
+    // Half-resolution interpolation target (Performance preset)
+    PooledTexture* m_HalfResFrame = nullptr;
+    
+    // CPU copies of the captured frames, a few frames late, and the way
+    // back for frames made on the CPU
+    D3D11StagingDevice m_StagingDevice;
+    ReadbackRing m_Readback;
+    UploadRing m_Upload;
+    ReadbackFrame m_ReadbackFrame;
+    bool m_HasReadbackFrame = false;
+    uint32_t m_ReadbackDepth = 0;       // 0 = off
+    
+    // Frame ownership on the capture/present path; stages that share a
+    // resource alias its handle instead of copying
+    FrameTable m_Frames;
+    FrameTransfer m_Transfer;
+    FrameHandle m_Output;               // m_InterpolatedFrame, used when the back buffer is no render target
+    uint64_t m_FrameBytes = 0;
     
     // Shaders
     ID3D11VertexShader* m_FullscreenVS = nullptr;
-    ID3D11PixelShader* m_InterpolationPS = nullptr;
+    ID3D11PixelShader* m_InterpolationPS = nullptr;     // Full kernel (Dynamic tiles)
+    ID3D11PixelShader* m_BlendTilePS = nullptr;
+    ID3D11PixelShader* m_WarpTilePS = nullptr;
     ID3D11PixelShader* m_PresentPS = nullptr;
+    ID3D11PixelShader* m_UpsamplePS = nullptr;
+    ID3D11PixelShader* m_SharpenPS = nullptr;
     ID3D11SamplerState* m_LinearSampler = nullptr;
     ID3D11Buffer* m_ConstantBuffer = nullptr;
     
     // Settings
     QualityPreset m_Quality = QualityPreset::Balanced;
     float m_Sharpness = 0.5f;
+    WarpFilter m_WarpFilter = WarpFilter::Bilinear;
+    float m_OcclusionStrength = 1.0f;   // 0 = plain lerp
+    bool m_HalfResolution = false;
+    bool m_BudgetHalfRes = false;       // Forced by the memory budget
+    bool m_LinearBlending = false;
+    bool m_HudLessMode = false;
+    bool m_MotionTiers = true;
+    bool m_StaticTileSkip = true;
+    bool m_TileReuse = true;
+    RoiConfig m_Roi;                    // Full-quality region (mode Off = everywhere)
     
     // State
     bool m_Initialized = false;
     bool m_FirstFrame = true;
     UINT m_Width = 0;
     UINT m_Height = 0;
+    DXGI_FORMAT m_Format = DXGI_FORMAT_UNKNOWN;
+    PixelFormat m_PixelFormat = PixelFormat::RGBA8;
+    bool m_HasPixelFormat = false;
+    
+    // Target the tile reuse keys were last stored for and their settings;
+    // null when its pixels can no longer be trusted
+    ID3D11RenderTargetView* m_TileReuseTarget = nullptr;
+    uint64_t m_TileReuseKey = 0;
     
     // Stats
     float m_BaseFPS = 0.0f;
@@ -123,14 +331,16 @@ private:
     float m_FrameTimeMs = 0.0f;
     uint64_t m_FramesGenerated = 0;
     uint64_t m_TotalFrames = 0;
+    TileKernelCounts m_TileKernelCounts;
     
     // Timing
     using Clock = std::chrono::high_resolution_clock;
     using TimePoint = std::chrono::time_point<Clock>;
     
     TimePoint m_LastFrameTime;
-    std::deque<float> m_FrameTimeHistory;
+    
     static constexpr size_t FRAME_HISTORY_SIZE = 60;
+    FrameTimeHistory<FRAME_HISTORY_SIZE> m_FrameTimeHistory;
     
     // Shader bytecode (embedded)
     static const unsigned char s_FullscreenVS[];
@@ -0,0 +1,360 @@
+/**
+ * Push-Pull Hole Filling Implementation
+ */
+
+#include "hole_fill.h"
+#include "sampling.h"
+#include "simd.h"
+#include "../utils/logger.h"
+
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace {
+
+/**
+ * True if any byte in the span is non-zero
+ */
+bool AnyNonZero(const uint8_t* data, uint32_t count) {
+    uint32_t i = 0;
+#ifdef FIVEM_FRAMEGEN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) return true;
+    }
+#endif
+    for (; i < count; ++i) {
+        if (data[i]) return true;
+    }
+    return false;
+}
+
+/**
+ * 2x bilinear upsample of one fine pixel from a coarse colour plane
+ */
+template <PixelFormat F>
+inline PixelStorage<F> UpsamplePixel(const PixelStorage<F>* color, uint32_t width, uint32_t height,
+                                     uint32_t x, uint32_t y) {
+    uint32_t x0, x1, wx, y0, y1, wy;
+    Upsample2xTaps(x, width, x0, x1, wx);
+    Upsample2xTaps(y, height, y0, y1, wy);
+
+    const PixelStorage<F>* row0 = color + static_cast<size_t>(y0) * width;
+    const PixelStorage<F>* row1 = color + static_cast<size_t>(y1) * width;
+
+    // Weights sum to 16
+    const PixelStorage<F> taps[4] = { row0[x0], row0[x1], row1[x0], row1[x1] };
+    const uint32_t weights[4] = { wx * wy, (4 - wx) * wy, wx * (4 - wy), (4 - wx) * (4 - wy) };
+    return PixelTraits<F>::WeightedAverage(taps, weights, 16);
+}
+
+} // namespace
+
+PushPullFiller::PushPullFiller() = default;
+
+PushPullFiller::~PushPullFiller() {
+    Shutdown();
+}
+
+bool PushPullFiller::Initialize(uint32_t width, uint32_t height, PixelFormat format) {
+    if (width == 0 || height == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_Format = format;
+
+    m_Levels.clear();
+    uint32_t w = width;
+    uint32_t h = height;
+    while (w > 1 || h > 1) {
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+
+        Level level;
+        level.width = w;
+        level.height = h;
+        level.color.assign(static_cast<size_t>(w) * h * BytesPerPixel(format), 0);
+        level.weight.assign(static_cast<size_t>(w) * h, 0);
+        m_Levels.push_back(std::move(level));
+    }
+
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_DirtyTiles.assign(static_cast<size_t>(m_TilesX) * m_TilesY, 0);
+    m_NeededTiles.assign(static_cast<size_t>(m_TilesX) * m_TilesY, 0);
+
+    m_Initialized = true;
+    Utils::Logger::Debug("Push-pull filler initialized (%ux%u, %zu levels)",
+        width, height, m_Levels.size());
+    return true;
+}
+
+void PushPullFiller::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Levels.clear();
+    m_DirtyTiles.clear();
+    m_NeededTiles.clear();
+    m_TilesX = 0;
+    m_TilesY = 0;
+
+    m_Initialized = false;
+}
+
+template <PixelFormat F>
+uint32_t PushPullFiller::Fill(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask) {
+    if (!m_Initialized || m_Levels.empty() || F != m_Format) return 0;
+    if (image.width != m_Width || image.height != m_Height ||
+        holeMask.width != m_Width || holeMask.height != m_Height) {
+        return 0;
+    }
+
+    uint32_t dirtyCount = ClassifyTiles(holeMask);
+    if (dirtyCount == 0) return 0;
+
+    PushBase<F>(image, holeMask);
+    for (size_t level = 0; level + 1 < m_Levels.size(); ++level) {
+        Push<F>(level);
+    }
+
+    for (size_t level = m_Levels.size() - 1; level-- > 0;) {
+        Pull<F>(level);
+    }
+    PullBase<F>(image, holeMask);
+
+    return dirtyCount;
+}
+
+uint32_t PushPullFiller::ClassifyTiles(const Plane<const uint8_t>& holeMask) {
+    uint32_t dirtyCount = 0;
+
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        uint32_t y0 = ty * TILE_SIZE;
+        uint32_t y1 = (std::min)(y0 + TILE_SIZE, m_Height);
+
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            uint32_t x0 = tx * TILE_SIZE;
+            uint32_t span = (std::min)(x0 + TILE_SIZE, m_Width) - x0;
+
+            bool dirty = false;
+            for (uint32_t y = y0; y < y1 && !dirty; ++y) {
+                dirty = AnyNonZero(holeMask.Row(y) + x0, span);
+            }
+
+            m_DirtyTiles[static_cast<size_t>(ty) * m_TilesX + tx] = dirty ? 1 : 0;
+            dirtyCount += dirty ? 1 : 0;
+        }
+    }
+
+    if (dirtyCount == 0) return 0;
+
+    // Dirty tiles plus a one-tile apron feed the pyramid, so every hole
+    // boundary sees its valid neighbours
+    std::fill(m_NeededTiles.begin(), m_NeededTiles.end(), static_cast<uint8_t>(0));
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            if (!m_DirtyTiles[static_cast<size_t>(ty) * m_TilesX + tx]) continue;
+
+            uint32_t nx0 = tx > 0 ? tx - 1 : 0;
+            uint32_t ny0 = ty > 0 ? ty - 1 : 0;
+            uint32_t nx1 = (std::min)(tx + 1, m_TilesX - 1);
+            uint32_t ny1 = (std::min)(ty + 1, m_TilesY - 1);
+            for (uint32_t ny = ny0; ny <= ny1; ++ny) {
+                std::memset(&m_NeededTiles[static_cast<size_t>(ny) * m_TilesX + nx0], 1, nx1 - nx0 + 1);
+            }
+        }
+    }
+
+    return dirtyCount;
+}
+
+template <PixelFormat F>
+void PushPullFiller::PushBase(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask) {
+    using Storage = PixelStorage<F>;
+    Level& dst = m_Levels[0];
+    constexpr uint32_t HALF_TILE = TILE_SIZE / 2;
+
+    // Anything outside the needed tiles stays at weight 0 and is ignored upstream
+    std::fill(dst.weight.begin(), dst.weight.end(), static_cast<uint8_t>(0));
+
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            size_t tileIndex = static_cast<size_t>(ty) * m_TilesX + tx;
+            if (!m_NeededTiles[tileIndex]) continue;
+
+            const bool dirty = m_DirtyTiles[tileIndex] != 0;
+            uint32_t X0 = tx * HALF_TILE;
+            uint32_t Y0 = ty * HALF_TILE;
+            uint32_t X1 = (std::min)(X0 + HALF_TILE, dst.width);
+            uint32_t Y1 = (std::min)(Y0 + HALF_TILE, dst.height);
+
+            for (uint32_t Y = Y0; Y < Y1; ++Y) {
+                uint32_t cy0 = Y * 2;
+                uint32_t cy1 = (std::min)(cy0 + 1, m_Height - 1);
+                const Storage* row0 = image.Row(cy0);
+                const Storage* row1 = image.Row(cy1);
+                Storage* outColor = dst.Color<F>() + static_cast<size_t>(Y) * dst.width;
+                uint8_t* outWeight = dst.weight.data() + static_cast<size_t>(Y) * dst.width;
+
+                uint32_t X = X0;
+#ifdef FIVEM_FRAMEGEN_SSE2
+                if constexpr (PixelTraits<F>::PACKED_8BIT) {
+                    if (!dirty) {
+                        // Hole-free tile: plain 2x2 box, four output pixels per iteration
+                        for (; X + 4 <= X1 && X * 2 + 8 <= m_Width; X += 4) {
+                            __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + X * 2));
+                            __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + X * 2 + 4));
+                            __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + X * 2));
+                            __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + X * 2 + 4));
+                            __m128 v0 = _mm_castsi128_ps(_mm_avg_epu8(a0, b0));
+                            __m128 v1 = _mm_castsi128_ps(_mm_avg_epu8(a1, b1));
+                            __m128i even = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+                            __m128i odd = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(outColor + X), _mm_avg_epu8(even, odd));
+                            std::memset(outWeight + X, 255, 4);
+                        }
+                    }
+                }
+#endif
+                const uint8_t* mask0 = holeMask.Row(cy0);
+                const uint8_t* mask1 = holeMask.Row(cy1);
+
+                for (; X < X1; ++X) {
+                    uint32_t cx0 = X * 2;
+                    uint32_t cx1 = (std::min)(cx0 + 1, m_Width - 1);
+                    const Storage taps[4] = { row0[cx0], row0[cx1], row1[cx0], row1[cx1] };
+                    const uint32_t valid[4] = {
+                        mask0[cx0] ? 0u : 1u, mask0[cx1] ? 0u : 1u,
+                        mask1[cx0] ? 0u : 1u, mask1[cx1] ? 0u : 1u
+                    };
+                    uint32_t count = valid[0] + valid[1] + valid[2] + valid[3];
+
+                    if (count) {
+                        outColor[X] = PixelTraits<F>::WeightedAverage(taps, valid, count);
+                        outWeight[X] = 255;
+                    } else {
+                        outColor[X] = 0;
+                        outWeight[X] = 0;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <PixelFormat F>
+void PushPullFiller::Push(size_t level) {
+    const Level& src = m_Levels[level];
+    Level& dst = m_Levels[level + 1];
+    const PixelStorage<F>* srcColor = src.Color<F>();
+    PixelStorage<F>* dstColor = dst.Color<F>();
+
+    for (uint32_t Y = 0; Y < dst.height; ++Y) {
+        uint32_t sy0 = Y * 2;
+        uint32_t sy1 = (std::min)(sy0 + 1, src.height - 1);
+
+        for (uint32_t X = 0; X < dst.width; ++X) {
+            uint32_t sx0 = X * 2;
+            uint32_t sx1 = (std::min)(sx0 + 1, src.width - 1);
+            size_t idx[4] = {
+                static_cast<size_t>(sy0) * src.width + sx0,
+                static_cast<size_t>(sy0) * src.width + sx1,
+                static_cast<size_t>(sy1) * src.width + sx0,
+                static_cast<size_t>(sy1) * src.width + sx1
+            };
+
+            PixelStorage<F> taps[4];
+            uint32_t weights[4];
+            uint32_t sumW = 0;
+            for (int i = 0; i < 4; ++i) {
+                taps[i] = srcColor[idx[i]];
+                weights[i] = src.weight[idx[i]];
+                sumW += weights[i];
+            }
+
+            size_t out = static_cast<size_t>(Y) * dst.width + X;
+            if (sumW) {
+                dstColor[out] = PixelTraits<F>::WeightedAverage(taps, weights, sumW);
+                dst.weight[out] = static_cast<uint8_t>((std::min)(sumW, 255u));
+            } else {
+                dstColor[out] = 0;
+                dst.weight[out] = 0;
+            }
+        }
+    }
+}
+
+template <PixelFormat F>
+void PushPullFiller::Pull(size_t level) {
+    Level& dst = m_Levels[level];
+    const Level& src = m_Levels[level + 1];
+
+    auto pullRows = [&](uint32_t X0, uint32_t X1, uint32_t Y0, uint32_t Y1) {
+        for (uint32_t Y = Y0; Y < Y1; ++Y) {
+            PixelStorage<F>* color = dst.Color<F>() + static_cast<size_t>(Y) * dst.width;
+            uint8_t* weight = dst.weight.data() + static_cast<size_t>(Y) * dst.width;
+
+            for (uint32_t X = X0; X < X1; ++X) {
+                uint32_t w = weight[X];
+                if (w == 255) continue;
+
+                PixelStorage<F> up = UpsamplePixel<F>(src.Color<F>(), src.width, src.height, X, Y);
+                color[X] = PixelTraits<F>::Lerp(up, color[X], w + (w >> 7));
+                weight[X] = 255;
+            }
+        }
+    };
+
+    if (level > 0) {
+        pullRows(0, dst.width, 0, dst.height);
+        return;
+    }
+
+    // Half resolution is only read back around dirty tiles
+    constexpr uint32_t HALF_TILE = TILE_SIZE / 2;
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            if (!m_NeededTiles[static_cast<size_t>(ty) * m_TilesX + tx]) continue;
+
+            pullRows(tx * HALF_TILE, (std::min)((tx + 1) * HALF_TILE, dst.width),
+                     ty * HALF_TILE, (std::min)((ty + 1) * HALF_TILE, dst.height));
+        }
+    }
+}
+
+template <PixelFormat F>
+void PushPullFiller::PullBase(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask) {
+    const Level& src = m_Levels[0];
+
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            if (!m_DirtyTiles[static_cast<size_t>(ty) * m_TilesX + tx]) continue;
+
+            uint32_t x0 = tx * TILE_SIZE;
+            uint32_t y0 = ty * TILE_SIZE;
+            uint32_t x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+            uint32_t y1 = (std::min)(y0 + TILE_SIZE, m_Height);
+
+            for (uint32_t y = y0; y < y1; ++y) {
+                const uint8_t* mask = holeMask.Row(y);
+                PixelStorage<F>* out = image.Row(y);
+                for (uint32_t x = x0; x < x1; ++x) {
+                    if (mask[x]) {
+                        out[x] = UpsamplePixel<F>(src.Color<F>(), src.width, src.height, x, y);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#define INSTANTIATE_FILL(format) \
+    template uint32_t PushPullFiller::Fill<format>(const FormatPlane<format>&, const Plane<const uint8_t>&);
+FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(INSTANTIATE_FILL)
+#undef INSTANTIATE_FILL
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
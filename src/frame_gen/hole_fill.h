@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * Push-Pull Hole Filling
+ *
+ * Fills disoccluded pixels in a generated frame from a weighted mip pyramid.
+ * Runs in O(pixels) and only touches the full-resolution image inside tiles
+ * that actually contain holes.
+ */
+
+#ifndef FIVEM_FRAMEGEN_HOLE_FILL_H
+#define FIVEM_FRAMEGEN_HOLE_FILL_H
+
+#include "pixel_format.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Push-pull (pyramid) hole filler
+ *
+ * Push: build coarser levels by weight-normalised 2x2 averaging, where a
+ * hole has weight 0. Pull: walk back down, replacing missing weight at each
+ * level with the bilinear upsample of the level above it.
+ */
+class PushPullFiller {
+public:
+    // Hole detection granularity at full resolution
+    static constexpr uint32_t TILE_SIZE = 16;
+
+    PushPullFiller();
+    ~PushPullFiller();
+
+    /**
+     * Allocate the pyramid for the given frame size and format
+     */
+    bool Initialize(uint32_t width, uint32_t height, PixelFormat format = PixelFormat::RGBA8);
+    void Shutdown();
+
+    /**
+     * Fill hole pixels in place
+     *
+     * @param image Frame to repair, in the format given to Initialize
+     * @param holeMask Non-zero where the pixel is invalid
+     * @return Number of tiles that contained holes (0 = nothing was done)
+     */
+    template <PixelFormat F>
+    uint32_t Fill(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask);
+
+private:
+    struct Level {
+        std::vector<uint8_t> color;     // Normalised (not premultiplied) pixels in the frame format
+        std::vector<uint8_t> weight;    // Confidence 0-255
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        template <PixelFormat F>
+        PixelStorage<F>* Color() { return reinterpret_cast<PixelStorage<F>*>(color.data()); }
+
+        template <PixelFormat F>
+        const PixelStorage<F>* Color() const { return reinterpret_cast<const PixelStorage<F>*>(color.data()); }
+    };
+
+    /**
+     * Flag tiles that contain at least one hole, return the count
+     */
+    uint32_t ClassifyTiles(const Plane<const uint8_t>& holeMask);
+
+    /**
+     * Full resolution -> level 1, only for tiles near holes
+     */
+    template <PixelFormat F>
+    void PushBase(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask);
+
+    /**
+     * Level -> level + 1
+     */
+    template <PixelFormat F>
+    void Push(size_t level);
+
+    /**
+     * Level + 1 -> level, resolving partial weights
+     */
+    template <PixelFormat F>
+    void Pull(size_t level);
+
+    /**
+     * Level 1 -> full resolution, hole pixels in dirty tiles only
+     */
+    template <PixelFormat F>
+    void PullBase(const FormatPlane<F>& image, const Plane<const uint8_t>& holeMask);
+
+    // Levels[0] is half resolution
+    std::vector<Level> m_Levels;
+
+    std::vector<uint8_t> m_DirtyTiles;      // Tile has holes
+    std::vector<uint8_t> m_NeededTiles;     // Tile feeds the pyramid (dirty + 1 tile apron)
+    uint32_t m_TilesX = 0;
+    uint32_t m_TilesY = 0;
+
+    bool m_Initialized = false;
+    PixelFormat m_Format = PixelFormat::RGBA8;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_HOLE_FILL_H
@@ -0,0 +1,126 @@
+/**
+ * HUD Mask Tracking Implementation
+ */
+
+#include "hud_mask.h"
+
+#include <cstdlib>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+HudMaskTracker::HudMaskTracker() = default;
+
+HudMaskTracker::~HudMaskTracker() {
+    Shutdown();
+}
+
+bool HudMaskTracker::Initialize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_BandTileRows = (m_TilesY + SWEEP_FRAMES - 1) / SWEEP_FRAMES;
+
+    m_Stability.assign(static_cast<size_t>(width) * height, 0);
+    m_Mask.assign(static_cast<size_t>(width) * height, 0);
+    m_Coverage.assign(static_cast<size_t>(m_TilesX) * m_TilesY, 0);
+    m_MaskedTiles = 0;
+    m_NextTileRow = 0;
+
+    m_Initialized = true;
+    return true;
+}
+
+void HudMaskTracker::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Stability.clear();
+    m_Stability.shrink_to_fit();
+    m_Mask.clear();
+    m_Mask.shrink_to_fit();
+    m_Coverage.clear();
+    m_MaskedTiles = 0;
+
+    m_Initialized = false;
+}
+
+void HudMaskTracker::Reset() {
+    if (!m_Initialized) return;
+
+    std::fill(m_Stability.begin(), m_Stability.end(), static_cast<uint8_t>(0));
+    std::fill(m_Mask.begin(), m_Mask.end(), static_cast<uint8_t>(0));
+    std::fill(m_Coverage.begin(), m_Coverage.end(), static_cast<uint16_t>(0));
+    m_MaskedTiles = 0;
+    m_NextTileRow = 0;
+}
+
+template <PixelFormat F>
+void HudMaskTracker::Update(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent) {
+    if (!m_Initialized) return;
+    if (framePrev.width != m_Width || framePrev.height != m_Height ||
+        frameCurrent.width != m_Width || frameCurrent.height != m_Height) {
+        return;
+    }
+
+    const uint32_t bandBegin = m_NextTileRow;
+    const uint32_t bandEnd = (std::min)(bandBegin + m_BandTileRows, m_TilesY);
+    m_NextTileRow = bandEnd < m_TilesY ? bandEnd : 0;
+
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        const bool inBand = ty >= bandBegin && ty < bandEnd;
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            // Outside the band only tiles that are currently masked need a look
+            if (inBand || GetTileCoverage(tx, ty) > 0) {
+                UpdateTile<F>(framePrev, frameCurrent, tx, ty);
+            }
+        }
+    }
+}
+
+template <PixelFormat F>
+void HudMaskTracker::UpdateTile(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent,
+                                uint32_t tx, uint32_t ty) {
+    using Traits = PixelTraits<F>;
+
+    const uint32_t x0 = tx * TILE_SIZE;
+    const uint32_t y0 = ty * TILE_SIZE;
+    const uint32_t x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+    const uint32_t y1 = (std::min)(y0 + TILE_SIZE, m_Height);
+
+    uint32_t covered = 0;
+    for (uint32_t y = y0; y < y1; ++y) {
+        const PixelStorage<F>* prev = framePrev.Row(y);
+        const PixelStorage<F>* curr = frameCurrent.Row(y);
+        uint8_t* stability = m_Stability.data() + static_cast<size_t>(y) * m_Width;
+        uint8_t* mask = m_Mask.data() + static_cast<size_t>(y) * m_Width;
+
+        for (uint32_t x = x0; x < x1; ++x) {
+            int diff = static_cast<int>(Traits::Luma(prev[x])) - static_cast<int>(Traits::Luma(curr[x]));
+            uint8_t s = stability[x];
+            if (static_cast<uint32_t>(std::abs(diff)) <= LUMA_TOLERANCE) {
+                s = s < 255 ? static_cast<uint8_t>(s + 1) : s;
+            } else {
+                s = 0;
+            }
+            stability[x] = s;
+            mask[x] = s >= STABLE_UPDATES ? 1 : 0;
+            covered += mask[x];
+        }
+    }
+
+    uint16_t& coverage = m_Coverage[static_cast<size_t>(ty) * m_TilesX + tx];
+    m_MaskedTiles += (covered > 0) - (coverage > 0);
+    coverage = static_cast<uint16_t>(covered);
+}
+
+#define INSTANTIATE_HUD_MASK(format) \
+    template void HudMaskTracker::Update<format>( \
+        const ConstFormatPlane<format>&, const ConstFormatPlane<format>&);
+FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(INSTANTIATE_HUD_MASK)
+#undef INSTANTIATE_HUD_MASK
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
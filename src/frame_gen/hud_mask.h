@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * HUD Mask Tracking
+ *
+ * Finds screen-space overlays (minimap, health bars, chat, scoreboard) by
+ * their temporal stability so the interpolator can copy them from the
+ * current frame instead of warping them along with the scene.
+ */
+
+#ifndef FIVEM_FRAMEGEN_HUD_MASK_H
+#define FIVEM_FRAMEGEN_HUD_MASK_H
+
+#include "pixel_format.h"
+#include "tile_classifier.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Persistent per-pixel HUD mask built from frame-to-frame stability
+ *
+ * Each pixel keeps a count of consecutive updates in which it did not
+ * change; once the count reaches STABLE_UPDATES the pixel is masked, and
+ * any change clears it immediately. The frame is swept in bands of tile
+ * rows so a full pass takes SWEEP_FRAMES updates, while tiles that already
+ * hold masked pixels are re-checked on every update so a mask never
+ * outlives the content it covers.
+ */
+class HudMaskTracker {
+public:
+    // Same grid as the tile classifier so coverage maps onto its tiles
+    static constexpr uint32_t TILE_SIZE = TileClassifier::TILE_SIZE;
+
+    // Updates needed to sweep the whole frame once
+    static constexpr uint32_t SWEEP_FRAMES = 8;
+
+    // Consecutive unchanged updates before a pixel counts as HUD
+    static constexpr uint8_t STABLE_UPDATES = 4;
+
+    // Luma difference (0-255 scale) still considered unchanged
+    static constexpr uint32_t LUMA_TOLERANCE = 2;
+
+    HudMaskTracker();
+    ~HudMaskTracker();
+
+    bool Initialize(uint32_t width, uint32_t height);
+    void Shutdown();
+
+    /**
+     * Forget all stability history (scene change, resize)
+     */
+    void Reset();
+
+    /**
+     * Advance the sweep by one band and re-check masked tiles
+     *
+     * @param framePrev Previous real frame
+     * @param frameCurrent Current real frame
+     */
+    template <PixelFormat F>
+    void Update(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent);
+
+    /**
+     * Per-pixel mask (non-zero = HUD), same size as the frame
+     */
+    Plane<const uint8_t> GetMask() const {
+        return { m_Mask.data(), m_Width, m_Height, m_Width };
+    }
+
+    /**
+     * Number of masked pixels in a tile
+     */
+    uint32_t GetTileCoverage(uint32_t tx, uint32_t ty) const {
+        return m_Coverage[static_cast<size_t>(ty) * m_TilesX + tx];
+    }
+
+    /**
+     * Tiles holding at least one masked pixel
+     */
+    uint32_t GetMaskedTileCount() const { return m_MaskedTiles; }
+
+    uint32_t GetTilesX() const { return m_TilesX; }
+    uint32_t GetTilesY() const { return m_TilesY; }
+
+private:
+    /**
+     * Update stability counters and mask for one tile
+     */
+    template <PixelFormat F>
+    void UpdateTile(const ConstFormatPlane<F>& framePrev, const ConstFormatPlane<F>& frameCurrent,
+                    uint32_t tx, uint32_t ty);
+
+    // Consecutive unchanged updates per pixel (saturating)
+    std::vector<uint8_t> m_Stability;
+    std::vector<uint8_t> m_Mask;
+    std::vector<uint16_t> m_Coverage;
+    uint32_t m_MaskedTiles = 0;
+
+    // First tile row of the next sweep band
+    uint32_t m_NextTileRow = 0;
+    uint32_t m_BandTileRows = 1;
+
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    uint32_t m_TilesX = 0;
+    uint32_t m_TilesY = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_HUD_MASK_H
@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * CPU Image Types
+ *
+ * Lightweight, non-owning views over CPU-side frame planes and block motion
+ * fields used by the software interpolation path. Platform-neutral.
+ */
+
+#ifndef FIVEM_FRAMEGEN_IMAGE_TYPES_H
+#define FIVEM_FRAMEGEN_IMAGE_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Motion vector in pixels (previous frame -> current frame)
+ */
+struct MotionVector {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+/**
+ * Non-owning 2D plane view
+ *
+ * Pitch is expressed in elements, not bytes.
+ */
+template <typename T>
+struct Plane {
+    T* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t pitch = 0;
+
+    T* Row(uint32_t y) const { return data + static_cast<size_t>(y) * pitch; }
+    T& At(uint32_t x, uint32_t y) const { return Row(y)[x]; }
+
+    bool IsValid() const { return data && width && height && pitch >= width; }
+
+    /**
+     * Implicit conversion to a read-only view
+     */
+    template <typename U = T, std::enable_if_t<!std::is_const_v<U>, int> = 0>
+    operator Plane<const U>() const { return { data, width, height, pitch }; }
+};
+
+// Packed 8-bit RGBA (R in the low byte, matching DXGI_FORMAT_R8G8B8A8_UNORM)
+using ColorPlane = Plane<uint32_t>;
+using ConstColorPlane = Plane<const uint32_t>;
+
+/**
+ * Plane view whose element type is only known at run time
+ *
+ * Used at the engine boundary where the pixel format is picked at
+ * initialization. Pitch is expressed in bytes.
+ */
+template <typename V>
+struct BasicImageView {
+    V* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t pitchBytes = 0;
+
+    BasicImageView() = default;
+    BasicImageView(V* data, uint32_t width, uint32_t height, size_t pitchBytes)
+        : data(data), width(width), height(height), pitchBytes(pitchBytes) {}
+
+    /**
+     * Wrap a typed plane
+     */
+    template <typename T, std::enable_if_t<std::is_convertible_v<T*, V*>, int> = 0>
+    BasicImageView(const Plane<T>& plane)
+        : data(plane.data), width(plane.width), height(plane.height), pitchBytes(plane.pitch * sizeof(T)) {}
+
+    /**
+     * Implicit conversion to a read-only view
+     */
+    template <typename U = V, std::enable_if_t<!std::is_const_v<U>, int> = 0>
+    operator BasicImageView<const U>() const { return { data, width, height, pitchBytes }; }
+
+    /**
+     * Reinterpret as a typed plane; T must match the format's storage
+     */
+    template <typename T>
+    Plane<T> As() const { return { static_cast<T*>(data), width, height, pitchBytes / sizeof(T) }; }
+
+    bool IsValid() const { return data && width && height && pitchBytes; }
+};
+
+using ImageView = BasicImageView<void>;
+using ConstImageView = BasicImageView<const void>;
+
+/**
+ * Block motion field as produced by MotionVectorCalculator (one vector per block)
+ */
+struct MotionField {
+    const MotionVector* vectors = nullptr;
+    uint32_t blocksX = 0;
+    uint32_t blocksY = 0;
+    uint32_t blockSize = 8;
+
+    bool IsValid() const { return vectors && blocksX && blocksY && blockSize; }
+
+    /**
+     * Get a block vector with edge clamping
+     */
+    const MotionVector& Block(int bx, int by) const {
+        bx = std::clamp(bx, 0, static_cast<int>(blocksX) - 1);
+        by = std::clamp(by, 0, static_cast<int>(blocksY) - 1);
+        return vectors[static_cast<size_t>(by) * blocksX + bx];
+    }
+
+    /**
+     * Bilinearly sample the field at a pixel position (block centres are the taps)
+     */
+    MotionVector Sample(float px, float py) const {
+        float fx = px / blockSize - 0.5f;
+        float fy = py / blockSize - 0.5f;
+        int bx = static_cast<int>(fx < 0.0f ? fx - 1.0f : fx);
+        int by = static_cast<int>(fy < 0.0f ? fy - 1.0f : fy);
+        float ax = fx - bx;
+        float ay = fy - by;
+
+        const MotionVector& m00 = Block(bx, by);
+        const MotionVector& m10 = Block(bx + 1, by);
+        const MotionVector& m01 = Block(bx, by + 1);
+        const MotionVector& m11 = Block(bx + 1, by + 1);
+
+        MotionVector result;
+        result.x = (m00.x + (m10.x - m00.x) * ax) * (1.0f - ay) + (m01.x + (m11.x - m01.x) * ax) * ay;
+        result.y = (m00.y + (m10.y - m00.y) * ax) * (1.0f - ay) + (m01.y + (m11.y - m01.y) * ax) * ay;
+        return result;
+    }
+};
+
+/**
+ * Packed RGBA8 helpers
+ */
+namespace Pixel {
+
+inline uint32_t R(uint32_t p) { return p & 0xFF; }
+inline uint32_t G(uint32_t p) { return (p >> 8) & 0xFF; }
+inline uint32_t B(uint32_t p) { return (p >> 16) & 0xFF; }
+inline uint32_t A(uint32_t p) { return p >> 24; }
+
+inline uint32_t Pack(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+/**
+ * Rec.601 luma in 0-255 (same weights as the optical flow shader, 8-bit fixed point)
+ */
+inline uint32_t Luma(uint32_t p) {
+    return (R(p) * 77 + G(p) * 150 + B(p) * 29) >> 8;
+}
+
+} // namespace Pixel
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_IMAGE_TYPES_H
@@ -0,0 +1,94 @@
+/**
+ * Memory Budget Implementation
+ */
+
+#include "memory_budget.h"
+#include "../utils/logger.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace {
+
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+} // namespace
+
+MemoryBudget::MemoryBudget() = default;
+
+void MemoryBudget::Register(const void* owner, MemoryCategory category, uint64_t bytes) {
+    if (!owner) return;
+
+    Unregister(owner);
+    m_Entries.push_back({ owner, category, bytes });
+    m_CategoryUsage[static_cast<size_t>(category)] += bytes;
+    m_Usage += bytes;
+    if (m_Usage > m_Peak) {
+        m_Peak = m_Usage;
+    }
+}
+
+void MemoryBudget::Unregister(const void* owner) {
+    for (size_t i = 0; i < m_Entries.size(); ++i) {
+        if (m_Entries[i].owner == owner) {
+            m_CategoryUsage[static_cast<size_t>(m_Entries[i].category)] -= m_Entries[i].bytes;
+            m_Usage -= m_Entries[i].bytes;
+
+            m_Entries[i] = m_Entries.back();
+            m_Entries.pop_back();
+            return;
+        }
+    }
+}
+
+bool MemoryBudget::Update() {
+    const size_t level = static_cast<size_t>(m_Level);
+
+    // No limit: nothing to degrade for
+    if (m_Limit == 0) {
+        if (m_Level == MemoryDegradation::None) return false;
+
+        m_Level = MemoryDegradation::None;
+        m_MeasurePending = false;
+        Utils::Logger::Info("Memory budget removed, restoring full quality");
+        return true;
+    }
+
+    // The previous step has been applied by now; see what it bought
+    if (m_MeasurePending) {
+        m_StepSavings[level] = m_UsageBeforeStep > m_Usage ? m_UsageBeforeStep - m_Usage : 0;
+        m_MeasurePending = false;
+    }
+
+    if (m_Usage > m_Limit) {
+        if (level + 1 >= LEVEL_COUNT) return false;
+
+        m_UsageBeforeStep = m_Usage;
+        m_MeasurePending = true;
+        m_Level = static_cast<MemoryDegradation>(level + 1);
+        Utils::Logger::Warn("Memory budget exceeded (%.1f / %.1f MB), degrading: %s",
+            m_Usage / BYTES_PER_MB, m_Limit / BYTES_PER_MB, GetDegradationName(m_Level));
+        return true;
+    }
+
+    if (level > 0 && m_Usage + m_StepSavings[level] <= static_cast<uint64_t>(m_Limit * RELAX_FRACTION)) {
+        m_Level = static_cast<MemoryDegradation>(level - 1);
+        Utils::Logger::Info("Memory budget has headroom (%.1f / %.1f MB), restoring: %s",
+            m_Usage / BYTES_PER_MB, m_Limit / BYTES_PER_MB, GetDegradationName(m_Level));
+        return true;
+    }
+
+    return false;
+}
+
+const char* MemoryBudget::GetDegradationName(MemoryDegradation level) {
+    switch (level) {
+        case MemoryDegradation::None: return "None";
+        case MemoryDegradation::TrimIdle: return "Trim Idle";
+        case MemoryDegradation::HalfResolution: return "Half Resolution";
+        default: return "Unknown";
+    }
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * Memory Budget
+ *
+ * Tracks the memory held by the frame generation pipeline and steps
+ * through degradation levels when it exceeds a configured limit. Every
+ * allocation registers its size under an owner key, so the budget sees
+ * textures, buffers and shader objects alike without knowing the API
+ * they came from.
+ */
+
+#ifndef FIVEM_FRAMEGEN_MEMORY_BUDGET_H
+#define FIVEM_FRAMEGEN_MEMORY_BUDGET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * What an allocation is, for the per-category breakdown
+ */
+enum class MemoryCategory : uint8_t {
+    Textures = 0,       // Pooled render textures, idle ones included
+    Buffers,            // Calculator textures, structured and constant buffers
+    Shaders,            // Shader bytecode handed to the driver
+    Count
+};
+
+/**
+ * Degradation steps, cheapest in quality first; each level includes the
+ * ones before it
+ */
+enum class MemoryDegradation : uint8_t {
+    None = 0,
+    TrimIdle,           // Destroy pooled textures as soon as they go idle
+    HalfResolution,     // Interpolate at half size, no sharpen intermediate
+    Count
+};
+
+/**
+ * Allocation registry with a limit and a degradation level
+ *
+ * Update steps one level per call: up while usage is over the limit, and
+ * back down once the bytes the step saved would fit under the limit again
+ * with some headroom.
+ */
+class MemoryBudget {
+public:
+    // Relax only when usage after undoing a step stays below this share of the limit
+    static constexpr float RELAX_FRACTION = 0.9f;
+
+    MemoryBudget();
+
+    /**
+     * Set the limit in bytes; 0 means unlimited
+     */
+    void SetLimit(uint64_t bytes) { m_Limit = bytes; }
+    uint64_t GetLimit() const { return m_Limit; }
+
+    /**
+     * Record an allocation; registering an owner again replaces its size
+     */
+    void Register(const void* owner, MemoryCategory category, uint64_t bytes);
+
+    /**
+     * Forget an allocation; unknown owners are ignored
+     */
+    void Unregister(const void* owner);
+
+    uint64_t GetUsage() const { return m_Usage; }
+    uint64_t GetUsage(MemoryCategory category) const {
+        return m_CategoryUsage[static_cast<size_t>(category)];
+    }
+    uint64_t GetPeakUsage() const { return m_Peak; }
+
+    bool IsOverBudget() const { return m_Limit != 0 && m_Usage > m_Limit; }
+
+    /**
+     * Re-evaluate the degradation level; call once per frame after the
+     * previous level has been applied
+     *
+     * @return True if the level changed
+     */
+    bool Update();
+
+    MemoryDegradation GetDegradation() const { return m_Level; }
+    bool IsDegraded(MemoryDegradation level) const { return m_Level >= level; }
+
+    static const char* GetDegradationName(MemoryDegradation level);
+
+private:
+    static constexpr size_t LEVEL_COUNT = static_cast<size_t>(MemoryDegradation::Count);
+
+    struct Entry {
+        const void* owner = nullptr;
+        MemoryCategory category = MemoryCategory::Textures;
+        uint64_t bytes = 0;
+    };
+
+    std::vector<Entry> m_Entries;
+    uint64_t m_CategoryUsage[static_cast<size_t>(MemoryCategory::Count)] = {};
+    uint64_t m_Usage = 0;
+    uint64_t m_Peak = 0;
+    uint64_t m_Limit = 0;
+
+    MemoryDegradation m_Level = MemoryDegradation::None;
+
+    // Bytes each level saved over the one below, measured the frame after stepping up
+    uint64_t m_StepSavings[LEVEL_COUNT] = {};
+    uint64_t m_UsageBeforeStep = 0;
+    bool m_MeasurePending = false;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_MEMORY_BUDGET_H
@@ -0,0 +1,222 @@
+/**
+ * Motion Field Upsampling Implementation
+ */
+
+#include "motion_upsample.h"
+#include "simd.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+// Default guide luma difference at which blocks start to drop out
+static constexpr float DEFAULT_RANGE_SIGMA = 20.0f;
+
+// Spatial falloff in blocks; the 3x3 footprint reaches about 1.5 sigma
+static constexpr float SPATIAL_SIGMA = 1.0f;
+
+BilateralMotionUpsampler::BilateralMotionUpsampler() {
+    SetRangeSigma(DEFAULT_RANGE_SIGMA);
+}
+
+BilateralMotionUpsampler::~BilateralMotionUpsampler() {
+    Shutdown();
+}
+
+bool BilateralMotionUpsampler::Initialize(uint32_t width, uint32_t height, uint32_t blockSize) {
+    if (width == 0 || height == 0 || blockSize == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_BlockSize = blockSize;
+
+    m_GuideLuma.assign(static_cast<size_t>(width) * height, 0);
+    m_Guide = { m_GuideLuma.data(), width, height, width };
+    m_Band.assign(static_cast<size_t>(width) * blockSize, MotionVector{});
+
+    // Laid out neighbour-major so four adjacent pixels load as one vector
+    m_SpatialLut.assign(static_cast<size_t>(blockSize) * 3, 0.0f);
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t offset = 0; offset < blockSize; ++offset) {
+            float d = (offset + 0.5f - blockSize * 0.5f) / blockSize - (static_cast<float>(i) - 1.0f);
+            d /= SPATIAL_SIGMA;
+            m_SpatialLut[i * blockSize + offset] = std::exp(-0.5f * d * d);
+        }
+    }
+
+    m_Initialized = true;
+    return true;
+}
+
+void BilateralMotionUpsampler::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_GuideLuma.clear();
+    m_GuideLuma.shrink_to_fit();
+    m_Guide = {};
+    m_BlockLuma.clear();
+    m_Band.clear();
+    m_Band.shrink_to_fit();
+    m_SpatialLut.clear();
+
+    m_Initialized = false;
+}
+
+void BilateralMotionUpsampler::SetRangeSigma(float sigma) {
+    sigma = (std::max)(sigma, 1.0f);
+    for (int d = 0; d < 256; ++d) {
+        float x = d / sigma;
+        // Floor keeps the sum non-zero when every block crosses an edge
+        m_RangeLut[d] = (std::max)(1.0f / 256.0f, std::exp(-0.5f * x * x));
+    }
+}
+
+template <PixelFormat F>
+void BilateralMotionUpsampler::Prepare(const ConstFormatPlane<F>& guide, const MotionField& motion) {
+    if (!m_Initialized || guide.width != m_Width || guide.height != m_Height) return;
+
+    for (uint32_t y = 0; y < m_Height; ++y) {
+        const PixelStorage<F>* in = guide.Row(y);
+        uint8_t* out = m_GuideLuma.data() + static_cast<size_t>(y) * m_Width;
+        for (uint32_t x = 0; x < m_Width; ++x) {
+            out[x] = static_cast<uint8_t>(PixelTraits<F>::Luma(in[x]));
+        }
+    }
+
+    Prepare(Plane<const uint8_t>{ m_GuideLuma.data(), m_Width, m_Height, m_Width }, motion);
+}
+
+void BilateralMotionUpsampler::Prepare(const Plane<const uint8_t>& guideLuma, const MotionField& motion) {
+    if (!m_Initialized || guideLuma.width != m_Width || guideLuma.height != m_Height) return;
+    m_Guide = guideLuma;
+
+    // Mean over each block's pixels that fall inside the frame
+    m_BlocksX = motion.blocksX;
+    m_BlocksY = motion.blocksY;
+    m_BlockLuma.assign(static_cast<size_t>(m_BlocksX) * m_BlocksY, 0.0f);
+    for (uint32_t by = 0; by < m_BlocksY; ++by) {
+        uint32_t y0 = (std::min)(by * motion.blockSize, m_Height - 1);
+        uint32_t y1 = (std::min)(y0 + motion.blockSize, m_Height);
+        for (uint32_t bx = 0; bx < m_BlocksX; ++bx) {
+            uint32_t x0 = (std::min)(bx * motion.blockSize, m_Width - 1);
+            uint32_t x1 = (std::min)(x0 + motion.blockSize, m_Width);
+            uint32_t sum = 0;
+            for (uint32_t y = y0; y < y1; ++y) {
+                const uint8_t* row = m_Guide.Row(y);
+                for (uint32_t x = x0; x < x1; ++x) sum += row[x];
+            }
+            m_BlockLuma[static_cast<size_t>(by) * m_BlocksX + bx] =
+                static_cast<float>(sum) / static_cast<float>((x1 - x0) * (y1 - y0));
+        }
+    }
+}
+
+float BilateralMotionUpsampler::BlockLuma(int bx, int by) const {
+    bx = std::clamp(bx, 0, static_cast<int>(m_BlocksX) - 1);
+    by = std::clamp(by, 0, static_cast<int>(m_BlocksY) - 1);
+    return m_BlockLuma[static_cast<size_t>(by) * m_BlocksX + bx];
+}
+
+void BilateralMotionUpsampler::UpsampleBand(const MotionField& motion, uint32_t y) {
+    if (!m_Initialized || m_BlockLuma.empty() || motion.blockSize != m_BlockSize) return;
+
+    const int by = static_cast<int>(y / m_BlockSize);
+    const uint32_t y0 = by * m_BlockSize;
+    const uint32_t y1 = (std::min)(y0 + m_BlockSize, m_Height);
+    const int tilesX = static_cast<int>((m_Width + m_BlockSize - 1) / m_BlockSize);
+
+    for (int bx = 0; bx < tilesX; ++bx) {
+        UpsampleTile(motion, bx, by, y0, y1);
+    }
+}
+
+void BilateralMotionUpsampler::UpsampleTile(const MotionField& motion, int bx, int by, uint32_t y0, uint32_t y1) {
+    const uint32_t x0 = bx * m_BlockSize;
+    const uint32_t x1 = (std::min)(x0 + m_BlockSize, m_Width);
+
+    MotionVector vectors[3][3];
+    int lumas[3][3];
+    bool uniform = true;
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            vectors[j][i] = motion.Block(bx + i - 1, by + j - 1);
+            lumas[j][i] = static_cast<int>(BlockLuma(bx + i - 1, by + j - 1) + 0.5f);
+            uniform &= vectors[j][i].x == vectors[0][0].x && vectors[j][i].y == vectors[0][0].y;
+        }
+    }
+
+    // Inside a rigidly moving region every weight picks the same vector
+    if (uniform) {
+        for (uint32_t y = y0; y < y1; ++y) {
+            MotionVector* out = m_Band.data() + static_cast<size_t>(y - y0) * m_Width;
+            std::fill(out + x0, out + x1, vectors[0][0]);
+        }
+        return;
+    }
+
+    for (uint32_t y = y0; y < y1; ++y) {
+        const uint8_t* guide = m_Guide.Row(y);
+        MotionVector* out = m_Band.data() + static_cast<size_t>(y - y0) * m_Width;
+        const uint32_t offsetY = y - y0;
+        const float spatialY[3] = {
+            m_SpatialLut[offsetY], m_SpatialLut[m_BlockSize + offsetY], m_SpatialLut[2 * m_BlockSize + offsetY]
+        };
+
+        uint32_t x = x0;
+#ifdef FIVEM_FRAMEGEN_SSE2
+        for (; x + 4 <= x1; x += 4) {
+            const uint32_t offsetX = x - x0;
+            const int g0 = guide[x], g1 = guide[x + 1], g2 = guide[x + 2], g3 = guide[x + 3];
+            __m128 sumW = _mm_setzero_ps();
+            __m128 sumX = _mm_setzero_ps();
+            __m128 sumY = _mm_setzero_ps();
+
+            for (int j = 0; j < 3; ++j) {
+                for (int i = 0; i < 3; ++i) {
+                    const int l = lumas[j][i];
+                    __m128 range = _mm_setr_ps(m_RangeLut[std::abs(g0 - l)], m_RangeLut[std::abs(g1 - l)],
+                                               m_RangeLut[std::abs(g2 - l)], m_RangeLut[std::abs(g3 - l)]);
+                    __m128 spatial = _mm_loadu_ps(&m_SpatialLut[i * m_BlockSize + offsetX]);
+                    __m128 w = _mm_mul_ps(_mm_mul_ps(range, spatial), _mm_set1_ps(spatialY[j]));
+                    sumW = _mm_add_ps(sumW, w);
+                    sumX = _mm_add_ps(sumX, _mm_mul_ps(w, _mm_set1_ps(vectors[j][i].x)));
+                    sumY = _mm_add_ps(sumY, _mm_mul_ps(w, _mm_set1_ps(vectors[j][i].y)));
+                }
+            }
+
+            __m128 flowX = _mm_div_ps(sumX, sumW);
+            __m128 flowY = _mm_div_ps(sumY, sumW);
+            _mm_storeu_ps(&out[x].x, _mm_unpacklo_ps(flowX, flowY));
+            _mm_storeu_ps(&out[x + 2].x, _mm_unpackhi_ps(flowX, flowY));
+        }
+#endif
+        for (; x < x1; ++x) {
+            const uint32_t offsetX = x - x0;
+            const int g = guide[x];
+            float sumW = 0.0f, sumX = 0.0f, sumY = 0.0f;
+
+            for (int j = 0; j < 3; ++j) {
+                for (int i = 0; i < 3; ++i) {
+                    float w = m_RangeLut[std::abs(g - lumas[j][i])] *
+                              m_SpatialLut[i * m_BlockSize + offsetX] * spatialY[j];
+                    sumW += w;
+                    sumX += w * vectors[j][i].x;
+                    sumY += w * vectors[j][i].y;
+                }
+            }
+
+            out[x].x = sumX / sumW;
+            out[x].y = sumY / sumW;
+        }
+    }
+}
+
+#define INSTANTIATE_MOTION_UPSAMPLE(format) \
+    template void BilateralMotionUpsampler::Prepare<format>(const ConstFormatPlane<format>&, const MotionField&);
+FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(INSTANTIATE_MOTION_UPSAMPLE)
+#undef INSTANTIATE_MOTION_UPSAMPLE
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
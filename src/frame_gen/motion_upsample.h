@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * Motion Field Upsampling
+ *
+ * Turns the coarse block motion field into per-pixel flow, guided by image
+ * luma so vectors stop at object edges instead of bleeding across them.
+ */
+
+#ifndef FIVEM_FRAMEGEN_MOTION_UPSAMPLE_H
+#define FIVEM_FRAMEGEN_MOTION_UPSAMPLE_H
+
+#include "pixel_format.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Joint bilateral block-to-pixel motion upsampler
+ *
+ * Each pixel takes the vectors of the 3x3 blocks around its own, weighted
+ * by a Gaussian on the distance to each block centre and by how closely
+ * the block's mean luma matches the pixel's luma. Blocks are anchored in
+ * the previous frame (the motion search matches prev blocks into curr), so
+ * that frame is the guide.
+ *
+ * Flow is produced one band of block rows at a time, tile by tile, so
+ * the buffer stays at width x blockSize regardless of frame height.
+ */
+class BilateralMotionUpsampler {
+public:
+    BilateralMotionUpsampler();
+    ~BilateralMotionUpsampler();
+
+    /**
+     * Allocate guide and band buffers
+     *
+     * @param blockSize Pixels per motion vector
+     */
+    bool Initialize(uint32_t width, uint32_t height, uint32_t blockSize);
+    void Shutdown();
+
+    /**
+     * Set the luma difference (0-255) at which a block's weight falls to ~60%
+     */
+    void SetRangeSigma(float sigma);
+
+    /**
+     * Per-frame setup: guide luma and per-block mean luma
+     *
+     * @param guide Previous real frame
+     */
+    template <PixelFormat F>
+    void Prepare(const ConstFormatPlane<F>& guide, const MotionField& motion);
+
+    /**
+     * Per-frame setup from a luma plane the caller already has; it must
+     * stay valid until the last UpsampleBand of the frame
+     */
+    void Prepare(const Plane<const uint8_t>& guideLuma, const MotionField& motion);
+
+    /**
+     * Upsample the block row containing pixel row y into the band buffer
+     */
+    void UpsampleBand(const MotionField& motion, uint32_t y);
+
+    /**
+     * Per-pixel flow for a row of the most recent band
+     */
+    const MotionVector* GetRow(uint32_t y) const {
+        return m_Band.data() + static_cast<size_t>(y % m_BlockSize) * m_Width;
+    }
+
+    uint32_t GetBlockSize() const { return m_BlockSize; }
+
+private:
+    /**
+     * Upsample one blockSize x blockSize tile of the band
+     */
+    void UpsampleTile(const MotionField& motion, int bx, int by, uint32_t y0, uint32_t y1);
+
+    /**
+     * Mean guide luma of a block, edge clamped like MotionField::Block
+     */
+    float BlockLuma(int bx, int by) const;
+
+    std::vector<uint8_t> m_GuideLuma;       // Full resolution
+    Plane<const uint8_t> m_Guide;           // m_GuideLuma or the caller's plane
+    std::vector<float> m_BlockLuma;         // One per motion block
+    std::vector<MotionVector> m_Band;       // blockSize rows of per-pixel flow
+    std::vector<float> m_SpatialLut;        // [offset in block][neighbour -1, 0, +1]
+    float m_RangeLut[256] = {};             // Range weight by |luma difference|
+
+    uint32_t m_BlocksX = 0;
+    uint32_t m_BlocksY = 0;
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    uint32_t m_BlockSize = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_MOTION_UPSAMPLE_H
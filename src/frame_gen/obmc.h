@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * Overlapped Block Motion Compensation
+ *
+ * Compile-time raised-cosine window and the four-hypothesis combine used by
+ * the CPU interpolator's OBMC mode. Every block's window spans twice the
+ * block size, so each pixel is covered by the four nearest blocks and their
+ * weights always sum to one.
+ */
+
+#ifndef FIVEM_FRAMEGEN_OBMC_H
+#define FIVEM_FRAMEGEN_OBMC_H
+
+#include "const_math.h"
+#include "pixel_format.h"
+#include "simd.h"
+#include <array>
+#include <cstdint>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+namespace Obmc {
+
+// Window taps across two blocks; pixel positions are mapped onto them
+static constexpr uint32_t WINDOW_SIZE = 16;
+
+// Per-axis weights are 6-bit, so a 2D weight fits the SSE2 16-bit multiply
+static constexpr uint32_t WEIGHT_BITS = 6;
+static constexpr uint32_t WEIGHT_ONE = 1u << WEIGHT_BITS;
+static constexpr uint32_t WEIGHT_SUM = WEIGHT_ONE * WEIGHT_ONE;
+
+namespace Detail {
+
+/**
+ * sin^2 window sampled at tap centres. The second half is the complement
+ * of the first, so overlapping taps sum exactly to WEIGHT_ONE after rounding.
+ */
+constexpr std::array<uint8_t, WINDOW_SIZE> MakeWindow() {
+    std::array<uint8_t, WINDOW_SIZE> window = {};
+    for (uint32_t i = 0; i < WINDOW_SIZE / 2; ++i) {
+        double s = ConstMath::Sin(ConstMath::PI * (i + 0.5) / WINDOW_SIZE);
+        window[i] = static_cast<uint8_t>(s * s * WEIGHT_ONE + 0.5);
+        window[i + WINDOW_SIZE / 2] = static_cast<uint8_t>(WEIGHT_ONE - window[i]);
+    }
+    return window;
+}
+
+} // namespace Detail
+
+inline constexpr std::array<uint8_t, WINDOW_SIZE> Window = Detail::MakeWindow();
+
+static_assert(Window[0] == Window[WINDOW_SIZE - 1] && Window[3] == Window[WINDOW_SIZE - 4],
+              "raised-cosine window is symmetric");
+static_assert(Window[0] > 0, "every covering block contributes");
+
+/**
+ * Blocks covering a pixel along one axis
+ *
+ * @param pos Pixel index
+ * @param blockSize Pixels per motion vector
+ * @param block0 First covering block (may be -1 at the frame edge; the
+ *               motion field clamps it); the second is block0 + 1
+ * @return Weight of block0 out of WEIGHT_ONE; block0 + 1 gets the rest
+ */
+inline uint32_t AxisTaps(uint32_t pos, uint32_t blockSize, int& block0) {
+    const uint32_t half = blockSize / 2;
+    block0 = static_cast<int>((pos + half) / blockSize) - 1;
+
+    // Offset within block0's window lies in the second half, [blockSize, 2 * blockSize)
+    const uint32_t offset = pos + half - static_cast<uint32_t>(block0 + 1) * blockSize + blockSize;
+    return Window[((2 * offset + 1) * WINDOW_SIZE) / (4 * blockSize)];
+}
+
+/**
+ * Weighted sum of four predictions; weights sum to WEIGHT_SUM
+ */
+template <PixelFormat F>
+inline PixelStorage<F> Combine4(const PixelStorage<F>* predictions, const uint32_t* weights) {
+#ifdef FIVEM_FRAMEGEN_SSE2
+    if constexpr (PixelTraits<F>::PACKED_8BIT) {
+        const __m128i zero = _mm_setzero_si128();
+        auto widen = [&](uint32_t p) {
+            return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(p)), zero);
+        };
+
+        // Interleave channel pairs so one madd yields four 32-bit channel sums
+        __m128i p01 = _mm_unpacklo_epi16(widen(predictions[0]), widen(predictions[1]));
+        __m128i p23 = _mm_unpacklo_epi16(widen(predictions[2]), widen(predictions[3]));
+        __m128i w01 = _mm_set1_epi32(static_cast<int>(weights[0] | (weights[1] << 16)));
+        __m128i w23 = _mm_set1_epi32(static_cast<int>(weights[2] | (weights[3] << 16)));
+
+        __m128i sum = _mm_add_epi32(_mm_madd_epi16(p01, w01), _mm_madd_epi16(p23, w23));
+        sum = _mm_add_epi32(sum, _mm_set1_epi32(static_cast<int>(WEIGHT_SUM / 2)));
+        sum = _mm_srli_epi32(sum, 2 * WEIGHT_BITS);
+        sum = _mm_packs_epi32(sum, sum);
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum)));
+    }
+#endif
+    return PixelTraits<F>::WeightedAverage(predictions, weights, WEIGHT_SUM);
+}
+
+} // namespace Obmc
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_OBMC_H
@@ -0,0 +1,144 @@
+/**
+ * Occlusion Estimation Implementation
+ */
+
+#include "occlusion.h"
+
+#include <cmath>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+// Divergence is dimensionless; scale it into the same range as the
+// warp-back error (pixels) so one strength knob drives both cues.
+// Keep in sync with DIVERGENCE_SCALE in g_InterpolationPS.
+static constexpr float DIVERGENCE_SCALE = 8.0f;
+
+bool OcclusionEstimator::Initialize(uint32_t blocksX, uint32_t blocksY) {
+    if (blocksX == 0 || blocksY == 0) return false;
+
+    m_BlocksX = blocksX;
+    m_BlocksY = blocksY;
+    m_Divergence.assign(static_cast<size_t>(blocksX) * blocksY, 0.0f);
+    return true;
+}
+
+void OcclusionEstimator::Shutdown() {
+    m_Divergence.clear();
+    m_Divergence.shrink_to_fit();
+    m_BlocksX = 0;
+    m_BlocksY = 0;
+    m_Prepared = false;
+}
+
+void OcclusionEstimator::ComputeDivergence(const MotionField& motion) {
+    const float invSpan = 1.0f / (2.0f * motion.blockSize);
+
+    for (uint32_t by = 0; by < m_BlocksY; ++by) {
+        float* row = m_Divergence.data() + static_cast<size_t>(by) * m_BlocksX;
+        for (uint32_t bx = 0; bx < m_BlocksX; ++bx) {
+            int x = static_cast<int>(bx);
+            int y = static_cast<int>(by);
+            float dx = motion.Block(x + 1, y).x - motion.Block(x - 1, y).x;
+            float dy = motion.Block(x, y + 1).y - motion.Block(x, y - 1).y;
+            row[bx] = (dx + dy) * invSpan;
+        }
+    }
+}
+
+float OcclusionEstimator::SampleDivergence(float px, float py, uint32_t blockSize) const {
+    float fx = std::clamp(px / blockSize - 0.5f, 0.0f, static_cast<float>(m_BlocksX - 1));
+    float fy = std::clamp(py / blockSize - 0.5f, 0.0f, static_cast<float>(m_BlocksY - 1));
+    uint32_t x0 = static_cast<uint32_t>(fx);
+    uint32_t y0 = static_cast<uint32_t>(fy);
+    uint32_t x1 = (std::min)(x0 + 1, m_BlocksX - 1);
+    uint32_t y1 = (std::min)(y0 + 1, m_BlocksY - 1);
+    float ax = fx - x0;
+    float ay = fy - y0;
+
+    const float* row0 = m_Divergence.data() + static_cast<size_t>(y0) * m_BlocksX;
+    const float* row1 = m_Divergence.data() + static_cast<size_t>(y1) * m_BlocksX;
+    float top = row0[x0] + (row0[x1] - row0[x0]) * ax;
+    float bot = row1[x0] + (row1[x1] - row1[x0]) * ax;
+    return top + (bot - top) * ay;
+}
+
+uint32_t OcclusionEstimator::Estimate(const MotionField& motion, float interpolationFactor,
+                                      Plane<uint8_t> weights, Plane<uint8_t> holes) {
+    if (!weights.IsValid()) return 0;
+
+    Prepare(motion);
+    return EstimateRect(motion, interpolationFactor, weights, holes,
+        0, 0, weights.width, weights.height);
+}
+
+void OcclusionEstimator::Prepare(const MotionField& motion) {
+    m_Prepared = m_Strength > 0.0f && motion.IsValid() &&
+                 motion.blocksX == m_BlocksX && motion.blocksY == m_BlocksY;
+    if (m_Prepared) {
+        ComputeDivergence(motion);
+    }
+}
+
+uint32_t OcclusionEstimator::EstimateRect(const MotionField& motion, float interpolationFactor,
+                                          Plane<uint8_t> weights, Plane<uint8_t> holes,
+                                          uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const {
+    if (!weights.IsValid()) return 0;
+
+    const bool writeHoles = holes.IsValid();
+
+    const float t = std::clamp(interpolationFactor, 0.0f, 1.0f);
+    const uint8_t lerpWeight = static_cast<uint8_t>(t * 255.0f + 0.5f);
+
+    if (!m_Prepared) {
+        for (uint32_t y = y0; y < y1; ++y) {
+            std::fill(weights.Row(y) + x0, weights.Row(y) + x1, lerpWeight);
+            if (writeHoles) std::fill(holes.Row(y) + x0, holes.Row(y) + x1, static_cast<uint8_t>(0));
+        }
+        return 0;
+    }
+
+    uint32_t holeCount = 0;
+
+    for (uint32_t y = y0; y < y1; ++y) {
+        uint8_t* out = weights.Row(y);
+        uint8_t* holeRow = writeHoles ? holes.Row(y) : nullptr;
+        const float py = y + 0.5f;
+
+        for (uint32_t x = x0; x < x1; ++x) {
+            const float px = x + 0.5f;
+
+            MotionVector m = motion.Sample(px, py);
+
+            // Where each source sample comes from
+            MotionVector mPrev = motion.Sample(px - m.x * t, py - m.y * t);
+            MotionVector mCurr = motion.Sample(px + m.x * (1.0f - t), py + m.y * (1.0f - t));
+
+            float errPrev = std::fabs(mPrev.x - m.x) + std::fabs(mPrev.y - m.y);
+            float errCurr = std::fabs(mCurr.x - m.x) + std::fabs(mCurr.y - m.y);
+
+            float div = SampleDivergence(px, py, motion.blockSize) * DIVERGENCE_SCALE;
+
+            // Expansion reveals content only the current frame has;
+            // contraction covers content only the previous frame has.
+            float wPrev = (1.0f - t) / (1.0f + m_Strength * (errPrev + (std::max)(div, 0.0f)));
+            float wCurr = t / (1.0f + m_Strength * (errCurr + (std::max)(-div, 0.0f)));
+
+            float sum = wPrev + wCurr;
+            float w = sum > 1e-5f ? wCurr / sum : t;
+            out[x] = static_cast<uint8_t>(w * 255.0f + 0.5f);
+
+            // Neither source agrees with our vector: leave it to the hole filler
+            if (holeRow) {
+                bool hole = errPrev > m_HoleThreshold && errCurr > m_HoleThreshold;
+                holeRow[x] = hole ? 1 : 0;
+                holeCount += hole ? 1 : 0;
+            }
+        }
+    }
+
+    return holeCount;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
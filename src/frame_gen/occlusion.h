@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * Occlusion Estimation
+ *
+ * Derives per-pixel blend weights from the block motion field so the
+ * interpolator can favour whichever source frame actually shows a pixel.
+ */
+
+#ifndef FIVEM_FRAMEGEN_OCCLUSION_H
+#define FIVEM_FRAMEGEN_OCCLUSION_H
+
+#include "image_types.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Occlusion-aware blend weight estimator
+ *
+ * Combines two cues that fall out of the motion field for free:
+ *  - Divergence: a contracting field means content is being covered (trust
+ *    the previous frame), an expanding field means content is being revealed
+ *    (trust the current frame).
+ *  - Warp-back error: the vector found at each warped sample position should
+ *    match the pixel's own vector; a mismatch marks that sample as occluded.
+ */
+class OcclusionEstimator {
+public:
+    OcclusionEstimator() = default;
+    ~OcclusionEstimator() = default;
+
+    /**
+     * Allocate per-block scratch for the given motion field size
+     */
+    bool Initialize(uint32_t blocksX, uint32_t blocksY);
+    void Shutdown();
+
+    /**
+     * Set how strongly occlusion cues pull the blend (0 = plain lerp)
+     */
+    void SetStrength(float strength) { m_Strength = strength < 0.0f ? 0.0f : strength; }
+    float GetStrength() const { return m_Strength; }
+
+    /**
+     * Set the warp-back error (pixels) above which a sample counts as occluded
+     */
+    void SetHoleThreshold(float pixels) { m_HoleThreshold = pixels; }
+    float GetHoleThreshold() const { return m_HoleThreshold; }
+
+    /**
+     * Estimate blend weights toward the current frame (0-255 per pixel)
+     *
+     * @param motion Block motion field (pixels, prev -> curr)
+     * @param interpolationFactor Temporal position of the generated frame (0-1)
+     * @param weights Output weight plane, same size as the frame
+     * @param holes Optional hole mask; set to 1 where neither source is visible
+     * @return Number of hole pixels written to the mask
+     */
+    uint32_t Estimate(const MotionField& motion, float interpolationFactor,
+                      Plane<uint8_t> weights, Plane<uint8_t> holes = {});
+
+    /**
+     * Per-frame setup for EstimateRect (derives the divergence field)
+     */
+    void Prepare(const MotionField& motion);
+
+    /**
+     * Estimate weights for a pixel rectangle [x0, x1) x [y0, y1)
+     *
+     * Prepare must have been called for this motion field first.
+     */
+    uint32_t EstimateRect(const MotionField& motion, float interpolationFactor,
+                          Plane<uint8_t> weights, Plane<uint8_t> holes,
+                          uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const;
+
+private:
+    /**
+     * Compute per-block divergence by central differences
+     */
+    void ComputeDivergence(const MotionField& motion);
+
+    /**
+     * Bilinearly sample the per-block divergence at a pixel position
+     */
+    float SampleDivergence(float px, float py, uint32_t blockSize) const;
+
+    std::vector<float> m_Divergence;
+    uint32_t m_BlocksX = 0;
+    uint32_t m_BlocksY = 0;
+    float m_Strength = 1.0f;
+    float m_HoleThreshold = 4.0f;
+    bool m_Prepared = false;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_OCCLUSION_H
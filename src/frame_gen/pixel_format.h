@@ -0,0 +1,330 @@
+#pragma once
+
+/**
+ * Pixel Format Traits
+ *
+ * Compile-time description of the swap chain formats the CPU path handles
+ * natively. Every kernel that touches pixels is instantiated once per
+ * format and picked when the engine is initialized, so the inner loops
+ * never branch on the format or round-trip through a generic float4.
+ * Platform-neutral; the DXGI mapping lives in frame_generator.h.
+ */
+
+#ifndef FIVEM_FRAMEGEN_PIXEL_FORMAT_H
+#define FIVEM_FRAMEGEN_PIXEL_FORMAT_H
+
+#include "image_types.h"
+#include "color_space.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Supported frame formats
+ */
+enum class PixelFormat : uint8_t {
+    RGBA8 = 0,      // R8G8B8A8_UNORM, R in the low byte
+    BGRA8 = 1,      // B8G8R8A8_UNORM, B in the low byte
+    RGB10A2 = 2,    // R10G10B10A2_UNORM, R in the low bits
+    RGBA16F = 3     // R16G16B16A16_FLOAT (scRGB, linear)
+};
+
+constexpr uint32_t BytesPerPixel(PixelFormat format) {
+    return format == PixelFormat::RGBA16F ? 8 : 4;
+}
+
+inline const char* GetPixelFormatName(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::RGBA8: return "RGBA8";
+        case PixelFormat::BGRA8: return "BGRA8";
+        case PixelFormat::RGB10A2: return "RGB10A2";
+        case PixelFormat::RGBA16F: return "RGBA16F";
+    }
+    return "Unknown";
+}
+
+// Expands X(format) for every PixelFormat (explicit instantiations)
+#define FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(X) \
+    X(PixelFormat::RGBA8) \
+    X(PixelFormat::BGRA8) \
+    X(PixelFormat::RGB10A2) \
+    X(PixelFormat::RGBA16F)
+
+/**
+ * IEEE half <-> float (round to nearest even), no F16C required
+ */
+namespace Half {
+
+inline float ToFloat(uint16_t h) {
+    constexpr uint32_t SHIFTED_EXP = 0x7C00u << 13;
+    uint32_t bits = (h & 0x7FFFu) << 13;
+    uint32_t exp = bits & SHIFTED_EXP;
+    bits += (127 - 15) << 23;
+
+    if (exp == SHIFTED_EXP) {
+        bits += (128 - 16) << 23;   // Inf/NaN
+    } else if (exp == 0) {
+        // Subnormal: renormalise through the FPU
+        bits += 1 << 23;
+        bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113u << 23));
+    }
+    return std::bit_cast<float>(bits | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+inline uint16_t FromFloat(float f) {
+    uint32_t bits = std::bit_cast<uint32_t>(f);
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t result;
+    if (bits >= 0x47800000u) {
+        // Overflow -> Inf, NaN stays NaN
+        result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    } else if (bits < 0x38800000u) {
+        // Subnormal or zero: let the FPU round the mantissa into place
+        constexpr uint32_t DENORM_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+        float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(DENORM_MAGIC);
+        result = std::bit_cast<uint32_t>(aligned) - DENORM_MAGIC;
+    } else {
+        uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + mantissaOdd;
+        result = bits >> 13;
+    }
+    return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+} // namespace Half
+
+template <PixelFormat F>
+struct PixelTraits;
+
+namespace Detail {
+
+/**
+ * 8-bit-per-channel packed formats; only the R/B byte positions differ
+ */
+template <PixelFormat F, uint32_t R_SHIFT, uint32_t B_SHIFT>
+struct Packed8Traits {
+    using Storage = uint32_t;
+    static constexpr PixelFormat FORMAT = F;
+
+    // Byte-per-channel layout, so the SSE2 byte kernels apply
+    static constexpr bool PACKED_8BIT = true;
+
+    // Channel value of SDR white
+    static constexpr float PEAK = 255.0f;
+
+    /**
+     * Rec.601 luma in 0-255
+     */
+    static uint32_t Luma(Storage p) {
+        return (((p >> R_SHIFT) & 0xFF) * 77 + ((p >> 8) & 0xFF) * 150 + ((p >> B_SHIFT) & 0xFF) * 29) >> 8;
+    }
+
+    /**
+     * Blend toward b by weight 0-256; R/B and G/A pairs share a 32-bit lane
+     */
+    static Storage Lerp(Storage a, Storage b, uint32_t weight) {
+        const uint32_t mask = 0x00FF00FFu;
+        uint32_t rb = (((a & mask) * (256 - weight) + (b & mask) * weight) >> 8) & mask;
+        uint32_t ga = ((((a >> 8) & mask) * (256 - weight) + ((b >> 8) & mask) * weight) >> 8) & mask;
+        return rb | (ga << 8);
+    }
+
+    /**
+     * Lerp in linear light via the sRGB tables (alpha stays linear)
+     */
+    static Storage LerpLinearLight(Storage a, Storage b, uint32_t weight) {
+        uint32_t result = 0;
+        for (uint32_t shift = 0; shift < 24; shift += 8) {
+            uint32_t la = ColorSpace::ToLinear((a >> shift) & 0xFF);
+            uint32_t lb = ColorSpace::ToLinear((b >> shift) & 0xFF);
+            result |= ColorSpace::ToSrgb((la * (256 - weight) + lb * weight) >> 8) << shift;
+        }
+        uint32_t alpha = ((a >> 24) * (256 - weight) + (b >> 24) * weight) >> 8;
+        return result | (alpha << 24);
+    }
+
+    /**
+     * Normalised weighted mean of four pixels; sum must be the non-zero weight total
+     */
+    static Storage WeightedAverage(const Storage* taps, const uint32_t* weights, uint32_t sum) {
+        float inv = 1.0f / static_cast<float>(sum);
+        uint32_t result = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            uint32_t acc = 0;
+            for (int i = 0; i < 4; ++i) {
+                acc += weights[i] * ((taps[i] >> shift) & 0xFF);
+            }
+            result |= static_cast<uint32_t>(acc * inv + 0.5f) << shift;
+        }
+        return result;
+    }
+
+    /**
+     * Colour channels in storage order, 0-PEAK (the sharpen kernel is order-agnostic)
+     */
+    static void GetChannels(Storage p, float* rgb) {
+        rgb[0] = static_cast<float>(p & 0xFF);
+        rgb[1] = static_cast<float>((p >> 8) & 0xFF);
+        rgb[2] = static_cast<float>((p >> 16) & 0xFF);
+    }
+
+    static Storage SetChannels(const float* rgb, Storage alphaSource) {
+        uint32_t result = alphaSource & 0xFF000000u;
+        for (uint32_t c = 0; c < 3; ++c) {
+            result |= static_cast<uint32_t>(std::clamp(rgb[c], 0.0f, PEAK) + 0.5f) << (c * 8);
+        }
+        return result;
+    }
+};
+
+} // namespace Detail
+
+template <>
+struct PixelTraits<PixelFormat::RGBA8> : Detail::Packed8Traits<PixelFormat::RGBA8, 0, 16> {};
+
+template <>
+struct PixelTraits<PixelFormat::BGRA8> : Detail::Packed8Traits<PixelFormat::BGRA8, 16, 0> {};
+
+template <>
+struct PixelTraits<PixelFormat::RGB10A2> {
+    using Storage = uint32_t;
+    static constexpr PixelFormat FORMAT = PixelFormat::RGB10A2;
+    static constexpr bool PACKED_8BIT = false;
+    static constexpr float PEAK = 1023.0f;
+
+    static uint32_t Channel(Storage p, uint32_t c) { return (p >> (c * 10)) & 0x3FF; }
+
+    static uint32_t Luma(Storage p) {
+        return (Channel(p, 0) * 77 + Channel(p, 1) * 150 + Channel(p, 2) * 29) >> 10;
+    }
+
+    static Storage Lerp(Storage a, Storage b, uint32_t weight) {
+        uint32_t result = 0;
+        for (uint32_t c = 0; c < 3; ++c) {
+            result |= ((Channel(a, c) * (256 - weight) + Channel(b, c) * weight) >> 8) << (c * 10);
+        }
+        uint32_t alpha = ((a >> 30) * (256 - weight) + (b >> 30) * weight) >> 8;
+        return result | (alpha << 30);
+    }
+
+    // 10-bit swap chains are usually HDR10 (PQ); the sRGB tables don't apply
+    static Storage LerpLinearLight(Storage a, Storage b, uint32_t weight) { return Lerp(a, b, weight); }
+
+    static Storage WeightedAverage(const Storage* taps, const uint32_t* weights, uint32_t sum) {
+        float inv = 1.0f / static_cast<float>(sum);
+        uint32_t result = 0;
+        for (uint32_t c = 0; c < 3; ++c) {
+            uint32_t acc = 0;
+            for (int i = 0; i < 4; ++i) {
+                acc += weights[i] * Channel(taps[i], c);
+            }
+            result |= static_cast<uint32_t>(acc * inv + 0.5f) << (c * 10);
+        }
+        uint32_t alphaAcc = 0;
+        for (int i = 0; i < 4; ++i) {
+            alphaAcc += weights[i] * (taps[i] >> 30);
+        }
+        return result | (static_cast<uint32_t>(alphaAcc * inv + 0.5f) << 30);
+    }
+
+    static void GetChannels(Storage p, float* rgb) {
+        for (uint32_t c = 0; c < 3; ++c) {
+            rgb[c] = static_cast<float>(Channel(p, c));
+        }
+    }
+
+    static Storage SetChannels(const float* rgb, Storage alphaSource) {
+        uint32_t result = alphaSource & 0xC0000000u;
+        for (uint32_t c = 0; c < 3; ++c) {
+            result |= static_cast<uint32_t>(std::clamp(rgb[c], 0.0f, PEAK) + 0.5f) << (c * 10);
+        }
+        return result;
+    }
+};
+
+template <>
+struct PixelTraits<PixelFormat::RGBA16F> {
+    using Storage = uint64_t;
+    static constexpr PixelFormat FORMAT = PixelFormat::RGBA16F;
+    static constexpr bool PACKED_8BIT = false;
+
+    // scRGB 1.0 is SDR white; highlights above it are left unsharpened
+    static constexpr float PEAK = 1.0f;
+
+    static float Channel(Storage p, uint32_t c) {
+        return Half::ToFloat(static_cast<uint16_t>(p >> (c * 16)));
+    }
+
+    static Storage FromChannel(float v, uint32_t c) {
+        return static_cast<Storage>(Half::FromFloat(v)) << (c * 16);
+    }
+
+    /**
+     * Luma of the linear value, sRGB-encoded to 0-255 so thresholds tuned
+     * on 8-bit frames behave the same (highlights saturate at 255)
+     */
+    static uint32_t Luma(Storage p) {
+        float l = Channel(p, 0) * 0.299f + Channel(p, 1) * 0.587f + Channel(p, 2) * 0.114f;
+        l = std::clamp(l, 0.0f, 1.0f);
+        return ColorSpace::ToSrgb(static_cast<uint32_t>(l * ColorSpace::LINEAR_MAX + 0.5f));
+    }
+
+    static Storage Lerp(Storage a, Storage b, uint32_t weight) {
+        float t = static_cast<float>(weight) * (1.0f / 256.0f);
+        Storage result = 0;
+        for (uint32_t c = 0; c < 4; ++c) {
+            float va = Channel(a, c);
+            result |= FromChannel(va + (Channel(b, c) - va) * t, c);
+        }
+        return result;
+    }
+
+    // scRGB is already linear
+    static Storage LerpLinearLight(Storage a, Storage b, uint32_t weight) { return Lerp(a, b, weight); }
+
+    static Storage WeightedAverage(const Storage* taps, const uint32_t* weights, uint32_t sum) {
+        float inv = 1.0f / static_cast<float>(sum);
+        Storage result = 0;
+        for (uint32_t c = 0; c < 4; ++c) {
+            float acc = 0.0f;
+            for (int i = 0; i < 4; ++i) {
+                acc += static_cast<float>(weights[i]) * Channel(taps[i], c);
+            }
+            result |= FromChannel(acc * inv, c);
+        }
+        return result;
+    }
+
+    static void GetChannels(Storage p, float* rgb) {
+        for (uint32_t c = 0; c < 3; ++c) {
+            rgb[c] = Channel(p, c);
+        }
+    }
+
+    static Storage SetChannels(const float* rgb, Storage alphaSource) {
+        Storage result = alphaSource & 0xFFFF000000000000ull;
+        for (uint32_t c = 0; c < 3; ++c) {
+            result |= FromChannel((std::max)(rgb[c], 0.0f), c);
+        }
+        return result;
+    }
+};
+
+template <PixelFormat F>
+using PixelStorage = typename PixelTraits<F>::Storage;
+
+template <PixelFormat F>
+using FormatPlane = Plane<PixelStorage<F>>;
+
+template <PixelFormat F>
+using ConstFormatPlane = Plane<const PixelStorage<F>>;
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_PIXEL_FORMAT_H
@@ -0,0 +1,150 @@
+/**
+ * Readback Ring Implementation
+ */
+
+#include "readback_ring.h"
+#include "../utils/logger.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+ReadbackRing::ReadbackRing() = default;
+
+ReadbackRing::~ReadbackRing() {
+    Shutdown();
+}
+
+bool ReadbackRing::Initialize(IStagingDevice* device, const StagingDesc& desc, uint32_t depth) {
+    if (!device || depth == 0 || depth > MAX_DEPTH) return false;
+
+    Shutdown();
+    for (uint32_t i = 0; i < depth; ++i) {
+        m_Slots[i].staging = device->CreateReadback(desc);
+        if (!m_Slots[i].staging) {
+            Utils::Logger::Error("Failed to create readback copy %u of %u", i + 1, depth);
+            for (uint32_t j = 0; j < i; ++j) {
+                device->Destroy(m_Slots[j].staging);
+                m_Slots[j].staging = nullptr;
+            }
+            return false;
+        }
+    }
+
+    m_Device = device;
+    m_Desc = desc;
+    m_Depth = depth;
+    m_Next = 0;
+    m_Held = MAX_DEPTH;
+    m_Frame = 0;
+    m_LatencyMsTotal = 0.0;
+    m_Stats = {};
+    return true;
+}
+
+void ReadbackRing::Shutdown() {
+    if (!m_Device) return;
+
+    Release();
+    for (uint32_t i = 0; i < m_Depth; ++i) {
+        m_Device->Destroy(m_Slots[i].staging);
+        m_Slots[i] = {};
+    }
+
+    m_Device = nullptr;
+    m_Depth = 0;
+    m_Stats.inFlight = 0;
+}
+
+bool ReadbackRing::Submit(void* source) {
+    if (!m_Device || m_Held == m_Next) return false;
+
+    // The ring has lapped a copy nobody read; newer data wins
+    Slot& slot = m_Slots[m_Next];
+    if (slot.queued) {
+        slot.queued = false;
+        --m_Stats.inFlight;
+        ++m_Stats.dropped;
+    }
+
+    if (!m_Device->CopyToReadback(slot.staging, source)) {
+        return false;
+    }
+
+    slot.frameIndex = m_Frame++;
+    slot.submitTime = Clock::now();
+    slot.queued = true;
+    ++m_Stats.submitted;
+    ++m_Stats.inFlight;
+    m_Next = (m_Next + 1) % m_Depth;
+    return true;
+}
+
+bool ReadbackRing::Acquire(ReadbackFrame& frame, bool wait) {
+    if (!m_Device || m_Held != MAX_DEPTH) return false;
+
+    const uint32_t index = OldestQueued();
+    if (index == MAX_DEPTH) return false;
+
+    // Not due until depth - 1 newer copies are queued behind it
+    Slot& slot = m_Slots[index];
+    const uint64_t newer = m_Frame - 1 - slot.frameIndex;
+    if (!wait && newer + 1 < m_Depth) return false;
+
+    ConstImageView view;
+    MapStatus status = m_Device->MapRead(slot.staging, false, view);
+    if (status == MapStatus::Pending) {
+        if (!wait) {
+            ++m_Stats.notReady;
+            return false;
+        }
+        ++m_Stats.stalls;
+        status = m_Device->MapRead(slot.staging, true, view);
+    }
+
+    slot.queued = false;
+    --m_Stats.inFlight;
+    if (status != MapStatus::Ready) {
+        ++m_Stats.dropped;
+        return false;
+    }
+
+    const float latencyMs = std::chrono::duration<float, std::milli>(Clock::now() - slot.submitTime).count();
+    ++m_Stats.delivered;
+    m_Stats.lastLatencyFrames = static_cast<uint32_t>(newer);
+    m_Stats.lastLatencyMs = latencyMs;
+    m_LatencyMsTotal += latencyMs;
+    m_Stats.averageLatencyMs = static_cast<float>(m_LatencyMsTotal / m_Stats.delivered);
+
+    m_Held = index;
+    frame.view = view;
+    frame.frameIndex = slot.frameIndex;
+    return true;
+}
+
+void ReadbackRing::Release() {
+    if (m_Held == MAX_DEPTH) return;
+
+    m_Device->Unmap(m_Slots[m_Held].staging);
+    m_Held = MAX_DEPTH;
+}
+
+void ReadbackRing::Discard() {
+    Release();
+    for (uint32_t i = 0; i < m_Depth; ++i) {
+        m_Slots[i].queued = false;
+    }
+    m_Stats.inFlight = 0;
+}
+
+uint32_t ReadbackRing::OldestQueued() const {
+    uint32_t oldest = MAX_DEPTH;
+    for (uint32_t i = 0; i < m_Depth; ++i) {
+        if (m_Slots[i].queued && (oldest == MAX_DEPTH || m_Slots[i].frameIndex < m_Slots[oldest].frameIndex)) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
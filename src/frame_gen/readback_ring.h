@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * Readback Ring
+ *
+ * Brings captured frames to the CPU without stalling the render thread.
+ * Each frame is copied into the next of N staging copies, and a copy is
+ * only mapped once N - 1 newer ones have been queued behind it, by which
+ * time the GPU has normally finished it. Data arrives a few frames late;
+ * a copy that is still not ready is skipped for now, never waited on.
+ */
+
+#ifndef FIVEM_FRAMEGEN_READBACK_RING_H
+#define FIVEM_FRAMEGEN_READBACK_RING_H
+
+#include "staging_device.h"
+#include <chrono>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * A frame handed out by ReadbackRing::Acquire
+ */
+struct ReadbackFrame {
+    ConstImageView view;        // Mapped data, valid until Release
+    uint64_t frameIndex = 0;    // Submit count when it was captured
+};
+
+/**
+ * N-deep ring of readback copies over a staging device
+ */
+class ReadbackRing {
+public:
+    static constexpr uint32_t DEFAULT_DEPTH = 3;
+    static constexpr uint32_t MAX_DEPTH = 8;
+
+    struct Stats {
+        uint64_t submitted = 0;         // Copies queued
+        uint64_t delivered = 0;         // Copies mapped and handed out
+        uint64_t dropped = 0;           // Overwritten or failed before they were read
+        uint64_t notReady = 0;          // Due copies still in flight; a plain Map would have stalled
+        uint64_t stalls = 0;            // Blocking maps (Acquire with wait)
+        uint32_t inFlight = 0;          // Queued copies not yet handed out
+        uint32_t lastLatencyFrames = 0; // Submits between capture and delivery
+        float lastLatencyMs = 0.0f;
+        float averageLatencyMs = 0.0f;  // Over every delivered copy
+    };
+
+    ReadbackRing();
+    ~ReadbackRing();
+
+    ReadbackRing(const ReadbackRing&) = delete;
+    ReadbackRing& operator=(const ReadbackRing&) = delete;
+
+    /**
+     * Create the staging copies
+     *
+     * @param depth Copies in the ring (1 to MAX_DEPTH); frames arrive
+     *              depth - 1 submits after capture
+     */
+    bool Initialize(IStagingDevice* device, const StagingDesc& desc, uint32_t depth = DEFAULT_DEPTH);
+    void Shutdown();
+
+    /**
+     * Queue a copy of this frame's source resource
+     *
+     * @return False if the copy could not be queued; the frame held by
+     *         Acquire must be released first
+     */
+    bool Submit(void* source);
+
+    /**
+     * Map the oldest copy that is due
+     *
+     * @param wait Take the oldest queued copy even if it is not due yet,
+     *             blocking until the GPU has finished it
+     * @return True if a frame was mapped; hold at most one at a time
+     */
+    bool Acquire(ReadbackFrame& frame, bool wait = false);
+
+    /**
+     * Unmap the frame from Acquire
+     */
+    void Release();
+
+    /**
+     * Forget every queued copy, e.g. after a resize
+     */
+    void Discard();
+
+    bool IsInitialized() const { return m_Device != nullptr; }
+    uint32_t GetDepth() const { return m_Depth; }
+    const StagingDesc& GetDesc() const { return m_Desc; }
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        void* staging = nullptr;
+        uint64_t frameIndex = 0;
+        Clock::time_point submitTime;
+        bool queued = false;        // Holds a copy nobody has read
+    };
+
+    /**
+     * Slot with the oldest queued copy, or MAX_DEPTH if none
+     */
+    uint32_t OldestQueued() const;
+
+    IStagingDevice* m_Device = nullptr;
+    StagingDesc m_Desc;
+    Slot m_Slots[MAX_DEPTH];
+    uint32_t m_Depth = 0;
+    uint32_t m_Next = 0;
+    uint32_t m_Held = MAX_DEPTH;    // Slot mapped by Acquire, MAX_DEPTH if none
+    uint64_t m_Frame = 0;
+    double m_LatencyMsTotal = 0.0;
+    Stats m_Stats;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_READBACK_RING_H
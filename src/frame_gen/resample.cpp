@@ -0,0 +1,163 @@
+/**
+ * Resampling Kernels Implementation
+ */
+
+#include "resample.h"
+#include "sampling.h"
+#include "simd.h"
+
+#include <cmath>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+// Default guide luma difference at which taps start to drop out
+static constexpr float DEFAULT_RANGE_SIGMA = 24.0f;
+
+template <PixelFormat F>
+void DownsampleBox2x(const ConstFormatPlane<F>& src, const FormatPlane<F>& dst) {
+    using Storage = PixelStorage<F>;
+
+    for (uint32_t y = 0; y < dst.height; ++y) {
+        const Storage* row0 = src.Row(y * 2);
+        const Storage* row1 = src.Row(y * 2 + 1);
+        Storage* out = dst.Row(y);
+
+        uint32_t x = 0;
+#ifdef FIVEM_FRAMEGEN_SSE2
+        if constexpr (PixelTraits<F>::PACKED_8BIT) {
+            for (; x + 4 <= dst.width; x += 4) {
+                __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2));
+                __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2 + 4));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2));
+                __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2 + 4));
+                __m128 v0 = _mm_castsi128_ps(_mm_avg_epu8(a0, b0));
+                __m128 v1 = _mm_castsi128_ps(_mm_avg_epu8(a1, b1));
+                __m128i even = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+                __m128i odd = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_avg_epu8(even, odd));
+            }
+        }
+#endif
+        static constexpr uint32_t BOX[4] = { 1, 1, 1, 1 };
+        for (; x < dst.width; ++x) {
+            const Storage taps[4] = { row0[x * 2], row0[x * 2 + 1], row1[x * 2], row1[x * 2 + 1] };
+            out[x] = PixelTraits<F>::WeightedAverage(taps, BOX, 4);
+        }
+    }
+}
+
+EdgeGuidedUpsampler::EdgeGuidedUpsampler() {
+    SetRangeSigma(DEFAULT_RANGE_SIGMA);
+}
+
+EdgeGuidedUpsampler::~EdgeGuidedUpsampler() {
+    Shutdown();
+}
+
+bool EdgeGuidedUpsampler::Initialize(uint32_t width, uint32_t height) {
+    if (width < 2 || height < 2) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_GuideLuma.assign(static_cast<size_t>(width) * height, 0);
+    m_GuideLumaLow.assign(static_cast<size_t>(width / 2) * (height / 2), 0);
+
+    m_Initialized = true;
+    return true;
+}
+
+void EdgeGuidedUpsampler::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_GuideLuma.clear();
+    m_GuideLumaLow.clear();
+
+    m_Initialized = false;
+}
+
+void EdgeGuidedUpsampler::SetRangeSigma(float sigma) {
+    sigma = (std::max)(sigma, 1.0f);
+    for (int d = 0; d < 256; ++d) {
+        float x = d / sigma;
+        // Floor of 1 keeps the sum non-zero when every tap crosses an edge
+        m_RangeLut[d] = static_cast<uint16_t>((std::max)(1.0f, 256.0f * std::exp(-0.5f * x * x)));
+    }
+}
+
+template <PixelFormat F>
+void EdgeGuidedUpsampler::PrepareGuide(const ConstFormatPlane<F>& guide, uint32_t lowWidth, uint32_t lowHeight) {
+    for (uint32_t y = 0; y < m_Height; ++y) {
+        const PixelStorage<F>* in = guide.Row(y);
+        uint8_t* out = m_GuideLuma.data() + static_cast<size_t>(y) * m_Width;
+        for (uint32_t x = 0; x < m_Width; ++x) {
+            out[x] = static_cast<uint8_t>(PixelTraits<F>::Luma(in[x]));
+        }
+    }
+
+    // Guide luma at each low-res texel is the mean of its 2x2 footprint
+    for (uint32_t y = 0; y < lowHeight; ++y) {
+        const uint8_t* row0 = m_GuideLuma.data() + static_cast<size_t>(y * 2) * m_Width;
+        const uint8_t* row1 = row0 + m_Width;
+        uint8_t* out = m_GuideLumaLow.data() + static_cast<size_t>(y) * lowWidth;
+        for (uint32_t x = 0; x < lowWidth; ++x) {
+            out[x] = static_cast<uint8_t>((row0[x * 2] + row0[x * 2 + 1] + row1[x * 2] + row1[x * 2 + 1] + 2) >> 2);
+        }
+    }
+}
+
+template <PixelFormat F>
+void EdgeGuidedUpsampler::Upsample(const ConstFormatPlane<F>& lowRes, const ConstFormatPlane<F>& guide,
+                                   const FormatPlane<F>& output) {
+    using Storage = PixelStorage<F>;
+
+    if (!m_Initialized) return;
+    if (output.width != m_Width || output.height != m_Height ||
+        guide.width != m_Width || guide.height != m_Height ||
+        lowRes.width != m_Width / 2 || lowRes.height != m_Height / 2) {
+        return;
+    }
+
+    const uint32_t lowWidth = lowRes.width;
+    const uint32_t lowHeight = lowRes.height;
+    PrepareGuide<F>(guide, lowWidth, lowHeight);
+
+    for (uint32_t y = 0; y < m_Height; ++y) {
+        uint32_t ly0, ly1, wy;
+        Upsample2xTaps(y, lowHeight, ly0, ly1, wy);
+
+        const Storage* lowRow0 = lowRes.Row(ly0);
+        const Storage* lowRow1 = lowRes.Row(ly1);
+        const uint8_t* lumaRow0 = m_GuideLumaLow.data() + static_cast<size_t>(ly0) * lowWidth;
+        const uint8_t* lumaRow1 = m_GuideLumaLow.data() + static_cast<size_t>(ly1) * lowWidth;
+        const uint8_t* guideRow = m_GuideLuma.data() + static_cast<size_t>(y) * m_Width;
+        Storage* out = output.Row(y);
+
+        for (uint32_t x = 0; x < m_Width; ++x) {
+            uint32_t lx0, lx1, wx;
+            Upsample2xTaps(x, lowWidth, lx0, lx1, wx);
+
+            int g = guideRow[x];
+            const Storage taps[4] = { lowRow0[lx0], lowRow0[lx1], lowRow1[lx0], lowRow1[lx1] };
+            // Spatial weights (of 16) times range weights (of 256)
+            const uint32_t w[4] = {
+                wx * wy * m_RangeLut[std::abs(g - lumaRow0[lx0])],
+                (4 - wx) * wy * m_RangeLut[std::abs(g - lumaRow0[lx1])],
+                wx * (4 - wy) * m_RangeLut[std::abs(g - lumaRow1[lx0])],
+                (4 - wx) * (4 - wy) * m_RangeLut[std::abs(g - lumaRow1[lx1])]
+            };
+
+            out[x] = PixelTraits<F>::WeightedAverage(taps, w, w[0] + w[1] + w[2] + w[3]);
+        }
+    }
+}
+
+#define INSTANTIATE_RESAMPLE(format) \
+    template void DownsampleBox2x<format>(const ConstFormatPlane<format>&, const FormatPlane<format>&); \
+    template void EdgeGuidedUpsampler::Upsample<format>( \
+        const ConstFormatPlane<format>&, const ConstFormatPlane<format>&, const FormatPlane<format>&);
+FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(INSTANTIATE_RESAMPLE)
+#undef INSTANTIATE_RESAMPLE
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
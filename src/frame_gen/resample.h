@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * Resampling Kernels
+ *
+ * 2x down/up scaling used by the half-resolution interpolation path.
+ */
+
+#ifndef FIVEM_FRAMEGEN_RESAMPLE_H
+#define FIVEM_FRAMEGEN_RESAMPLE_H
+
+#include "pixel_format.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * 2x2 box downsample; dst must be (src.width / 2) x (src.height / 2)
+ */
+template <PixelFormat F>
+void DownsampleBox2x(const ConstFormatPlane<F>& src, const FormatPlane<F>& dst);
+
+/**
+ * Luma-edge-guided 2x upsampler
+ *
+ * Joint bilateral upsample of a half-resolution image: each output pixel
+ * takes the four nearest low-res taps, weighted by bilinear distance and by
+ * how closely the guide's luma at the tap matches the guide's luma at the
+ * pixel. Taps on the other side of an edge in the guide drop out, so edges
+ * stay sharp instead of being smeared by plain bilinear filtering.
+ */
+class EdgeGuidedUpsampler {
+public:
+    EdgeGuidedUpsampler();
+    ~EdgeGuidedUpsampler();
+
+    /**
+     * Allocate guide buffers for the full-resolution output size
+     */
+    bool Initialize(uint32_t width, uint32_t height);
+    void Shutdown();
+
+    /**
+     * Set the luma difference (0-255) at which a tap's weight falls to ~60%
+     */
+    void SetRangeSigma(float sigma);
+
+    /**
+     * Upsample lowRes into output using guide for edges
+     *
+     * @param lowRes Half-resolution image (output.width / 2 x output.height / 2)
+     * @param guide Full-resolution guide (the current real frame)
+     * @param output Full-resolution destination
+     */
+    template <PixelFormat F>
+    void Upsample(const ConstFormatPlane<F>& lowRes, const ConstFormatPlane<F>& guide, const FormatPlane<F>& output);
+
+private:
+    /**
+     * Extract guide luma at full and half resolution
+     */
+    template <PixelFormat F>
+    void PrepareGuide(const ConstFormatPlane<F>& guide, uint32_t lowWidth, uint32_t lowHeight);
+
+    std::vector<uint8_t> m_GuideLuma;       // Full resolution
+    std::vector<uint8_t> m_GuideLumaLow;    // Half resolution (2x2 mean)
+    uint16_t m_RangeLut[256] = {};          // Range weight by |luma difference|
+
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_RESAMPLE_H
@@ -0,0 +1,120 @@
+/**
+ * Resource Pool Implementation
+ */
+
+#include "resource_pool.h"
+#include "../utils/logger.h"
+
+#include <cstddef>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+ResourcePool::ResourcePool() = default;
+
+ResourcePool::~ResourcePool() {
+    Shutdown();
+}
+
+bool ResourcePool::Initialize(IResourceAllocator* allocator, uint32_t maxIdleFrames) {
+    if (!allocator) return false;
+
+    Shutdown();
+    m_Allocator = allocator;
+    m_MaxIdleFrames = maxIdleFrames;
+    return true;
+}
+
+void ResourcePool::Shutdown() {
+    if (!m_Allocator) return;
+
+    if (!m_InUse.empty()) {
+        Utils::Logger::Warn("Resource pool shut down with %zu resources in use", m_InUse.size());
+    }
+    for (const Entry& entry : m_InUse) {
+        Destroy(entry);
+    }
+    m_InUse.clear();
+    Trim();
+
+    m_Stats.inUse = 0;
+    m_Allocator = nullptr;
+}
+
+void* ResourcePool::Acquire(const ResourceDesc& desc) {
+    if (!m_Allocator) return nullptr;
+
+    // Newest first: it is the most likely to still be resident
+    for (size_t i = m_Idle.size(); i-- > 0;) {
+        if (m_Idle[i].desc == desc) {
+            Entry entry = m_Idle[i];
+            m_Idle.erase(m_Idle.begin() + static_cast<ptrdiff_t>(i));
+            m_InUse.push_back(entry);
+
+            m_Stats.reused++;
+            m_Stats.idle = static_cast<uint32_t>(m_Idle.size());
+            m_Stats.inUse = static_cast<uint32_t>(m_InUse.size());
+            return entry.resource;
+        }
+    }
+
+    void* resource = m_Allocator->Create(desc);
+    if (!resource) return nullptr;
+
+    m_InUse.push_back({ desc, resource, 0 });
+    m_Stats.created++;
+    m_Stats.inUse = static_cast<uint32_t>(m_InUse.size());
+    return resource;
+}
+
+void ResourcePool::Release(void* resource) {
+    if (!resource) return;
+
+    for (size_t i = 0; i < m_InUse.size(); ++i) {
+        if (m_InUse[i].resource == resource) {
+            Entry entry = m_InUse[i];
+            m_InUse[i] = m_InUse.back();
+            m_InUse.pop_back();
+
+            entry.releasedFrame = m_Frame;
+            m_Idle.push_back(entry);
+
+            m_Stats.idle = static_cast<uint32_t>(m_Idle.size());
+            m_Stats.inUse = static_cast<uint32_t>(m_InUse.size());
+            return;
+        }
+    }
+
+    Utils::Logger::Warn("Resource released to a pool that does not own it");
+}
+
+void ResourcePool::EndFrame() {
+    m_Frame++;
+
+    // Released in order, so the expired ones are at the front
+    size_t expired = 0;
+    while (expired < m_Idle.size() && m_Frame - m_Idle[expired].releasedFrame > m_MaxIdleFrames) {
+        Destroy(m_Idle[expired]);
+        expired++;
+    }
+    if (expired > 0) {
+        m_Idle.erase(m_Idle.begin(), m_Idle.begin() + static_cast<ptrdiff_t>(expired));
+        m_Stats.idle = static_cast<uint32_t>(m_Idle.size());
+    }
+}
+
+void ResourcePool::Trim() {
+    for (const Entry& entry : m_Idle) {
+        Destroy(entry);
+    }
+    m_Idle.clear();
+    m_Stats.idle = 0;
+}
+
+void ResourcePool::Destroy(const Entry& entry) {
+    m_Allocator->Destroy(entry.resource);
+    m_Stats.destroyed++;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * Resource Pool
+ *
+ * Keeps released GPU resources and hands them back out to requests with
+ * the same descriptor, so a Reset, a backend switch or a resolution round
+ * trip reuses allocations instead of freeing and recreating them. The
+ * core is API-neutral: resources are opaque handles made and destroyed by
+ * an allocator.
+ */
+
+#ifndef FIVEM_FRAMEGEN_RESOURCE_POOL_H
+#define FIVEM_FRAMEGEN_RESOURCE_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * What a pooled resource was created for; only exact matches are reused
+ */
+struct ResourceDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;        // API format enum (DXGI_FORMAT on D3D11)
+    uint32_t bindFlags = 0;     // API bind flags
+
+    bool operator==(const ResourceDesc&) const = default;
+};
+
+/**
+ * Creates and destroys the resources behind a pool
+ */
+class IResourceAllocator {
+public:
+    virtual ~IResourceAllocator() = default;
+
+    /**
+     * @return Opaque resource, or nullptr on failure
+     */
+    virtual void* Create(const ResourceDesc& desc) = 0;
+    virtual void Destroy(void* resource) = 0;
+};
+
+/**
+ * Descriptor-keyed free list over an allocator
+ *
+ * Released resources stay alive until they have been idle for
+ * maxIdleFrames calls to EndFrame, or until Trim or Shutdown.
+ */
+class ResourcePool {
+public:
+    // About five seconds at 60 FPS: long enough for alt-tab and mode round trips
+    static constexpr uint32_t DEFAULT_MAX_IDLE_FRAMES = 300;
+
+    struct Stats {
+        uint64_t created = 0;       // Allocator Create calls
+        uint64_t destroyed = 0;     // Allocator Destroy calls
+        uint64_t reused = 0;        // Requests served from the free list
+        uint32_t inUse = 0;
+        uint32_t idle = 0;
+    };
+
+    ResourcePool();
+    ~ResourcePool();
+
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    bool Initialize(IResourceAllocator* allocator, uint32_t maxIdleFrames = DEFAULT_MAX_IDLE_FRAMES);
+
+    /**
+     * Destroy every resource, including any still handed out
+     */
+    void Shutdown();
+
+    /**
+     * Take an idle resource matching the descriptor, or create one
+     */
+    void* Acquire(const ResourceDesc& desc);
+
+    /**
+     * Return a resource from Acquire to the free list
+     */
+    void Release(void* resource);
+
+    /**
+     * Age idle resources and destroy those past the idle limit; call once per frame
+     */
+    void EndFrame();
+
+    /**
+     * Destroy every idle resource
+     */
+    void Trim();
+
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    struct Entry {
+        ResourceDesc desc;
+        void* resource = nullptr;
+        uint64_t releasedFrame = 0;
+    };
+
+    void Destroy(const Entry& entry);
+
+    IResourceAllocator* m_Allocator = nullptr;
+    std::vector<Entry> m_InUse;
+    std::vector<Entry> m_Idle;      // Most recently released last
+    uint64_t m_Frame = 0;
+    uint32_t m_MaxIdleFrames = DEFAULT_MAX_IDLE_FRAMES;
+    Stats m_Stats;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_RESOURCE_POOL_H
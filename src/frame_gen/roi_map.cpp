@@ -0,0 +1,170 @@
+/**
+ * Region-of-Interest Map Implementation
+ */
+
+#include "roi_map.h"
+
+#include <bit>
+#include <cmath>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace {
+
+float SmoothStep(float edge, float x) {
+    float t = std::clamp(x / edge, 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+uint64_t MixKey(uint64_t key, float value) {
+    return (key ^ std::bit_cast<uint32_t>(value)) * 0x9E3779B97F4A7C15ull;
+}
+
+} // namespace
+
+RoiMap::RoiMap() = default;
+
+RoiMap::~RoiMap() {
+    Shutdown();
+}
+
+bool RoiMap::Initialize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_Initialized = true;
+
+    // Shapes set before Initialize are rasterized now
+    Rebuild();
+    return true;
+}
+
+void RoiMap::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Weights.clear();
+    m_Weights.shrink_to_fit();
+    m_Tiers.clear();
+    m_Tiers.shrink_to_fit();
+
+    m_Initialized = false;
+}
+
+void RoiMap::SetEllipse(float radiusX, float radiusY, float feather) {
+    m_Shape = Shape::Ellipse;
+    m_RadiusX = (std::max)(radiusX, 1e-3f);
+    m_RadiusY = (std::max)(radiusY, 1e-3f);
+    m_Feather = (std::max)(feather, 0.0f);
+    m_RectCount = 0;
+    Rebuild();
+}
+
+void RoiMap::SetRectangles(const Rect* rects, uint32_t count, float feather) {
+    m_RectCount = (std::min)(count, MAX_RECTS);
+    if (!rects || m_RectCount == 0) {
+        Disable();
+        return;
+    }
+
+    m_Shape = Shape::Rectangles;
+    m_Feather = (std::max)(feather, 0.0f);
+    for (uint32_t i = 0; i < m_RectCount; ++i) {
+        m_Rects[i] = rects[i];
+    }
+    Rebuild();
+}
+
+void RoiMap::Disable() {
+    m_Shape = Shape::None;
+    m_RectCount = 0;
+    Rebuild();
+}
+
+void RoiMap::SetShape(const RoiMap& other) {
+    m_Shape = other.m_Shape;
+    m_RadiusX = other.m_RadiusX;
+    m_RadiusY = other.m_RadiusY;
+    m_Feather = other.m_Feather;
+    m_RectCount = other.m_RectCount;
+    for (uint32_t i = 0; i < m_RectCount; ++i) {
+        m_Rects[i] = other.m_Rects[i];
+    }
+    Rebuild();
+}
+
+float RoiMap::Evaluate(float u, float v) const {
+    float dist;
+    if (m_Shape == Shape::Ellipse) {
+        // Radial distance past the ellipse edge
+        float px = u - 0.5f, py = v - 0.5f;
+        float d = (std::max)(std::hypot(px / m_RadiusX, py / m_RadiusY), 1e-5f);
+        dist = std::hypot(px, py) * (1.0f - 1.0f / d);
+    } else {
+        dist = 1e5f;
+        for (uint32_t i = 0; i < m_RectCount; ++i) {
+            const Rect& r = m_Rects[i];
+            float halfW = (r.x1 - r.x0) * 0.5f, halfH = (r.y1 - r.y0) * 0.5f;
+            float ox = (std::max)(std::fabs(u - (r.x0 + halfW)) - halfW, 0.0f);
+            float oy = (std::max)(std::fabs(v - (r.y0 + halfH)) - halfH, 0.0f);
+            dist = (std::min)(dist, std::hypot(ox, oy));
+        }
+    }
+    return dist <= 0.0f ? 1.0f : 1.0f - SmoothStep((std::max)(m_Feather, 1e-5f), dist);
+}
+
+void RoiMap::Rebuild() {
+    m_Key = 0;
+    m_OutsideTiles = 0;
+    m_TransitionTiles = 0;
+    if (m_Shape == Shape::None) {
+        m_Weights.clear();
+        m_Tiers.clear();
+        return;
+    }
+
+    m_Key = MixKey(static_cast<uint64_t>(m_Shape), m_Feather);
+    m_Key = MixKey(MixKey(m_Key, m_RadiusX), m_RadiusY);
+    for (uint32_t i = 0; i < m_RectCount; ++i) {
+        const Rect& r = m_Rects[i];
+        m_Key = MixKey(MixKey(MixKey(MixKey(m_Key, r.x0), r.y0), r.x1), r.y1);
+    }
+
+    if (!m_Initialized) return;
+
+    m_Weights.resize(static_cast<size_t>(m_Width) * m_Height);
+    for (uint32_t y = 0; y < m_Height; ++y) {
+        uint8_t* row = m_Weights.data() + static_cast<size_t>(y) * m_Width;
+        const float v = (y + 0.5f) / m_Height;
+        for (uint32_t x = 0; x < m_Width; ++x) {
+            row[x] = static_cast<uint8_t>(Evaluate((x + 0.5f) / m_Width, v) * 255.0f + 0.5f);
+        }
+    }
+
+    m_Tiers.resize(static_cast<size_t>(m_TilesX) * m_TilesY);
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            const uint32_t x0 = tx * TILE_SIZE;
+            const uint32_t x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+            uint8_t lo = 255, hi = 0;
+            for (uint32_t y = ty * TILE_SIZE; y < (std::min)((ty + 1) * TILE_SIZE, m_Height); ++y) {
+                const uint8_t* row = GetWeightRow(y);
+                for (uint32_t x = x0; x < x1; ++x) {
+                    lo = (std::min)(lo, row[x]);
+                    hi = (std::max)(hi, row[x]);
+                }
+            }
+
+            RoiTier tier = lo == 255 ? RoiTier::Inside : hi == 0 ? RoiTier::Outside : RoiTier::Transition;
+            m_Tiers[static_cast<size_t>(ty) * m_TilesX + tx] = tier;
+            m_OutsideTiles += tier == RoiTier::Outside;
+            m_TransitionTiles += tier == RoiTier::Transition;
+        }
+    }
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * Region-of-Interest Map
+ *
+ * Per-pixel quality weights for foveated interpolation: full-quality
+ * warping inside a screen region, a cheap path outside it, and a feathered
+ * band between them. Mirrors RoiWeight in g_InterpolationPS.
+ */
+
+#ifndef FIVEM_FRAMEGEN_ROI_MAP_H
+#define FIVEM_FRAMEGEN_ROI_MAP_H
+
+#include "tile_classifier.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Quality tier of a tile
+ */
+enum class RoiTier : uint8_t {
+    Outside = 0,        // Cheap path only
+    Transition = 1,     // Both paths, blended by the per-pixel weight
+    Inside = 2          // Full quality only
+};
+
+/**
+ * Screen-space focus region rasterized to per-pixel weights and per-tile tiers
+ *
+ * Shapes are in fractions of the screen, so the same settings apply at any
+ * resolution (including the half-resolution engine). The map is rebuilt
+ * only when the shape or the frame size changes.
+ */
+class RoiMap {
+public:
+    static constexpr uint32_t TILE_SIZE = TileClassifier::TILE_SIZE;
+    static constexpr uint32_t MAX_RECTS = 4;
+
+    /**
+     * Rectangle in screen fractions, [x0, x1) x [y0, y1)
+     */
+    struct Rect {
+        float x0, y0, x1, y1;
+    };
+
+    RoiMap();
+    ~RoiMap();
+
+    bool Initialize(uint32_t width, uint32_t height);
+    void Shutdown();
+
+    /**
+     * Full quality inside an ellipse around the screen centre
+     *
+     * @param radiusX Half-width as a fraction of the screen width
+     * @param radiusY Half-height as a fraction of the screen height
+     * @param feather Transition width past the edge, in screen fractions
+     */
+    void SetEllipse(float radiusX, float radiusY, float feather);
+
+    /**
+     * Full quality inside the union of up to MAX_RECTS rectangles
+     */
+    void SetRectangles(const Rect* rects, uint32_t count, float feather);
+
+    /**
+     * Full quality everywhere (default)
+     */
+    void Disable();
+
+    /**
+     * Take another map's shape, rasterized at this map's size
+     */
+    void SetShape(const RoiMap& other);
+
+    bool IsEnabled() const { return m_Shape != Shape::None; }
+
+    RoiTier GetTier(uint32_t tx, uint32_t ty) const {
+        return IsEnabled() ? m_Tiers[static_cast<size_t>(ty) * m_TilesX + tx] : RoiTier::Inside;
+    }
+
+    /**
+     * Full-quality weight of a row (0 = cheap, 255 = full)
+     */
+    const uint8_t* GetWeightRow(uint32_t y) const {
+        return m_Weights.data() + static_cast<size_t>(y) * m_Width;
+    }
+
+    /**
+     * Tile counts of the current map
+     */
+    uint32_t GetOutsideTileCount() const { return m_OutsideTiles; }
+    uint32_t GetTransitionTileCount() const { return m_TransitionTiles; }
+
+    /**
+     * Hash of the shape, for caches keyed on settings (0 when disabled)
+     */
+    uint64_t GetKey() const { return m_Key; }
+
+private:
+    enum class Shape : uint8_t {
+        None,
+        Ellipse,
+        Rectangles
+    };
+
+    /**
+     * Weight at a point in screen fractions (0-1)
+     */
+    float Evaluate(float u, float v) const;
+
+    /**
+     * Rasterize weights and tiers for the current shape
+     */
+    void Rebuild();
+
+    Shape m_Shape = Shape::None;
+    float m_RadiusX = 0.0f;
+    float m_RadiusY = 0.0f;
+    float m_Feather = 0.0f;
+    Rect m_Rects[MAX_RECTS] = {};
+    uint32_t m_RectCount = 0;
+    uint64_t m_Key = 0;
+
+    std::vector<uint8_t> m_Weights;     // Per pixel
+    std::vector<RoiTier> m_Tiers;       // Per tile
+    uint32_t m_OutsideTiles = 0;
+    uint32_t m_TransitionTiles = 0;
+
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    uint32_t m_TilesX = 0;
+    uint32_t m_TilesY = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_ROI_MAP_H
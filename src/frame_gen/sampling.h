@@ -0,0 +1,332 @@
+#pragma once
+
+/**
+ * CPU Sampling Helpers
+ *
+ * Filtered fetches for the software warp, per pixel format: bilinear, plus
+ * separable 4x4 Catmull-Rom and Lanczos-2 driven by compile-time weight
+ * tables indexed by the fractional sample position.
+ */
+
+#ifndef FIVEM_FRAMEGEN_SAMPLING_H
+#define FIVEM_FRAMEGEN_SAMPLING_H
+
+#include "const_math.h"
+#include "pixel_format.h"
+#include "simd.h"
+#include "tiled_plane.h"
+#include <array>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Reconstruction filter for warp fetches
+ */
+enum class WarpFilter : uint8_t {
+    Bilinear = 0,       // 2x2, matches the GPU linear sampler
+    CatmullRom = 1,     // 4x4 bicubic, a = -0.5
+    Lanczos2 = 2        // 4x4 windowed sinc, sharpest, slight ringing
+};
+
+inline const char* GetWarpFilterName(WarpFilter filter) {
+    switch (filter) {
+        case WarpFilter::Bilinear: return "Bilinear";
+        case WarpFilter::CatmullRom: return "Catmull-Rom";
+        case WarpFilter::Lanczos2: return "Lanczos-2";
+    }
+    return "Unknown";
+}
+
+namespace FilterTable {
+
+// Fractional positions per texel; one extra row so rounding up needs no wrap
+static constexpr uint32_t PHASE_BITS = 6;
+static constexpr uint32_t PHASES = 1u << PHASE_BITS;
+
+// Taps of each phase sum to WEIGHT_ONE (negative lobes included)
+static constexpr uint32_t WEIGHT_BITS = 8;
+static constexpr int32_t WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+using Table = std::array<std::array<int16_t, 4>, PHASES + 1>;
+
+namespace Detail {
+
+constexpr double Abs(double x) { return x < 0.0 ? -x : x; }
+
+constexpr double CatmullRom(double x) {
+    x = Abs(x);
+    if (x < 1.0) return 1.5 * x * x * x - 2.5 * x * x + 1.0;
+    if (x < 2.0) return -0.5 * x * x * x + 2.5 * x * x - 4.0 * x + 2.0;
+    return 0.0;
+}
+
+constexpr double Lanczos2(double x) {
+    return Abs(x) < 2.0 ? ConstMath::Sinc(x) * ConstMath::Sinc(x * 0.5) : 0.0;
+}
+
+/**
+ * Quantise the four taps at distances 1 + f, f, 1 - f, 2 - f; the centre
+ * taps absorb the rounding residue so every phase sums exactly to WEIGHT_ONE
+ */
+template <typename Kernel>
+constexpr Table MakeTable(Kernel kernel) {
+    Table table = {};
+    for (uint32_t p = 0; p <= PHASES; ++p) {
+        double f = static_cast<double>(p) / PHASES;
+        double w[4] = { kernel(1.0 + f), kernel(f), kernel(1.0 - f), kernel(2.0 - f) };
+        double sum = w[0] + w[1] + w[2] + w[3];
+
+        int32_t total = 0;
+        for (int i = 0; i < 4; ++i) {
+            double scaled = w[i] / sum * WEIGHT_ONE;
+            table[p][i] = static_cast<int16_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+            total += table[p][i];
+        }
+        table[p][f < 0.5 ? 1 : 2] = static_cast<int16_t>(table[p][f < 0.5 ? 1 : 2] + WEIGHT_ONE - total);
+    }
+    return table;
+}
+
+} // namespace Detail
+
+inline constexpr Table CatmullRom = Detail::MakeTable(Detail::CatmullRom);
+inline constexpr Table Lanczos2 = Detail::MakeTable(Detail::Lanczos2);
+
+static_assert(CatmullRom[0][1] == WEIGHT_ONE && CatmullRom[0][0] == 0, "Catmull-Rom interpolates");
+static_assert(Lanczos2[0][1] == WEIGHT_ONE && Lanczos2[PHASES][2] == WEIGHT_ONE, "Lanczos-2 interpolates");
+
+template <WarpFilter Filter>
+constexpr const Table& Get() {
+    static_assert(Filter != WarpFilter::Bilinear, "bilinear uses SampleBilinear");
+    if constexpr (Filter == WarpFilter::CatmullRom) {
+        return CatmullRom;
+    } else {
+        return Lanczos2;
+    }
+}
+
+} // namespace FilterTable
+
+/**
+ * Row of a linear source plane
+ *
+ * The fetches below index rows through these accessors so the same code
+ * reads linear and tiled planes. Run4 returns four contiguous texels
+ * starting at x, or nullptr when the layout cannot provide them.
+ */
+template <typename T>
+struct LinearRow {
+    const T* texels;
+
+    const T& operator[](int x) const { return texels[x]; }
+    const T* Run4(int x) const { return texels + x; }
+};
+
+/**
+ * Row of a tiled source plane; runs are contiguous only within a tile
+ */
+template <typename T>
+struct TiledRow {
+    const T* base;
+
+    const T& operator[](int x) const { return base[TiledPlane<const T>::TexelOffset(static_cast<uint32_t>(x))]; }
+    const T* Run4(int x) const {
+        return (static_cast<uint32_t>(x) & TiledPlane<const T>::TILE_MASK) <= TiledPlane<const T>::TILE_SIZE - 4
+            ? &(*this)[x] : nullptr;
+    }
+};
+
+template <typename T>
+inline LinearRow<std::remove_const_t<T>> SourceRow(const Plane<T>& plane, uint32_t y) {
+    return { plane.Row(y) };
+}
+
+template <typename T>
+inline TiledRow<std::remove_const_t<T>> SourceRow(const TiledPlane<T>& plane, uint32_t y) {
+    return { plane.RowBase(y) };
+}
+
+template <PixelFormat F>
+using ConstTiledFormatPlane = TiledPlane<const PixelStorage<F>>;
+
+/**
+ * Bilinear fetch with edge clamping
+ *
+ * Coordinates are in pixels with texel centres at +0.5, matching the
+ * D3D11 linear sampler with CLAMP addressing.
+ */
+template <PixelFormat F, typename Source = ConstFormatPlane<F>>
+inline PixelStorage<F> SampleBilinear(const Source& plane, float x, float y) {
+    using Traits = PixelTraits<F>;
+
+    float fx = x - 0.5f;
+    float fy = y - 0.5f;
+    int x0 = static_cast<int>(fx < 0.0f ? fx - 1.0f : fx);
+    int y0 = static_cast<int>(fy < 0.0f ? fy - 1.0f : fy);
+
+    // 8-bit fractional weights
+    uint32_t ax = static_cast<uint32_t>((fx - x0) * 256.0f);
+    uint32_t ay = static_cast<uint32_t>((fy - y0) * 256.0f);
+
+    int maxX = static_cast<int>(plane.width) - 1;
+    int maxY = static_cast<int>(plane.height) - 1;
+    int x1 = std::clamp(x0 + 1, 0, maxX);
+    int y1 = std::clamp(y0 + 1, 0, maxY);
+    x0 = std::clamp(x0, 0, maxX);
+    y0 = std::clamp(y0, 0, maxY);
+
+    const auto row0 = SourceRow(plane, static_cast<uint32_t>(y0));
+    const auto row1 = SourceRow(plane, static_cast<uint32_t>(y1));
+    PixelStorage<F> top = Traits::Lerp(row0[x0], row0[x1], ax);
+    PixelStorage<F> bot = Traits::Lerp(row1[x0], row1[x1], ax);
+    return Traits::Lerp(top, bot, ay);
+}
+
+/**
+ * Separable 4x4 fetch with edge clamping
+ *
+ * Same texel-centre convention as SampleBilinear. 8-bit formats filter
+ * rows then columns in 16-bit fixed point with SSE2 multiply-adds; the
+ * others go through float channels (alpha from the nearest texel).
+ * Overshoot from the negative lobes is clamped to the format's range.
+ */
+template <PixelFormat F, typename Source = ConstFormatPlane<F>>
+inline PixelStorage<F> SampleSeparable4(const Source& plane, float x, float y,
+                                         const FilterTable::Table& table) {
+    using Traits = PixelTraits<F>;
+    using Storage = PixelStorage<F>;
+
+    float fx = x - 0.5f;
+    float fy = y - 0.5f;
+    int x0 = static_cast<int>(fx < 0.0f ? fx - 1.0f : fx);
+    int y0 = static_cast<int>(fy < 0.0f ? fy - 1.0f : fy);
+    const int16_t* wx = table[static_cast<uint32_t>((fx - x0) * FilterTable::PHASES + 0.5f)].data();
+    const int16_t* wy = table[static_cast<uint32_t>((fy - y0) * FilterTable::PHASES + 0.5f)].data();
+
+    const int maxX = static_cast<int>(plane.width) - 1;
+    const int maxY = static_cast<int>(plane.height) - 1;
+    const bool interiorX = x0 >= 1 && x0 + 2 <= maxX;
+    int cols[4];
+    for (int i = 0; i < 4; ++i) {
+        cols[i] = std::clamp(x0 - 1 + i, 0, maxX);
+    }
+    using Row = decltype(SourceRow(plane, 0));
+    Row rows[4] = {
+        SourceRow(plane, static_cast<uint32_t>(std::clamp(y0 - 1, 0, maxY))),
+        SourceRow(plane, static_cast<uint32_t>(std::clamp(y0, 0, maxY))),
+        SourceRow(plane, static_cast<uint32_t>(std::clamp(y0 + 1, 0, maxY))),
+        SourceRow(plane, static_cast<uint32_t>(std::clamp(y0 + 2, 0, maxY)))
+    };
+
+    if constexpr (Traits::PACKED_8BIT) {
+#ifdef FIVEM_FRAMEGEN_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi32(FilterTable::WEIGHT_ONE / 2);
+        auto weightPair = [](int16_t a, int16_t b) {
+            return _mm_set1_epi32(static_cast<int>(static_cast<uint16_t>(a) | (static_cast<uint32_t>(static_cast<uint16_t>(b)) << 16)));
+        };
+        const __m128i wx02 = weightPair(wx[0], wx[2]);
+        const __m128i wx13 = weightPair(wx[1], wx[3]);
+
+        // Horizontal pass: four int32 channel sums per row
+        __m128i h[4];
+        for (int j = 0; j < 4; ++j) {
+            const Storage* run = interiorX ? rows[j].Run4(x0 - 1) : nullptr;
+            __m128i texels = run
+                ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(run))
+                : _mm_setr_epi32(static_cast<int>(rows[j][cols[0]]), static_cast<int>(rows[j][cols[1]]),
+                                 static_cast<int>(rows[j][cols[2]]), static_cast<int>(rows[j][cols[3]]));
+            __m128i lo = _mm_unpacklo_epi8(texels, zero);   // texels 0, 1
+            __m128i hi = _mm_unpackhi_epi8(texels, zero);   // texels 2, 3
+            __m128i sum = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(lo, hi), wx02),
+                                        _mm_madd_epi16(_mm_unpackhi_epi16(lo, hi), wx13));
+            h[j] = _mm_srai_epi32(_mm_add_epi32(sum, round), FilterTable::WEIGHT_BITS);
+        }
+
+        // Vertical pass on the row results, interleaved the same way
+        const __m128i wy01 = weightPair(wy[0], wy[1]);
+        const __m128i wy23 = weightPair(wy[2], wy[3]);
+        __m128i rows02 = _mm_packs_epi32(h[0], h[2]);
+        __m128i rows13 = _mm_packs_epi32(h[1], h[3]);
+        __m128i sum = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(rows02, rows13), wy01),
+                                    _mm_madd_epi16(_mm_unpackhi_epi16(rows02, rows13), wy23));
+        sum = _mm_srai_epi32(_mm_add_epi32(sum, round), FilterTable::WEIGHT_BITS);
+        sum = _mm_packs_epi32(sum, sum);
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum)));
+#else
+        (void)interiorX;
+        uint32_t result = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            int32_t column = 0;
+            for (int j = 0; j < 4; ++j) {
+                int32_t row = 0;
+                for (int i = 0; i < 4; ++i) {
+                    row += wx[i] * static_cast<int32_t>((rows[j][cols[i]] >> shift) & 0xFF);
+                }
+                column += wy[j] * ((row + FilterTable::WEIGHT_ONE / 2) >> FilterTable::WEIGHT_BITS);
+            }
+            column = (column + FilterTable::WEIGHT_ONE / 2) >> FilterTable::WEIGHT_BITS;
+            result |= static_cast<uint32_t>(std::clamp(column, 0, 255)) << shift;
+        }
+        return result;
+#endif
+    } else {
+        (void)interiorX;
+        constexpr float SCALE = 1.0f / (FilterTable::WEIGHT_ONE * FilterTable::WEIGHT_ONE);
+        float rgb[3] = {};
+        for (int j = 0; j < 4; ++j) {
+            float row[3] = {};
+            for (int i = 0; i < 4; ++i) {
+                float texel[3];
+                Traits::GetChannels(rows[j][cols[i]], texel);
+                for (int c = 0; c < 3; ++c) row[c] += wx[i] * texel[c];
+            }
+            for (int c = 0; c < 3; ++c) rgb[c] += wy[j] * row[c];
+        }
+        for (int c = 0; c < 3; ++c) rgb[c] *= SCALE;
+
+        const int nearestX = cols[wx[1] >= wx[2] ? 1 : 2];
+        const Row& nearestRow = rows[wy[1] >= wy[2] ? 1 : 2];
+        return Traits::SetChannels(rgb, nearestRow[nearestX]);
+    }
+}
+
+/**
+ * Warp fetch with the filter fixed at compile time, from a linear or a
+ * tiled plane
+ */
+template <PixelFormat F, WarpFilter Filter, typename Source = ConstFormatPlane<F>>
+inline PixelStorage<F> SampleWarp(const Source& plane, float x, float y) {
+    if constexpr (Filter == WarpFilter::Bilinear) {
+        return SampleBilinear<F, Source>(plane, x, y);
+    } else {
+        return SampleSeparable4<F, Source>(plane, x, y, FilterTable::Get<Filter>());
+    }
+}
+
+/**
+ * 2x bilinear upsample taps along one axis
+ *
+ * Maps a fine index to its two coarse neighbours and the weight (out of 4)
+ * of the first one; the second gets 4 - w0.
+ */
+inline void Upsample2xTaps(uint32_t fine, uint32_t coarseSize, uint32_t& c0, uint32_t& c1, uint32_t& w0) {
+    uint32_t k = (std::min)(fine >> 1, coarseSize - 1);
+    if (fine & 1) {
+        // Coarse position k + 0.25
+        c0 = k;
+        c1 = (std::min)(k + 1, coarseSize - 1);
+        w0 = 3;
+    } else {
+        // Coarse position k - 0.25
+        c0 = k > 0 ? k - 1 : 0;
+        c1 = k;
+        w0 = 1;
+    }
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_SAMPLING_H
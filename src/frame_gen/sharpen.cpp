@@ -0,0 +1,202 @@
+/**
+ * Contrast-Adaptive Sharpening Implementation
+ */
+
+#include "sharpen.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+// Keeps the limiter's divisions finite on pure black/white crosses (fraction of PEAK)
+static constexpr float LIMITER_EPSILON = 1.0f / 65536.0f;
+
+/**
+ * Sharpen one pixel from its cross: b = up, d = left, e = centre, f = right, h = down
+ */
+template <PixelFormat F>
+static inline PixelStorage<F> SharpenPixel(PixelStorage<F> b, PixelStorage<F> d, PixelStorage<F> e,
+                                           PixelStorage<F> f, PixelStorage<F> h, float sharpness) {
+    using Traits = PixelTraits<F>;
+    constexpr float PEAK = Traits::PEAK;
+    constexpr float EPSILON = PEAK * LIMITER_EPSILON;
+
+    // ch[tap][channel], taps ordered b, d, f, h, e
+    float ch[5][3];
+    Traits::GetChannels(b, ch[0]);
+    Traits::GetChannels(d, ch[1]);
+    Traits::GetChannels(f, ch[2]);
+    Traits::GetChannels(h, ch[3]);
+    Traits::GetChannels(e, ch[4]);
+
+    float lobe = -ContrastAdaptiveSharpener::LOBE_LIMIT;
+    for (int c = 0; c < 3; ++c) {
+        float mn4 = (std::min)((std::min)(ch[0][c], ch[1][c]), (std::min)(ch[2][c], ch[3][c]));
+        float mx4 = (std::max)((std::max)(ch[0][c], ch[1][c]), (std::max)(ch[2][c], ch[3][c]));
+        float center = ch[4][c];
+
+        // Largest negative lobe that keeps this channel inside [0, PEAK]
+        float hitMin = (std::min)(mn4, center) / (4.0f * mx4 + EPSILON);
+        float hitMax = (PEAK - (std::max)(mx4, center)) / (4.0f * mn4 - 4.0f * PEAK - EPSILON);
+        lobe = (std::max)(lobe, (std::max)(-hitMin, hitMax));
+    }
+
+    lobe = (std::min)(lobe, 0.0f) * sharpness;
+    float rcp = 1.0f / (4.0f * lobe + 1.0f);
+
+    float rgb[3];
+    for (int c = 0; c < 3; ++c) {
+        rgb[c] = (lobe * (ch[0][c] + ch[1][c] + ch[2][c] + ch[3][c]) + ch[4][c]) * rcp;
+    }
+    return Traits::SetChannels(rgb, e);
+}
+
+#ifdef FIVEM_FRAMEGEN_SSE2
+static inline __m128 Channel(__m128i pixels, int shift) {
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(0xFF)));
+}
+
+/**
+ * SharpenPixel for four adjacent pixels of a byte-per-channel format
+ */
+static inline __m128i SharpenPixels4(const uint32_t* up, const uint32_t* center, const uint32_t* down,
+                                     __m128 sharpness) {
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(center - 1));
+    __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(center));
+    __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(center + 1));
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down));
+
+    const __m128 four = _mm_set1_ps(4.0f);
+    const __m128 eps = _mm_set1_ps(255.0f * LIMITER_EPSILON);
+    __m128 ch[3][5];
+    __m128 lobe = _mm_set1_ps(-ContrastAdaptiveSharpener::LOBE_LIMIT);
+
+    for (int c = 0; c < 3; ++c) {
+        ch[c][0] = Channel(b, c * 8);
+        ch[c][1] = Channel(d, c * 8);
+        ch[c][2] = Channel(f, c * 8);
+        ch[c][3] = Channel(h, c * 8);
+        ch[c][4] = Channel(e, c * 8);
+        __m128 mn4 = _mm_min_ps(_mm_min_ps(ch[c][0], ch[c][1]), _mm_min_ps(ch[c][2], ch[c][3]));
+        __m128 mx4 = _mm_max_ps(_mm_max_ps(ch[c][0], ch[c][1]), _mm_max_ps(ch[c][2], ch[c][3]));
+
+        __m128 hitMin = _mm_div_ps(_mm_min_ps(mn4, ch[c][4]), _mm_add_ps(_mm_mul_ps(four, mx4), eps));
+        __m128 hitMax = _mm_div_ps(
+            _mm_sub_ps(_mm_set1_ps(255.0f), _mm_max_ps(mx4, ch[c][4])),
+            _mm_sub_ps(_mm_mul_ps(four, mn4), _mm_set1_ps(1020.0f + 255.0f * LIMITER_EPSILON)));
+        __m128 negHitMin = _mm_sub_ps(_mm_setzero_ps(), hitMin);
+        lobe = _mm_max_ps(lobe, _mm_max_ps(negHitMin, hitMax));
+    }
+
+    lobe = _mm_mul_ps(_mm_min_ps(lobe, _mm_setzero_ps()), sharpness);
+    __m128 rcp = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_mul_ps(four, lobe), _mm_set1_ps(1.0f)));
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128i result = _mm_and_si128(e, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+    for (int c = 0; c < 3; ++c) {
+        __m128 sum = _mm_add_ps(_mm_add_ps(ch[c][0], ch[c][1]), _mm_add_ps(ch[c][2], ch[c][3]));
+        __m128 v = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(lobe, sum), ch[c][4]), rcp);
+        v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+        result = _mm_or_si128(result, _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(v, half)), c * 8));
+    }
+    return result;
+}
+#endif
+
+ContrastAdaptiveSharpener::ContrastAdaptiveSharpener() = default;
+
+ContrastAdaptiveSharpener::~ContrastAdaptiveSharpener() {
+    Shutdown();
+}
+
+bool ContrastAdaptiveSharpener::Initialize(uint32_t width, PixelFormat format) {
+    if (width == 0) return false;
+
+    m_Width = width;
+    m_Format = format;
+    m_RowPrev.assign(static_cast<size_t>(width) * BytesPerPixel(format), 0);
+    m_RowCurr.assign(static_cast<size_t>(width) * BytesPerPixel(format), 0);
+
+    m_Initialized = true;
+    return true;
+}
+
+void ContrastAdaptiveSharpener::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_RowPrev.clear();
+    m_RowPrev.shrink_to_fit();
+    m_RowCurr.clear();
+    m_RowCurr.shrink_to_fit();
+
+    m_Initialized = false;
+}
+
+template <PixelFormat F>
+void ContrastAdaptiveSharpener::Apply(const FormatPlane<F>& image, float sharpness) {
+    using Storage = PixelStorage<F>;
+    if (!m_Initialized || F != m_Format || !image.IsValid() || image.width > m_Width) return;
+
+    sharpness = std::clamp(sharpness, 0.0f, 1.0f);
+    if (sharpness <= 0.0f) return;
+
+    const size_t rowBytes = image.width * sizeof(Storage);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        // Keep the unsharpened row; the next row still needs it as its "up"
+        std::memcpy(m_RowCurr.data(), image.Row(y), rowBytes);
+
+        const Storage* center = reinterpret_cast<const Storage*>(m_RowCurr.data());
+        const Storage* up = y > 0 ? reinterpret_cast<const Storage*>(m_RowPrev.data()) : center;
+        const Storage* down = y + 1 < image.height ? image.Row(y + 1) : center;
+        SharpenRow<F>(up, center, down, image.Row(y), image.width, sharpness);
+
+        m_RowPrev.swap(m_RowCurr);
+    }
+}
+
+template <PixelFormat F>
+void ContrastAdaptiveSharpener::SharpenRow(const PixelStorage<F>* up, const PixelStorage<F>* center,
+                                           const PixelStorage<F>* down, PixelStorage<F>* out,
+                                           uint32_t width, float sharpness) const {
+    if (width == 1) {
+        out[0] = SharpenPixel<F>(up[0], center[0], center[0], center[0], down[0], sharpness);
+        return;
+    }
+
+    // Edge columns reuse the centre for the missing neighbour
+    out[0] = SharpenPixel<F>(up[0], center[0], center[0], center[1], down[0], sharpness);
+
+    uint32_t x = 1;
+#ifdef FIVEM_FRAMEGEN_SSE2
+    if constexpr (PixelTraits<F>::PACKED_8BIT) {
+        // Eight pixels per iteration; two independent chains keep the dividers busy
+        const __m128 sharpnessVec = _mm_set1_ps(sharpness);
+        for (; x + 8 < width; x += 8) {
+            __m128i lo = SharpenPixels4(up + x, center + x, down + x, sharpnessVec);
+            __m128i hi = SharpenPixels4(up + x + 4, center + x + 4, down + x + 4, sharpnessVec);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x + 4), hi);
+        }
+    }
+#endif
+    for (; x + 1 < width; ++x) {
+        out[x] = SharpenPixel<F>(up[x], center[x - 1], center[x], center[x + 1], down[x], sharpness);
+    }
+
+    x = width - 1;
+    out[x] = SharpenPixel<F>(up[x], center[x - 1], center[x], center[x], down[x], sharpness);
+}
+
+#define INSTANTIATE_SHARPEN(format) \
+    template void ContrastAdaptiveSharpener::Apply<format>(const FormatPlane<format>&, float); \
+    template void ContrastAdaptiveSharpener::SharpenRow<format>(const PixelStorage<format>*, \
+        const PixelStorage<format>*, const PixelStorage<format>*, PixelStorage<format>*, uint32_t, float) const;
+FIVEM_FRAMEGEN_FOR_EACH_PIXEL_FORMAT(INSTANTIATE_SHARPEN)
+#undef INSTANTIATE_SHARPEN
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * Contrast-Adaptive Sharpening
+ *
+ * RCAS-style sharpen pass applied to the generated frame. Mirrors
+ * g_SharpenPS in the FSR3 backend.
+ */
+
+#ifndef FIVEM_FRAMEGEN_SHARPEN_H
+#define FIVEM_FRAMEGEN_SHARPEN_H
+
+#include "pixel_format.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Robust contrast-adaptive sharpener
+ *
+ * Each pixel is pushed away from its 4-neighbour cross by a negative lobe.
+ * The lobe is limited per pixel by the headroom between the cross's min/max
+ * and the representable range, and capped at LOBE_LIMIT, so high-contrast
+ * edges get a small bounded overshoot instead of the clipped halos a plain
+ * unsharp mask produces. Flat areas are left untouched.
+ */
+class ContrastAdaptiveSharpener {
+public:
+    // Strongest lobe the limiter allows (same as FSR RCAS)
+    static constexpr float LOBE_LIMIT = 0.25f - 1.0f / 16.0f;
+
+    ContrastAdaptiveSharpener();
+    ~ContrastAdaptiveSharpener();
+
+    /**
+     * Allocate row history for images up to the given width
+     */
+    bool Initialize(uint32_t width, PixelFormat format = PixelFormat::RGBA8);
+    void Shutdown();
+
+    /**
+     * Sharpen an image in place
+     *
+     * @param image Frame to sharpen, in the format given to Initialize
+     * @param sharpness 0 (no-op) to 1 (strongest)
+     */
+    template <PixelFormat F>
+    void Apply(const FormatPlane<F>& image, float sharpness);
+
+    /**
+     * Sharpen one row from unmodified copies of it and its neighbours
+     *
+     * Lets callers that already hold the unsharpened rows (the fused
+     * interpolation kernel) sharpen without a second pass over the frame.
+     *
+     * @param out Destination row; must not alias the inputs
+     * @param sharpness 0-1, not clamped here
+     */
+    template <PixelFormat F>
+    void SharpenRow(const PixelStorage<F>* up, const PixelStorage<F>* center, const PixelStorage<F>* down,
+                    PixelStorage<F>* out, uint32_t width, float sharpness) const;
+
+private:
+
+    // Original contents of the previous and current rows (written in place)
+    std::vector<uint8_t> m_RowPrev;
+    std::vector<uint8_t> m_RowCurr;
+
+    bool m_Initialized = false;
+    PixelFormat m_Format = PixelFormat::RGBA8;
+    uint32_t m_Width = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_SHARPEN_H
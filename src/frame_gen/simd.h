@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * SIMD Support
+ *
+ * Selects the x86 SSE2 code paths of the CPU kernels. SSE2 is part of the
+ * x64 baseline, so MSVC x64 builds always take it; everything else falls
+ * back to the scalar loops.
+ */
+
+#ifndef FIVEM_FRAMEGEN_SIMD_H
+#define FIVEM_FRAMEGEN_SIMD_H
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FIVEM_FRAMEGEN_SSE2 1
+#endif
+
+#endif // FIVEM_FRAMEGEN_SIMD_H
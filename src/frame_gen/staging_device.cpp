@@ -0,0 +1,139 @@
+/**
+ * Staging Device Implementation
+ */
+
+#include "staging_device.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+bool CopyImage(const ImageView& dst, const ConstImageView& src, uint32_t bytesPerPixel) {
+    if (dst.width != src.width || dst.height != src.height) return false;
+
+    const Plane<uint8_t> out = dst.As<uint8_t>();
+    const Plane<const uint8_t> in = src.As<const uint8_t>();
+    const size_t rowBytes = static_cast<size_t>(src.width) * bytesPerPixel;
+    for (uint32_t y = 0; y < src.height; ++y) {
+        std::memcpy(out.Row(y), in.Row(y), rowBytes);
+    }
+    return true;
+}
+
+MemoryStagingDevice::MemoryStagingDevice() = default;
+
+MemoryStagingDevice::~MemoryStagingDevice() = default;
+
+void* MemoryStagingDevice::CreateReadback(const StagingDesc& desc) {
+    return CreateBuffer(desc, false);
+}
+
+void* MemoryStagingDevice::CreateUpload(const StagingDesc& desc) {
+    return CreateBuffer(desc, true);
+}
+
+MemoryStagingDevice::Buffer* MemoryStagingDevice::CreateBuffer(const StagingDesc& desc, bool upload) {
+    if (desc.width == 0 || desc.height == 0 || desc.bytesPerPixel == 0) return nullptr;
+
+    Buffer* buffer = new Buffer();
+    buffer->desc = desc;
+    buffer->bytes.resize(static_cast<size_t>(desc.width) * desc.height * desc.bytesPerPixel);
+    buffer->upload = upload;
+    ++m_Counters.live;
+    return buffer;
+}
+
+void MemoryStagingDevice::Destroy(void* staging) {
+    if (!staging) return;
+
+    delete static_cast<Buffer*>(staging);
+    --m_Counters.live;
+}
+
+bool MemoryStagingDevice::CopyToReadback(void* staging, void* source) {
+    Buffer* buffer = static_cast<Buffer*>(staging);
+    const ConstImageView* frame = static_cast<const ConstImageView*>(source);
+    if (!buffer || buffer->upload || !frame || buffer->mapped) return false;
+
+    const size_t rowBytes = static_cast<size_t>(buffer->desc.width) * buffer->desc.bytesPerPixel;
+    const ImageView copy(buffer->bytes.data(), buffer->desc.width, buffer->desc.height, rowBytes);
+    if (!CopyImage(copy, *frame, buffer->desc.bytesPerPixel)) return false;
+    buffer->readyTick = m_Tick + m_CopyLatency;
+
+    ++m_Counters.copies;
+    m_Counters.bytesCopied += rowBytes * frame->height;
+    return true;
+}
+
+bool MemoryStagingDevice::CopyFromUpload(void* target, void* staging) {
+    Buffer* buffer = static_cast<Buffer*>(staging);
+    const ImageView* frame = static_cast<const ImageView*>(target);
+    if (!buffer || !buffer->upload || !frame || buffer->mapped) return false;
+
+    const size_t rowBytes = static_cast<size_t>(buffer->desc.width) * buffer->desc.bytesPerPixel;
+    const ConstImageView copy(buffer->bytes.data(), buffer->desc.width, buffer->desc.height, rowBytes);
+    if (!CopyImage(*frame, copy, buffer->desc.bytesPerPixel)) return false;
+    buffer->readyTick = m_Tick + m_CopyLatency;
+
+    ++m_Counters.uploads;
+    m_Counters.bytesUploaded += rowBytes * frame->height;
+    return true;
+}
+
+MapStatus MemoryStagingDevice::BeginMap(Buffer* buffer, bool upload, bool wait) {
+    if (!buffer || buffer->upload != upload || buffer->mapped) return MapStatus::Failed;
+
+    if (m_Tick < buffer->readyTick) {
+        if (!wait) return MapStatus::Pending;
+        ++m_Counters.blockingMaps;
+    }
+
+    buffer->mapped = true;
+    ++m_Counters.maps;
+    return MapStatus::Ready;
+}
+
+MapStatus MemoryStagingDevice::MapRead(void* staging, bool wait, ConstImageView& view) {
+    Buffer* buffer = static_cast<Buffer*>(staging);
+    const MapStatus status = BeginMap(buffer, false, wait);
+    if (status == MapStatus::Ready) {
+        view = ConstImageView(buffer->bytes.data(), buffer->desc.width, buffer->desc.height,
+                              static_cast<size_t>(buffer->desc.width) * buffer->desc.bytesPerPixel);
+    }
+    return status;
+}
+
+MapStatus MemoryStagingDevice::MapWrite(void* staging, bool wait, ImageView& view) {
+    Buffer* buffer = static_cast<Buffer*>(staging);
+    const MapStatus status = BeginMap(buffer, true, wait);
+    if (status == MapStatus::Ready) {
+        view = ImageView(buffer->bytes.data(), buffer->desc.width, buffer->desc.height,
+                         static_cast<size_t>(buffer->desc.width) * buffer->desc.bytesPerPixel);
+    }
+    return status;
+}
+
+void MemoryStagingDevice::Unmap(void* staging) {
+    if (Buffer* buffer = static_cast<Buffer*>(staging)) {
+        buffer->mapped = false;
+    }
+}
+
+bool MemoryStagingDevice::CopyFrame(void* target, void* source) {
+    const ImageView* dst = static_cast<const ImageView*>(target);
+    const ImageView* src = static_cast<const ImageView*>(source);
+    if (!dst || !src || dst->width != src->width || dst->height != src->height) return false;
+
+    // The element size is not known here; the narrower pitch bounds it
+    const uint32_t bytesPerPixel = static_cast<uint32_t>((std::min)(dst->pitchBytes, src->pitchBytes) / src->width);
+    if (!CopyImage(*dst, *src, bytesPerPixel)) return false;
+
+    ++m_Counters.frameCopies;
+    m_Counters.bytesFrameCopied += static_cast<uint64_t>(src->width) * bytesPerPixel * src->height;
+    return true;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
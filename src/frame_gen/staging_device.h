@@ -0,0 +1,177 @@
+#pragma once
+
+/**
+ * Staging Device
+ *
+ * The API-specific half of moving frames between GPU and CPU: creating
+ * CPU-visible staging copies, queueing GPU copies into and out of them and
+ * mapping them without waiting. The rings built on top are API-neutral; an
+ * in-memory implementation stands in for the GPU where there is none.
+ */
+
+#ifndef FIVEM_FRAMEGEN_STAGING_DEVICE_H
+#define FIVEM_FRAMEGEN_STAGING_DEVICE_H
+
+#include "image_types.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Size and layout of a staging copy
+ */
+struct StagingDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;            // API format enum (DXGI_FORMAT on D3D11)
+    uint32_t bytesPerPixel = 4;
+
+    bool operator==(const StagingDesc&) const = default;
+};
+
+/**
+ * Outcome of a map attempt
+ */
+enum class MapStatus : uint8_t {
+    Ready = 0,
+    Pending,        // The GPU is not done with it; try again later
+    Failed
+};
+
+/**
+ * Creates, fills and maps staging copies; handles are opaque
+ */
+class IStagingDevice {
+public:
+    virtual ~IStagingDevice() = default;
+
+    /**
+     * CPU-readable copy target
+     *
+     * @return Opaque staging handle, or nullptr on failure
+     */
+    virtual void* CreateReadback(const StagingDesc& desc) = 0;
+    virtual void Destroy(void* staging) = 0;
+
+    /**
+     * Queue a GPU copy of an API resource into a readback target
+     */
+    virtual bool CopyToReadback(void* staging, void* source) = 0;
+
+    /**
+     * Map a readback target for reading
+     *
+     * @param wait Block until the copy has finished instead of returning Pending
+     * @param view Mapped data, valid until Unmap
+     */
+    virtual MapStatus MapRead(void* staging, bool wait, ConstImageView& view) = 0;
+    
+    /**
+     * CPU-writable copy source
+     *
+     * @return Opaque staging handle, or nullptr on failure
+     */
+    virtual void* CreateUpload(const StagingDesc& desc) = 0;
+    
+    /**
+     * Map an upload source for writing
+     *
+     * @param wait Block until the GPU has finished copying out of it
+     *             instead of returning Pending
+     * @param view Writable data, valid until Unmap
+     */
+    virtual MapStatus MapWrite(void* staging, bool wait, ImageView& view) = 0;
+    
+    /**
+     * Queue a GPU copy of an unmapped upload source into an API resource
+     */
+    virtual bool CopyFromUpload(void* target, void* staging) = 0;
+    
+    virtual void Unmap(void* staging) = 0;
+    
+    /**
+     * Queue a GPU copy between two API resources of the same size
+     */
+    virtual bool CopyFrame(void* target, void* source) = 0;
+};
+
+/**
+ * Copy the rows of one view into another of the same size
+ *
+ * @return False if the sizes differ
+ */
+bool CopyImage(const ImageView& dst, const ConstImageView& src, uint32_t bytesPerPixel);
+
+/**
+ * In-memory staging device
+ *
+ * GPU resources are stood in for by ConstImageView pointers (readback
+ * sources) and ImageView pointers (upload and frame copy targets). Copies happen
+ * immediately but the staging copy stays busy for the configured number
+ * of Tick calls, the way a GPU finishes them a few frames later.
+ */
+class MemoryStagingDevice : public IStagingDevice {
+public:
+    struct Counters {
+        uint64_t copies = 0;            // GPU to CPU
+        uint64_t bytesCopied = 0;
+        uint64_t uploads = 0;           // CPU to GPU
+        uint64_t bytesUploaded = 0;
+        uint64_t frameCopies = 0;       // GPU to GPU
+        uint64_t bytesFrameCopied = 0;
+        uint64_t maps = 0;
+        uint64_t blockingMaps = 0;      // Waited for a copy that was not finished
+        uint32_t live = 0;              // Staging copies not yet destroyed
+    };
+
+    MemoryStagingDevice();
+    ~MemoryStagingDevice() override;
+
+    /**
+     * Frames a copy stays in flight (default 1)
+     */
+    void SetCopyLatency(uint32_t frames) { m_CopyLatency = frames; }
+
+    /**
+     * Advance the simulated GPU by one frame
+     */
+    void Tick() { ++m_Tick; }
+
+    void* CreateReadback(const StagingDesc& desc) override;
+    void Destroy(void* staging) override;
+    bool CopyToReadback(void* staging, void* source) override;
+    MapStatus MapRead(void* staging, bool wait, ConstImageView& view) override;
+    void* CreateUpload(const StagingDesc& desc) override;
+    MapStatus MapWrite(void* staging, bool wait, ImageView& view) override;
+    bool CopyFromUpload(void* target, void* staging) override;
+    void Unmap(void* staging) override;
+    bool CopyFrame(void* target, void* source) override;
+
+    const Counters& GetCounters() const { return m_Counters; }
+
+private:
+    struct Buffer {
+        StagingDesc desc;
+        std::vector<uint8_t> bytes;
+        uint64_t readyTick = 0;     // Tick the last GPU copy finishes
+        bool upload = false;
+        bool mapped = false;
+    };
+
+    Buffer* CreateBuffer(const StagingDesc& desc, bool upload);
+
+    /**
+     * Wait out or report the buffer's last GPU copy
+     */
+    MapStatus BeginMap(Buffer* buffer, bool upload, bool wait);
+
+    uint64_t m_Tick = 0;
+    uint32_t m_CopyLatency = 1;
+    Counters m_Counters;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_STAGING_DEVICE_H
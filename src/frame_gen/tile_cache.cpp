@@ -0,0 +1,257 @@
+/**
+ * Generated Tile Cache Implementation
+ */
+
+#include "tile_cache.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace {
+
+constexpr uint64_t HASH_PRIME1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t HASH_PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+inline uint64_t Rotl(uint64_t v, int bits) {
+    return (v << bits) | (v >> (64 - bits));
+}
+
+/**
+ * One xxHash64-style round
+ */
+inline uint64_t Mix(uint64_t h, uint64_t v) {
+    return Rotl(h ^ (v * HASH_PRIME2), 31) * HASH_PRIME1;
+}
+
+inline uint64_t Finalize(uint64_t h) {
+    h ^= h >> 33;
+    h *= HASH_PRIME2;
+    h ^= h >> 29;
+    return h;
+}
+
+uint64_t HashBytes(uint64_t h, const uint8_t* data, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, data + i, 8);
+        h = Mix(h, v);
+    }
+    if (i < size) {
+        uint64_t v = 0;
+        std::memcpy(&v, data + i, size - i);
+        h = Mix(h, v ^ (static_cast<uint64_t>(size - i) << 56));
+    }
+    return h;
+}
+
+} // namespace
+
+TileCache::TileCache() = default;
+
+TileCache::~TileCache() {
+    Shutdown();
+}
+
+bool TileCache::Initialize(uint32_t width, uint32_t height, uint32_t bytesPerPixel) {
+    if (width == 0 || height == 0 || bytesPerPixel == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_BytesPerPixel = bytesPerPixel;
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    const size_t tileCount = static_cast<size_t>(m_TilesX) * m_TilesY;
+    m_Pixels.assign(static_cast<size_t>(width) * height * bytesPerPixel, 0);
+    m_Holes.assign(static_cast<size_t>(width) * height, 0);
+    m_StoredKeys.assign(tileCount, 0);
+    m_Keys.assign(tileCount, 0);
+    m_ContentHashes.assign(tileCount, 0);
+    m_MaxMotion.assign(tileCount, 0.0f);
+    m_Hit.assign(tileCount, 0);
+    m_Cacheable.assign(tileCount, 0);
+    m_Stored.assign(tileCount, 0);
+    m_Valid.assign(tileCount, 0);
+
+    m_Initialized = true;
+    return true;
+}
+
+void TileCache::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Pixels.clear();
+    m_Pixels.shrink_to_fit();
+    m_Holes.clear();
+    m_Holes.shrink_to_fit();
+    m_StoredKeys.clear();
+    m_Keys.clear();
+    m_ContentHashes.clear();
+    m_MaxMotion.clear();
+    m_Hit.clear();
+    m_Cacheable.clear();
+    m_Stored.clear();
+    m_Valid.clear();
+
+    m_Initialized = false;
+}
+
+void TileCache::Invalidate() {
+    if (!m_Initialized) return;
+
+    std::fill(m_Valid.begin(), m_Valid.end(), static_cast<uint8_t>(0));
+    std::fill(m_Hit.begin(), m_Hit.end(), static_cast<uint8_t>(0));
+    std::fill(m_Stored.begin(), m_Stored.end(), static_cast<uint8_t>(0));
+}
+
+uint64_t TileCache::HashTile(const ConstImageView& frame, uint32_t tx, uint32_t ty) const {
+    const uint32_t x0 = tx * TILE_SIZE;
+    const uint32_t y0 = ty * TILE_SIZE;
+    const uint32_t x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+    const uint32_t y1 = (std::min)(y0 + TILE_SIZE, m_Height);
+    const size_t offset = static_cast<size_t>(x0) * m_BytesPerPixel;
+    const size_t rowBytes = static_cast<size_t>(x1 - x0) * m_BytesPerPixel;
+    const auto* bytes = static_cast<const uint8_t*>(frame.data);
+
+    uint64_t h = HASH_PRIME1;
+    for (uint32_t y = y0; y < y1; ++y) {
+        h = HashBytes(h, bytes + y * frame.pitchBytes + offset, rowBytes);
+    }
+    return h;
+}
+
+uint64_t TileCache::HashMotion(const MotionField& motion, uint32_t tx, uint32_t ty, float& maxMotion) const {
+    const int bx0 = static_cast<int>(tx * TILE_SIZE / motion.blockSize);
+    const int by0 = static_cast<int>(ty * TILE_SIZE / motion.blockSize);
+    const int bx1 = static_cast<int>(((std::min)((tx + 1) * TILE_SIZE, m_Width) - 1) / motion.blockSize);
+    const int by1 = static_cast<int>(((std::min)((ty + 1) * TILE_SIZE, m_Height) - 1) / motion.blockSize);
+
+    uint64_t h = HASH_PRIME2;
+    maxMotion = 0.0f;
+    for (int by = by0; by <= by1; ++by) {
+        for (int bx = bx0; bx <= bx1; ++bx) {
+            // Edge clamped like the samplers, so tiles past the last block see its vector
+            const MotionVector& v = motion.Block(bx, by);
+            uint64_t bits;
+            static_assert(sizeof(MotionVector) == sizeof(bits), "MotionVector is two floats");
+            std::memcpy(&bits, &v, sizeof(bits));
+            h = Mix(h, bits);
+            maxMotion = (std::max)(maxMotion, (std::max)(std::fabs(v.x), std::fabs(v.y)));
+        }
+    }
+    return h;
+}
+
+void TileCache::Prepare(
+    const ConstImageView& framePrev,
+    const ConstImageView& frameCurrent,
+    const MotionField& motion,
+    const Plane<const uint8_t>& hudMask,
+    uint64_t settingsKey
+) {
+    if (!m_Initialized || !motion.IsValid()) return;
+
+    std::fill(m_Stored.begin(), m_Stored.end(), static_cast<uint8_t>(0));
+
+    // Each tile's own inputs
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            const size_t i = Index(tx, ty);
+            uint64_t h = Mix(HashTile(framePrev, tx, ty), HashTile(frameCurrent, tx, ty));
+            h = Mix(h, HashMotion(motion, tx, ty, m_MaxMotion[i]));
+
+            if (hudMask.data) {
+                const uint32_t x0 = tx * TILE_SIZE;
+                const uint32_t x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+                for (uint32_t y = ty * TILE_SIZE; y < (std::min)((ty + 1) * TILE_SIZE, m_Height); ++y) {
+                    h = HashBytes(h, hudMask.Row(y) + x0, x1 - x0);
+                }
+            }
+            m_ContentHashes[i] = h;
+        }
+    }
+
+    // Keys cover every tile the output can read from
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            const size_t i = Index(tx, ty);
+
+            // Vectors one tile out still steer this tile (bilinear/OBMC
+            // neighbours, divergence), so their motion counts too
+            float maxMotion = 0.0f;
+            for (uint32_t ny = (ty > 0 ? ty - 1 : 0); ny <= (std::min)(ty + 1, m_TilesY - 1); ++ny) {
+                for (uint32_t nx = (tx > 0 ? tx - 1 : 0); nx <= (std::min)(tx + 1, m_TilesX - 1); ++nx) {
+                    maxMotion = (std::max)(maxMotion, m_MaxMotion[Index(nx, ny)]);
+                }
+            }
+
+            const float reachPixels = std::ceil(maxMotion) + 2.0f * motion.blockSize + FILTER_APRON;
+            const uint32_t reach = (std::max)(1u,
+                static_cast<uint32_t>(std::ceil(reachPixels / static_cast<float>(TILE_SIZE))));
+
+            m_Hit[i] = 0;
+            m_Cacheable[i] = reach <= MAX_REACH_TILES && std::isfinite(maxMotion);
+            if (!m_Cacheable[i]) continue;
+
+            const uint32_t nx0 = tx > reach ? tx - reach : 0;
+            const uint32_t ny0 = ty > reach ? ty - reach : 0;
+            const uint32_t nx1 = (std::min)(tx + reach, m_TilesX - 1);
+            const uint32_t ny1 = (std::min)(ty + reach, m_TilesY - 1);
+
+            uint64_t key = Mix(settingsKey, reach);
+            for (uint32_t ny = ny0; ny <= ny1; ++ny) {
+                for (uint32_t nx = nx0; nx <= nx1; ++nx) {
+                    key = Mix(key, m_ContentHashes[Index(nx, ny)]);
+                }
+            }
+            key = Finalize(key);
+
+            m_Keys[i] = key;
+            m_Hit[i] = m_Valid[i] && m_StoredKeys[i] == key;
+        }
+    }
+}
+
+uint32_t TileCache::Load(uint32_t y, uint32_t x0, uint32_t x1, void* out, uint8_t* holes) const {
+    const size_t rowOffset = static_cast<size_t>(y) * m_Width;
+    std::memcpy(static_cast<uint8_t*>(out) + static_cast<size_t>(x0) * m_BytesPerPixel,
+                m_Pixels.data() + (rowOffset + x0) * m_BytesPerPixel,
+                static_cast<size_t>(x1 - x0) * m_BytesPerPixel);
+
+    uint32_t holeCount = 0;
+    const uint8_t* cachedHoles = m_Holes.data() + rowOffset;
+    for (uint32_t x = x0; x < x1; ++x) {
+        holes[x] = cachedHoles[x];
+        holeCount += cachedHoles[x] != 0;
+    }
+    return holeCount;
+}
+
+void TileCache::Store(uint32_t tx, uint32_t y, uint32_t x0, uint32_t x1, const void* out, const uint8_t* holes) {
+    const size_t rowOffset = static_cast<size_t>(y) * m_Width;
+    std::memcpy(m_Pixels.data() + (rowOffset + x0) * m_BytesPerPixel,
+                static_cast<const uint8_t*>(out) + static_cast<size_t>(x0) * m_BytesPerPixel,
+                static_cast<size_t>(x1 - x0) * m_BytesPerPixel);
+    std::memcpy(m_Holes.data() + rowOffset + x0, holes + x0, x1 - x0);
+
+    m_Stored[Index(tx, y / TILE_SIZE)] = 1;
+}
+
+void TileCache::Commit() {
+    if (!m_Initialized) return;
+
+    for (size_t i = 0; i < m_Stored.size(); ++i) {
+        if (m_Stored[i]) {
+            m_StoredKeys[i] = m_Keys[i];
+            m_Valid[i] = 1;
+            m_Stored[i] = 0;
+        }
+    }
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * Generated Tile Cache
+ *
+ * Keeps the warp/blend result of every tile from the previous generated
+ * frame, keyed by hashes of everything that tile's output depends on, so
+ * a tile whose inputs did not change is copied instead of recomputed.
+ *
+ * Used by CpuInterpolator. The FSR3 backend keys its tiles the same way
+ * in TileClassCalculator's compute pass and keeps the pixels in its render
+ * target (keep the reach and hash inputs of both in sync).
+ */
+
+#ifndef FIVEM_FRAMEGEN_TILE_CACHE_H
+#define FIVEM_FRAMEGEN_TILE_CACHE_H
+
+#include "tile_classifier.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Tile-level temporal reuse of generated pixels
+ *
+ * Per frame, each tile gets a content hash of its pixels in both source
+ * frames and of the motion blocks it covers. A tile's key combines those
+ * hashes over every tile its output can read from: its own motion plus
+ * an apron for the filters, the occlusion warp-back and the neighbouring
+ * vectors. The key also includes the caller's settings word (interpolation
+ * factor, modes). Cached pixels are the unsharpened, unfilled warp output
+ * along with the hole flags, so the later passes run exactly as they
+ * would on freshly computed pixels.
+ */
+class TileCache {
+public:
+    static constexpr uint32_t TILE_SIZE = TileClassifier::TILE_SIZE;
+
+    // Tiles whose inputs reach further than this are always recomputed
+    static constexpr uint32_t MAX_REACH_TILES = 4;
+
+    // Pixels of filter footprint beyond the motion (4x4 kernels reach 2)
+    static constexpr uint32_t FILTER_APRON = 3;
+
+    TileCache();
+    ~TileCache();
+
+    /**
+     * Allocate the cached frame
+     *
+     * @param bytesPerPixel Pixel size of the generated frame
+     */
+    bool Initialize(uint32_t width, uint32_t height, uint32_t bytesPerPixel);
+    void Shutdown();
+
+    /**
+     * Drop every cached tile (scene change, resize)
+     */
+    void Invalidate();
+
+    /**
+     * Hash this frame's inputs and look up every tile
+     *
+     * @param hudMask Optional per-pixel HUD mask that the output depends on
+     * @param settingsKey Hash of every setting that changes the output
+     */
+    void Prepare(
+        const ConstImageView& framePrev,
+        const ConstImageView& frameCurrent,
+        const MotionField& motion,
+        const Plane<const uint8_t>& hudMask,
+        uint64_t settingsKey
+    );
+
+    /**
+     * The cached pixels are valid for this frame's inputs
+     */
+    bool IsHit(uint32_t tx, uint32_t ty) const { return m_Hit[Index(tx, ty)] != 0; }
+
+    /**
+     * The tile's inputs are local enough to key
+     */
+    bool IsCacheable(uint32_t tx, uint32_t ty) const { return m_Cacheable[Index(tx, ty)] != 0; }
+
+    /**
+     * Copy one row span of a hit tile into the output and hole mask
+     *
+     * @return Number of hole pixels in the span
+     */
+    uint32_t Load(uint32_t y, uint32_t x0, uint32_t x1, void* out, uint8_t* holes) const;
+
+    /**
+     * Store one freshly computed row span of a tile
+     */
+    void Store(uint32_t tx, uint32_t y, uint32_t x0, uint32_t x1, const void* out, const uint8_t* holes);
+
+    /**
+     * Record the keys of every tile stored this frame; call after the last row
+     */
+    void Commit();
+
+    uint32_t GetTilesX() const { return m_TilesX; }
+    uint32_t GetTilesY() const { return m_TilesY; }
+
+private:
+    size_t Index(uint32_t tx, uint32_t ty) const { return static_cast<size_t>(ty) * m_TilesX + tx; }
+
+    /**
+     * Content hash of a tile's pixels
+     */
+    uint64_t HashTile(const ConstImageView& frame, uint32_t tx, uint32_t ty) const;
+
+    /**
+     * Hash of the vectors of the blocks overlapping a tile; also returns
+     * their largest component magnitude
+     */
+    uint64_t HashMotion(const MotionField& motion, uint32_t tx, uint32_t ty, float& maxMotion) const;
+
+    // Cached generated frame (bytewise) and its hole flags
+    std::vector<uint8_t> m_Pixels;
+    std::vector<uint8_t> m_Holes;
+
+    // Per-tile state
+    std::vector<uint64_t> m_StoredKeys;     // Key the cached pixels were made with
+    std::vector<uint64_t> m_Keys;           // This frame's keys
+    std::vector<uint64_t> m_ContentHashes;  // Own inputs of each tile
+    std::vector<float> m_MaxMotion;         // Largest vector component per tile
+    std::vector<uint8_t> m_Hit;
+    std::vector<uint8_t> m_Cacheable;
+    std::vector<uint8_t> m_Stored;          // Written this frame
+    std::vector<uint8_t> m_Valid;           // m_StoredKeys is meaningful
+
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    uint32_t m_BytesPerPixel = 0;
+    uint32_t m_TilesX = 0;
+    uint32_t m_TilesY = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_TILE_CACHE_H
@@ -0,0 +1,160 @@
+/**
+ * Tile Classifier Implementation
+ */
+
+#include "tile_classifier.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+TileClassifier::TileClassifier() = default;
+
+TileClassifier::~TileClassifier() {
+    Shutdown();
+}
+
+bool TileClassifier::Initialize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_Classes.assign(static_cast<size_t>(m_TilesX) * m_TilesY, TileClass::Dynamic);
+
+    m_Initialized = true;
+    return true;
+}
+
+void TileClassifier::Shutdown() {
+    if (!m_Initialized) return;
+
+    m_Classes.clear();
+    m_MovingBlocks.clear();
+    m_BlocksX = 0;
+    m_BlocksY = 0;
+
+    m_Initialized = false;
+}
+
+void TileClassifier::MarkMovingBlocks(const MotionField& motion) {
+    size_t count = static_cast<size_t>(motion.blocksX) * motion.blocksY;
+    if (m_MovingBlocks.size() != count) {
+        m_MovingBlocks.resize(count);
+    }
+    m_BlocksX = motion.blocksX;
+    m_BlocksY = motion.blocksY;
+
+    for (size_t i = 0; i < count; ++i) {
+        const MotionVector& v = motion.vectors[i];
+        m_MovingBlocks[i] = (std::fabs(v.x) > STATIC_MOTION_EPSILON ||
+                             std::fabs(v.y) > STATIC_MOTION_EPSILON) ? 1 : 0;
+    }
+}
+
+void TileClassifier::GetBlockRange(uint32_t tx, uint32_t ty, uint32_t blockSize,
+                                   int& bx0, int& by0, int& bx1, int& by1) const {
+    uint32_t x0, y0, x1, y1;
+    GetTileRect(tx, ty, x0, y0, x1, y1);
+
+    // Blocks covering the tile, plus one block either side for bilinear taps
+    bx0 = (std::max)(static_cast<int>(x0 / blockSize) - 1, 0);
+    by0 = (std::max)(static_cast<int>(y0 / blockSize) - 1, 0);
+    bx1 = (std::min)(static_cast<int>((x1 - 1) / blockSize) + 1, static_cast<int>(m_BlocksX) - 1);
+    by1 = (std::min)(static_cast<int>((y1 - 1) / blockSize) + 1, static_cast<int>(m_BlocksY) - 1);
+}
+
+bool TileClassifier::HasMotion(const MotionField& motion, uint32_t tx, uint32_t ty) const {
+    int bx0, by0, bx1, by1;
+    GetBlockRange(tx, ty, motion.blockSize, bx0, by0, bx1, by1);
+
+    for (int by = by0; by <= by1; ++by) {
+        const uint8_t* row = m_MovingBlocks.data() + static_cast<size_t>(by) * m_BlocksX;
+        for (int bx = bx0; bx <= bx1; ++bx) {
+            if (row[bx]) return true;
+        }
+    }
+    return false;
+}
+
+TileClass TileClassifier::ClassifyMotion(const MotionField& motion, uint32_t tx, uint32_t ty) const {
+    int bx0, by0, bx1, by1;
+    GetBlockRange(tx, ty, motion.blockSize, bx0, by0, bx1, by1);
+
+    const MotionVector& first = motion.vectors[static_cast<size_t>(by0) * m_BlocksX + bx0];
+    float minX = first.x, maxX = first.x, minY = first.y, maxY = first.y;
+    float maxMagnitudeSq = 0.0f;
+    for (int by = by0; by <= by1; ++by) {
+        const MotionVector* row = motion.vectors + static_cast<size_t>(by) * m_BlocksX;
+        for (int bx = bx0; bx <= bx1; ++bx) {
+            const MotionVector& v = row[bx];
+            minX = (std::min)(minX, v.x);
+            maxX = (std::max)(maxX, v.x);
+            minY = (std::min)(minY, v.y);
+            maxY = (std::max)(maxY, v.y);
+            maxMagnitudeSq = (std::max)(maxMagnitudeSq, v.x * v.x + v.y * v.y);
+        }
+    }
+
+    // Agreeing vectors leave nothing for the occlusion weights to resolve
+    const float spread = (std::max)(maxX - minX, maxY - minY);
+    if (maxMagnitudeSq <= BLEND_MOTION_MAX * BLEND_MOTION_MAX) return TileClass::Blend;
+    if (maxMagnitudeSq >= FAST_MOTION * FAST_MOTION || spread >= DISCONTINUITY) return TileClass::Dynamic;
+    return TileClass::Warp;
+}
+
+uint32_t TileClassifier::Classify(
+    const ConstImageView& framePrev,
+    const ConstImageView& frameCurrent,
+    const MotionField& motion,
+    uint32_t bytesPerPixel
+) {
+    if (!m_Initialized || !motion.IsValid()) return 0;
+
+    MarkMovingBlocks(motion);
+
+    for (uint32_t& count : m_ClassCounts) count = 0;
+
+    for (uint32_t ty = 0; ty < m_TilesY; ++ty) {
+        for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+            TileClass cls = TileClass::Dynamic;
+
+            const bool moving = HasMotion(motion, tx, ty);
+            if (!moving && m_StaticDetection) {
+                uint32_t x0, y0, x1, y1;
+                GetTileRect(tx, ty, x0, y0, x1, y1);
+                size_t offset = static_cast<size_t>(x0) * bytesPerPixel;
+                size_t rowBytes = static_cast<size_t>(x1 - x0) * bytesPerPixel;
+
+                const auto* prevBytes = static_cast<const uint8_t*>(framePrev.data);
+                const auto* currBytes = static_cast<const uint8_t*>(frameCurrent.data);
+
+                bool identical = true;
+                for (uint32_t y = y0; y < y1 && identical; ++y) {
+                    identical = std::memcmp(prevBytes + y * framePrev.pitchBytes + offset,
+                                            currBytes + y * frameCurrent.pitchBytes + offset, rowBytes) == 0;
+                }
+
+                if (identical) {
+                    cls = TileClass::Static;
+                }
+            }
+
+            // Still tiles whose pixels changed (lighting, particles) cross-fade
+            if (cls != TileClass::Static && m_MotionClasses) {
+                cls = moving ? ClassifyMotion(motion, tx, ty) : TileClass::Blend;
+            }
+
+            m_Classes[static_cast<size_t>(ty) * m_TilesX + tx] = cls;
+            ++m_ClassCounts[static_cast<size_t>(cls)];
+        }
+    }
+
+    return m_ClassCounts[static_cast<size_t>(TileClass::Static)];
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * Tile Classifier
+ *
+ * Splits the frame into fixed-size tiles and picks the cheapest kernel
+ * that reproduces each one: a plain copy, a cross-fade, a bilinear warp,
+ * or the full occlusion-aware warp.
+ */
+
+#ifndef FIVEM_FRAMEGEN_TILE_CLASSIFIER_H
+#define FIVEM_FRAMEGEN_TILE_CLASSIFIER_H
+
+#include "image_types.h"
+#include <vector>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Per-tile work classification
+ */
+enum class TileClass : uint8_t {
+    Static = 0,     // Zero motion, zero residual: copy the current frame
+    Blend = 1,      // Sub-pixel motion: cross-fade without warping
+    Warp = 2,       // Moderate, coherent motion: bilinear warp and plain lerp
+    Dynamic = 3     // Fast or discontinuous motion: full occlusion-aware warp
+};
+
+static constexpr uint32_t TILE_CLASS_COUNT = 4;
+
+/**
+ * Classifies tiles from the motion field and the frame residual
+ */
+class TileClassifier {
+public:
+    static constexpr uint32_t TILE_SIZE = 16;
+
+    // Motion below this (pixels) counts as no motion, here and on the GPU
+    static constexpr float STATIC_MOTION_EPSILON = 1.0f / 64.0f;
+
+    // Motion classes (pixels, shared with the GPU tile classifier): vectors
+    // up to BLEND_MOTION_MAX are cross-faded; FAST_MOTION or a vector spread
+    // of DISCONTINUITY across the tile needs the full warp
+    static constexpr float BLEND_MOTION_MAX = 0.25f;
+    static constexpr float FAST_MOTION = 16.0f;
+    static constexpr float DISCONTINUITY = 1.0f;
+
+    TileClassifier();
+    ~TileClassifier();
+
+    bool Initialize(uint32_t width, uint32_t height);
+    void Shutdown();
+
+    /**
+     * Detect static tiles (default on)
+     */
+    void SetStaticDetection(bool enabled) { m_StaticDetection = enabled; }
+    bool IsStaticDetection() const { return m_StaticDetection; }
+
+    /**
+     * Split moving tiles into Blend / Warp / Dynamic by motion (default off;
+     * every moving tile is Dynamic)
+     */
+    void SetMotionClasses(bool enabled) { m_MotionClasses = enabled; }
+    bool IsMotionClasses() const { return m_MotionClasses; }
+
+    /**
+     * Classify every tile for this frame pair
+     *
+     * A tile is static when no motion vector that can influence it (its own
+     * blocks plus a one-block apron for bilinear motion sampling) moves, and
+     * its pixels are bit-identical in both frames. Motion classes look at
+     * the same vectors: their largest magnitude and their spread.
+     *
+     * @param bytesPerPixel Pixel size of both frames (the comparison is bytewise)
+     * @return Number of static tiles
+     */
+    uint32_t Classify(
+        const ConstImageView& framePrev,
+        const ConstImageView& frameCurrent,
+        const MotionField& motion,
+        uint32_t bytesPerPixel
+    );
+
+    TileClass GetClass(uint32_t tx, uint32_t ty) const {
+        return m_Classes[static_cast<size_t>(ty) * m_TilesX + tx];
+    }
+
+    uint32_t GetTilesX() const { return m_TilesX; }
+    uint32_t GetTilesY() const { return m_TilesY; }
+    uint32_t GetTileCount() const { return m_TilesX * m_TilesY; }
+
+    /**
+     * Tiles of a class in the last Classify
+     */
+    uint32_t GetClassCount(TileClass cls) const { return m_ClassCounts[static_cast<size_t>(cls)]; }
+
+    /**
+     * Pixel bounds of a tile, clipped to the frame
+     */
+    void GetTileRect(uint32_t tx, uint32_t ty,
+                     uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const {
+        x0 = tx * TILE_SIZE;
+        y0 = ty * TILE_SIZE;
+        x1 = (std::min)(x0 + TILE_SIZE, m_Width);
+        y1 = (std::min)(y0 + TILE_SIZE, m_Height);
+    }
+
+private:
+    /**
+     * Flag blocks whose vector is non-zero
+     */
+    void MarkMovingBlocks(const MotionField& motion);
+
+    /**
+     * True if any moving block overlaps the tile or its apron
+     */
+    bool HasMotion(const MotionField& motion, uint32_t tx, uint32_t ty) const;
+
+    /**
+     * Motion class of a moving tile from the same vectors HasMotion reads
+     */
+    TileClass ClassifyMotion(const MotionField& motion, uint32_t tx, uint32_t ty) const;
+
+    /**
+     * Vector blocks that can influence a tile, clamped to the field
+     */
+    void GetBlockRange(uint32_t tx, uint32_t ty, uint32_t blockSize,
+                       int& bx0, int& by0, int& bx1, int& by1) const;
+
+    std::vector<TileClass> m_Classes;
+    uint32_t m_ClassCounts[TILE_CLASS_COUNT] = {};
+    bool m_StaticDetection = true;
+    bool m_MotionClasses = false;
+    std::vector<uint8_t> m_MovingBlocks;
+    uint32_t m_BlocksX = 0;
+    uint32_t m_BlocksY = 0;
+    uint32_t m_TilesX = 0;
+    uint32_t m_TilesY = 0;
+
+    bool m_Initialized = false;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_TILE_CLASSIFIER_H
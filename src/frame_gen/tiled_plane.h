@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * Tiled Planes
+ *
+ * 8x8-tiled storage for the warp source frames. Motion-compensated fetches
+ * land along arbitrary vectors, and in a row-major plane every step down
+ * is a new cache line (and, at 4K, a new page every few rows); in a tile
+ * the 8x8 neighbourhood of a fetch spans four lines. Rows inside a tile
+ * stay contiguous, so horizontal filter taps read adjacent texels as they
+ * do in a linear plane.
+ */
+
+#ifndef FIVEM_FRAMEGEN_TILED_PLANE_H
+#define FIVEM_FRAMEGEN_TILED_PLANE_H
+
+#include "image_types.h"
+#include <cstring>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * Non-owning view of a plane stored as row-major 8x8 tiles
+ *
+ * Tiles are laid out row-major, texels row-major within a tile. Edge
+ * tiles are padded to the full 8x8 with replicated border texels.
+ */
+template <typename T>
+struct TiledPlane {
+    static constexpr uint32_t TILE_SHIFT = 3;
+    static constexpr uint32_t TILE_SIZE = 1u << TILE_SHIFT;
+    static constexpr uint32_t TILE_MASK = TILE_SIZE - 1;
+    static constexpr uint32_t TILE_TEXELS = TILE_SIZE * TILE_SIZE;
+
+    T* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t tilesX = 0;
+
+    /**
+     * Texel (0, y) of the tile row holding y; texel x of the row is at
+     * TexelOffset(x) from here
+     */
+    T* RowBase(uint32_t y) const {
+        return data + (static_cast<size_t>(y >> TILE_SHIFT) * tilesX * TILE_TEXELS) + (y & TILE_MASK) * TILE_SIZE;
+    }
+
+    static size_t TexelOffset(uint32_t x) {
+        return static_cast<size_t>(x >> TILE_SHIFT) * TILE_TEXELS + (x & TILE_MASK);
+    }
+
+    T& At(uint32_t x, uint32_t y) const { return RowBase(y)[TexelOffset(x)]; }
+
+    bool IsValid() const { return data && width && height && tilesX * TILE_SIZE >= width; }
+
+    /**
+     * Elements needed for a width x height plane
+     */
+    static size_t ElementCount(uint32_t width, uint32_t height) {
+        return static_cast<size_t>((width + TILE_MASK) >> TILE_SHIFT) * ((height + TILE_MASK) >> TILE_SHIFT) * TILE_TEXELS;
+    }
+
+    static TiledPlane Wrap(T* data, uint32_t width, uint32_t height) {
+        return { data, width, height, (width + TILE_MASK) >> TILE_SHIFT };
+    }
+
+    /**
+     * Implicit conversion to a read-only view
+     */
+    template <typename U = T, std::enable_if_t<!std::is_const_v<U>, int> = 0>
+    operator TiledPlane<const U>() const { return { data, width, height, tilesX }; }
+};
+
+/**
+ * Copy a linear plane into a tiled one of the same size
+ *
+ * One pass of 8-texel row runs; each destination tile is written in
+ * order, so the stores stream.
+ */
+template <typename T>
+void ConvertToTiled(const Plane<const T>& src, const TiledPlane<T>& dst) {
+    constexpr uint32_t TILE = TiledPlane<T>::TILE_SIZE;
+    const uint32_t tilesY = (src.height + TILE - 1) / TILE;
+    const uint32_t fullTilesX = src.width / TILE;
+
+    T* out = dst.data;
+    for (uint32_t ty = 0; ty < tilesY; ++ty) {
+        for (uint32_t tx = 0; tx < dst.tilesX; ++tx) {
+            const uint32_t x0 = tx * TILE;
+            for (uint32_t row = 0; row < TILE; ++row, out += TILE) {
+                const uint32_t y = (std::min)(ty * TILE + row, src.height - 1);
+                const T* in = src.Row(y) + x0;
+                if (tx < fullTilesX) {
+                    std::memcpy(out, in, TILE * sizeof(T));
+                } else {
+                    for (uint32_t i = 0; i < TILE; ++i) {
+                        out[i] = in[(std::min)(i, src.width - 1 - x0)];
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_TILED_PLANE_H
@@ -0,0 +1,120 @@
+/**
+ * Upload Ring Implementation
+ */
+
+#include "upload_ring.h"
+#include "../utils/logger.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+UploadRing::UploadRing() = default;
+
+UploadRing::~UploadRing() {
+    Shutdown();
+}
+
+bool UploadRing::Initialize(IStagingDevice* device, const StagingDesc& desc, uint32_t depth) {
+    if (!device || depth == 0 || depth > MAX_DEPTH) return false;
+
+    Shutdown();
+    for (uint32_t i = 0; i < depth; ++i) {
+        m_Slots[i].staging = device->CreateUpload(desc);
+        if (!m_Slots[i].staging) {
+            Utils::Logger::Error("Failed to create upload copy %u of %u", i + 1, depth);
+            for (uint32_t j = 0; j < i; ++j) {
+                device->Destroy(m_Slots[j].staging);
+                m_Slots[j].staging = nullptr;
+            }
+            return false;
+        }
+    }
+
+    m_Device = device;
+    m_Desc = desc;
+    m_Depth = depth;
+    m_Next = 0;
+    m_Writing = false;
+    m_WriteMsTotal = 0.0;
+    m_Stats = {};
+    return true;
+}
+
+void UploadRing::Shutdown() {
+    if (!m_Device) return;
+
+    Cancel();
+    for (uint32_t i = 0; i < m_Depth; ++i) {
+        m_Device->Destroy(m_Slots[i].staging);
+        m_Slots[i] = {};
+    }
+
+    m_Device = nullptr;
+    m_Depth = 0;
+    m_Stats.inFlight = 0;
+}
+
+bool UploadRing::Begin(ImageView& view, bool wait) {
+    if (!m_Device || m_Writing) return false;
+
+    // The next slot holds the oldest upload; if the GPU is still reading
+    // it, every newer one is busy too
+    Slot& slot = m_Slots[m_Next];
+    MapStatus status = m_Device->MapWrite(slot.staging, false, view);
+    if (status == MapStatus::Pending) {
+        if (!wait) {
+            ++m_Stats.busy;
+            return false;
+        }
+        ++m_Stats.stalls;
+        status = m_Device->MapWrite(slot.staging, true, view);
+    }
+    if (status != MapStatus::Ready) return false;
+
+    // A successful map means the GPU copy out of it has finished
+    if (slot.queued) {
+        slot.queued = false;
+        --m_Stats.inFlight;
+    }
+
+    m_Writing = true;
+    m_BeginTime = Clock::now();
+    return true;
+}
+
+bool UploadRing::Commit(void* target) {
+    if (!m_Writing) return false;
+
+    Slot& slot = m_Slots[m_Next];
+    m_Device->Unmap(slot.staging);
+    m_Writing = false;
+
+    const float writeMs = std::chrono::duration<float, std::milli>(Clock::now() - m_BeginTime).count();
+    if (!m_Device->CopyFromUpload(target, slot.staging)) {
+        return false;
+    }
+
+    slot.queued = true;
+    m_Next = (m_Next + 1) % m_Depth;
+
+    const uint64_t bytes = static_cast<uint64_t>(m_Desc.width) * m_Desc.height * m_Desc.bytesPerPixel;
+    ++m_Stats.uploads;
+    ++m_Stats.inFlight;
+    m_Stats.bytesUploaded += bytes;
+    m_Stats.lastWriteMs = writeMs;
+    m_WriteMsTotal += writeMs;
+    if (m_WriteMsTotal > 0.0) {
+        m_Stats.throughputMBps = static_cast<float>(m_Stats.bytesUploaded / (1024.0 * 1024.0) / (m_WriteMsTotal / 1000.0));
+    }
+    return true;
+}
+
+void UploadRing::Cancel() {
+    if (!m_Writing) return;
+
+    m_Device->Unmap(m_Slots[m_Next].staging);
+    m_Writing = false;
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * Upload Ring
+ *
+ * Takes frames made on the CPU to the GPU without stalling the render
+ * thread. Each frame is written into the next of N persistent staging
+ * copies and then copied into the target on the GPU, so the CPU fills one
+ * copy while the GPU is still reading the ones before it. A copy is only
+ * rewritten once the GPU has finished reading it; if it has not, the
+ * upload is skipped for now, never waited on.
+ */
+
+#ifndef FIVEM_FRAMEGEN_UPLOAD_RING_H
+#define FIVEM_FRAMEGEN_UPLOAD_RING_H
+
+#include "staging_device.h"
+#include <chrono>
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+/**
+ * N-deep ring of upload copies over a staging device
+ */
+class UploadRing {
+public:
+    static constexpr uint32_t DEFAULT_DEPTH = 3;
+    static constexpr uint32_t MAX_DEPTH = 8;
+
+    struct Stats {
+        uint64_t uploads = 0;           // Copies queued to the GPU
+        uint64_t bytesUploaded = 0;
+        uint64_t busy = 0;              // Begin found the next copy still being read
+        uint64_t stalls = 0;            // Blocking maps (Begin with wait)
+        uint32_t inFlight = 0;          // Copies the GPU may still be reading
+        float lastWriteMs = 0.0f;       // CPU time from Begin to Commit
+        float throughputMBps = 0.0f;    // Bytes uploaded over total write time
+    };
+
+    UploadRing();
+    ~UploadRing();
+
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    /**
+     * Create the staging copies
+     *
+     * @param depth Copies in the ring (1 to MAX_DEPTH); up to depth - 1
+     *              uploads can be in flight while the next one is written
+     */
+    bool Initialize(IStagingDevice* device, const StagingDesc& desc, uint32_t depth = DEFAULT_DEPTH);
+    void Shutdown();
+
+    /**
+     * Map the next copy for writing
+     *
+     * @param wait Block until the GPU has finished reading the copy
+     *             instead of failing
+     * @return True if view can be written; finish with Commit or Cancel
+     */
+    bool Begin(ImageView& view, bool wait = false);
+
+    /**
+     * Unmap the copy from Begin and queue its GPU copy into target
+     */
+    bool Commit(void* target);
+
+    /**
+     * Unmap the copy from Begin without uploading it
+     */
+    void Cancel();
+
+    bool IsInitialized() const { return m_Device != nullptr; }
+    uint32_t GetDepth() const { return m_Depth; }
+    const StagingDesc& GetDesc() const { return m_Desc; }
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        void* staging = nullptr;
+        bool queued = false;        // Read by a GPU copy not yet known to be done
+    };
+
+    IStagingDevice* m_Device = nullptr;
+    StagingDesc m_Desc;
+    Slot m_Slots[MAX_DEPTH];
+    uint32_t m_Depth = 0;
+    uint32_t m_Next = 0;
+    bool m_Writing = false;         // m_Next is mapped by Begin
+    Clock::time_point m_BeginTime;
+    double m_WriteMsTotal = 0.0;
+    Stats m_Stats;
+};
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_UPLOAD_RING_H
@@ -0,0 +1,54 @@
+/**
+ * Planar YCoCg-R Implementation
+ */
+
+#include "ycocg.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+template <PixelFormat F>
+void ConvertToYCoCg(const ConstFormatPlane<F>& src, const Plane<uint8_t>& luma,
+                    const Plane<int16_t>& co, const Plane<int16_t>& cg) {
+    static_assert(PixelTraits<F>::PACKED_8BIT, "planar YCoCg needs 8-bit channels");
+
+    const uint32_t width = src.width;
+    const uint32_t height = src.height;
+
+    // One chroma row per pair of luma rows; the last row pairs with itself
+    for (uint32_t cy = 0; cy < co.height; ++cy) {
+        const uint32_t rows[2] = { cy * 2, (std::min)(cy * 2 + 1, height - 1) };
+        int16_t* coRow = co.Row(cy);
+        int16_t* cgRow = cg.Row(cy);
+
+        for (uint32_t cx = 0; cx < co.width; ++cx) {
+            const uint32_t cols[2] = { cx * 2, (std::min)(cx * 2 + 1, width - 1) };
+            int coSum = 0;
+            int cgSum = 0;
+            for (uint32_t j = 0; j < 2; ++j) {
+                const uint32_t* in = src.Row(rows[j]);
+                uint8_t* out = luma.Row(rows[j]);
+                for (uint32_t i = 0; i < 2; ++i) {
+                    const uint32_t p = in[cols[i]];
+                    int y, pixelCo, pixelCg;
+                    YCoCgR::Forward(p & 0xFF, (p >> 8) & 0xFF, (p >> 16) & 0xFF, y, pixelCo, pixelCg);
+                    out[cols[i]] = static_cast<uint8_t>(y);
+                    coSum += pixelCo;
+                    cgSum += pixelCg;
+                }
+            }
+            coRow[cx] = static_cast<int16_t>((coSum + 2) >> 2);
+            cgRow[cx] = static_cast<int16_t>((cgSum + 2) >> 2);
+        }
+    }
+}
+
+#define INSTANTIATE_YCOCG(format) \
+    template void ConvertToYCoCg<format>(const ConstFormatPlane<format>&, const Plane<uint8_t>&, \
+                                         const Plane<int16_t>&, const Plane<int16_t>&);
+INSTANTIATE_YCOCG(PixelFormat::RGBA8)
+INSTANTIATE_YCOCG(PixelFormat::BGRA8)
+#undef INSTANTIATE_YCOCG
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * Planar YCoCg-R Frames
+ *
+ * Alternative warp source for 8-bit frames: a full-resolution luma plane
+ * and 2x2-subsampled Co/Cg planes, two bytes per pixel instead of four.
+ * The YCoCg-R lifting is exact in integers, so only the chroma
+ * subsampling loses information. Alpha is not kept; warped pixels come
+ * back opaque.
+ */
+
+#ifndef FIVEM_FRAMEGEN_YCOCG_H
+#define FIVEM_FRAMEGEN_YCOCG_H
+
+#include "sampling.h"
+
+namespace FiveMFrameGen {
+namespace FrameGen {
+
+namespace YCoCgR {
+
+/**
+ * Lossless lifting; Y keeps the input range, Co and Cg need one more bit
+ */
+inline void Forward(int r, int g, int b, int& y, int& co, int& cg) {
+    co = r - b;
+    int t = b + (co >> 1);
+    cg = g - t;
+    y = t + (cg >> 1);
+}
+
+inline void Inverse(int y, int co, int cg, int& r, int& g, int& b) {
+    int t = y - (cg >> 1);
+    g = cg + t;
+    b = t - (co >> 1);
+    r = b + co;
+}
+
+} // namespace YCoCgR
+
+/**
+ * Read-only view of one planar frame
+ *
+ * Channels are transformed in storage order, so for BGRA8 Co carries the
+ * opposite sign; the round trip is the same either way.
+ */
+struct YCoCgPlanes {
+    Plane<const uint8_t> luma;      // Full resolution
+    Plane<const int16_t> co;        // (width + 1) / 2 x (height + 1) / 2
+    Plane<const int16_t> cg;
+
+    bool IsValid() const { return luma.IsValid() && co.IsValid() && cg.IsValid(); }
+
+    static uint32_t ChromaSize(uint32_t size) { return (size + 1) / 2; }
+};
+
+/**
+ * Convert an 8-bit frame; chroma is the rounded mean of each 2x2 block,
+ * edge texels repeated for odd sizes
+ *
+ * @param luma Full-size destination
+ * @param co, cg ChromaSize destinations
+ */
+template <PixelFormat F>
+void ConvertToYCoCg(const ConstFormatPlane<F>& src, const Plane<uint8_t>& luma,
+                    const Plane<int16_t>& co, const Plane<int16_t>& cg);
+
+/**
+ * Pack a YCoCg-R triple into an opaque pixel, clamping the overshoot
+ * that subsampled chroma can cause at colour edges
+ */
+template <PixelFormat F>
+inline PixelStorage<F> FromYCoCg(int y, int co, int cg) {
+    static_assert(PixelTraits<F>::PACKED_8BIT, "planar YCoCg needs 8-bit channels");
+
+    int c0, c1, c2;
+    YCoCgR::Inverse(y, co, cg, c0, c1, c2);
+    return static_cast<uint32_t>(std::clamp(c0, 0, 255)) |
+           (static_cast<uint32_t>(std::clamp(c1, 0, 255)) << 8) |
+           (static_cast<uint32_t>(std::clamp(c2, 0, 255)) << 16) | 0xFF000000u;
+}
+
+namespace Detail {
+
+/**
+ * Bilinear fetch from a scalar plane with 8-bit weights, same texel
+ * convention and rounding as SampleBilinear
+ */
+template <typename T>
+inline int SampleScalarBilinear(const Plane<const T>& plane, float x, float y) {
+    float fx = x - 0.5f;
+    float fy = y - 0.5f;
+    int x0 = static_cast<int>(fx < 0.0f ? fx - 1.0f : fx);
+    int y0 = static_cast<int>(fy < 0.0f ? fy - 1.0f : fy);
+    int ax = static_cast<int>((fx - x0) * 256.0f);
+    int ay = static_cast<int>((fy - y0) * 256.0f);
+
+    int maxX = static_cast<int>(plane.width) - 1;
+    int maxY = static_cast<int>(plane.height) - 1;
+    int x1 = std::clamp(x0 + 1, 0, maxX);
+    int y1 = std::clamp(y0 + 1, 0, maxY);
+    x0 = std::clamp(x0, 0, maxX);
+    y0 = std::clamp(y0, 0, maxY);
+
+    const T* row0 = plane.Row(y0);
+    const T* row1 = plane.Row(y1);
+    int top = row0[x0] * (256 - ax) + row0[x1] * ax;
+    int bot = row1[x0] * (256 - ax) + row1[x1] * ax;
+    return (top * (256 - ay) + bot * ay + (1 << 15)) >> 16;
+}
+
+/**
+ * Separable 4x4 fetch from a scalar plane, same convention as SampleSeparable4
+ */
+template <typename T>
+inline int SampleScalarSeparable4(const Plane<const T>& plane, float x, float y,
+                                  const FilterTable::Table& table) {
+    float fx = x - 0.5f;
+    float fy = y - 0.5f;
+    int x0 = static_cast<int>(fx < 0.0f ? fx - 1.0f : fx);
+    int y0 = static_cast<int>(fy < 0.0f ? fy - 1.0f : fy);
+    const int16_t* wx = table[static_cast<uint32_t>((fx - x0) * FilterTable::PHASES + 0.5f)].data();
+    const int16_t* wy = table[static_cast<uint32_t>((fy - y0) * FilterTable::PHASES + 0.5f)].data();
+
+    const int maxX = static_cast<int>(plane.width) - 1;
+    const int maxY = static_cast<int>(plane.height) - 1;
+    int cols[4];
+    for (int i = 0; i < 4; ++i) {
+        cols[i] = std::clamp(x0 - 1 + i, 0, maxX);
+    }
+
+    int32_t column = 0;
+    for (int j = 0; j < 4; ++j) {
+        const T* row = plane.Row(static_cast<uint32_t>(std::clamp(y0 - 1 + j, 0, maxY)));
+        int32_t sum = 0;
+        for (int i = 0; i < 4; ++i) {
+            sum += wx[i] * static_cast<int32_t>(row[cols[i]]);
+        }
+        column += wy[j] * ((sum + FilterTable::WEIGHT_ONE / 2) >> FilterTable::WEIGHT_BITS);
+    }
+    return (column + FilterTable::WEIGHT_ONE / 2) >> FilterTable::WEIGHT_BITS;
+}
+
+} // namespace Detail
+
+/**
+ * Warp fetch from planar frames: luma with the configured filter, chroma
+ * bilinear at half resolution
+ */
+template <PixelFormat F, WarpFilter Filter>
+inline PixelStorage<F> SampleWarp(const YCoCgPlanes& planes, float x, float y) {
+    int luma;
+    if constexpr (Filter == WarpFilter::Bilinear) {
+        luma = Detail::SampleScalarBilinear(planes.luma, x, y);
+    } else {
+        luma = Detail::SampleScalarSeparable4(planes.luma, x, y, FilterTable::Get<Filter>());
+    }
+    const float cx = x * 0.5f;
+    const float cy = y * 0.5f;
+    return FromYCoCg<F>(luma, Detail::SampleScalarBilinear(planes.co, cx, cy),
+                        Detail::SampleScalarBilinear(planes.cg, cx, cy));
+}
+
+} // namespace FrameGen
+} // namespace FiveMFrameGen
+
+#endif // FIVEM_FRAMEGEN_YCOCG_H
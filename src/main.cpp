@@ -28,9 +28,11 @@ namespace {
     
     // Core components
     std::unique_ptr<FiveMFrameGen::Core::Hooks> g_Hooks;
+    std::unique_ptr<FiveMFrameGen::FrameGen::TexturePool> g_TexturePool;
     std::unique_ptr<FiveMFrameGen::FrameGen::IFrameGenerator> g_FrameGenerator;
     std::unique_ptr<FiveMFrameGen::Overlay::ImGuiOverlay> g_Overlay;
     std::unique_ptr<FiveMFrameGen::Utils::ConfigManager> g_Config;
+    FiveMFrameGen::FrameGen::MemoryBudget g_MemoryBudget;
     
     // State
     bool g_Initialized = false;
@@ -40,6 +42,8 @@ namespace {
     // Error handling
     std::string g_LastError;
     
+    constexpr uint64_t BYTES_PER_MB = 1024ull * 1024ull;
+    
     // Hotkey for toggle overlay
     constexpr UINT OVERLAY_TOGGLE_KEY = VK_F10;
     constexpr UINT FRAMEGEN_TOGGLE_KEY = VK_F9;
@@ -177,6 +181,20 @@ void InitializeModSafe() {
             g_FrameGenerator = FiveMFrameGen::FrameGen::CreateFrameGenerator(FiveMFrameGen::Backend::FSR3);
         }
         
+        // Shared so that a backend switch reuses the render textures; the
+        // budget counts everything the generators allocate
+        g_MemoryBudget.SetLimit(g_FrameGenConfig.memoryBudgetMB * BYTES_PER_MB);
+        g_TexturePool = std::make_unique<FiveMFrameGen::FrameGen::TexturePool>();
+        if (g_TexturePool->Initialize(device, &g_MemoryBudget) && g_FrameGenerator) {
+            g_FrameGenerator->SetTexturePool(g_TexturePool.get());
+        }
+        if (g_FrameGenerator) {
+            g_FrameGenerator->SetLinearBlending(g_FrameGenConfig.linearBlending);
+            g_FrameGenerator->SetHudLessMode(g_FrameGenConfig.hudLessMode);
+            g_FrameGenerator->SetRegionOfInterest(g_FrameGenConfig.roi);
+            g_FrameGenerator->SetReadbackDepth(g_FrameGenConfig.readbackDepth);
+        }
+        
         if (!g_FrameGenerator || !g_FrameGenerator->Initialize(device, context, swapChain)) {
             FiveMFrameGen::Utils::Logger::Error("Failed to initialize frame generator");
             g_LastError = "Frame generator initialization failed";
@@ -194,6 +212,13 @@ void InitializeModSafe() {
         // Set up present callback
         g_Hooks->SetPresentCallback([](IDXGISwapChain* swapChain) {
             if (g_FrameGenerator && g_FrameGenConfig.enabled) {
+                // Picks up overlay edits; the generator reacts on its next frame
+                g_MemoryBudget.SetLimit(g_FrameGenConfig.memoryBudgetMB * BYTES_PER_MB);
+                g_FrameGenerator->SetLinearBlending(g_FrameGenConfig.linearBlending);
+                g_FrameGenerator->SetHudLessMode(g_FrameGenConfig.hudLessMode);
+                g_FrameGenerator->SetRegionOfInterest(g_FrameGenConfig.roi);
+                g_FrameGenerator->SetReadbackDepth(g_FrameGenConfig.readbackDepth);
+                
                 // Generate interpolated frame
                 g_FrameGenerator->ProcessFrame();
                 
@@ -202,6 +227,29 @@ void InitializeModSafe() {
                 g_Stats.outputFPS = g_FrameGenerator->GetOutputFPS();
                 g_Stats.frameTimeMs = g_FrameGenerator->GetFrameTimeMs();
                 g_Stats.framesGenerated = g_FrameGenerator->GetFramesGenerated();
+                
+                const FiveMFrameGen::FrameGen::TileKernelCounts tiles = g_FrameGenerator->GetTileKernelCounts();
+                g_Stats.tilesStatic = tiles.copied;
+                g_Stats.tilesBlended = tiles.blend;
+                g_Stats.tilesWarped = tiles.warp;
+                g_Stats.tilesFullWarp = tiles.full;
+                g_Stats.tilesReused = tiles.reused;
+                g_Stats.tilesReuseLookups = tiles.reuseLookups;
+                
+                g_Stats.memoryUsedBytes = g_MemoryBudget.GetUsage();
+                g_Stats.memoryBudgetBytes = g_MemoryBudget.GetLimit();
+                g_Stats.memoryDegradation = static_cast<uint32_t>(g_MemoryBudget.GetDegradation());
+                
+                const FiveMFrameGen::FrameGen::ReadbackRing::Stats readback = g_FrameGenerator->GetReadbackStats();
+                g_Stats.readbackLatencyFrames = readback.lastLatencyFrames;
+                g_Stats.readbackLatencyMs = readback.lastLatencyMs;
+                g_Stats.readbackNotReady = readback.notReady;
+                g_Stats.readbackDropped = readback.dropped;
+                
+                const FiveMFrameGen::FrameGen::FrameTransfer::Counters traffic = g_FrameGenerator->GetFrameTraffic();
+                g_Stats.frameCopies = traffic.copies;
+                g_Stats.frameBytesCopied = traffic.bytesMoved;
+                g_Stats.frameCopiesAliased = traffic.aliased;
             }
             
             // Render overlay
@@ -254,6 +302,7 @@ void CleanupMod() {
     // Cleanup in reverse order
     g_Overlay.reset();
     g_FrameGenerator.reset();
+    g_TexturePool.reset();
     g_Hooks.reset();
     g_Config.reset();
     
@@ -352,6 +401,9 @@ FRAMEGEN_API bool SetBackend(Backend backend) {
     if (g_Hooks && g_Initialized) {
         g_FrameGenerator = FrameGen::CreateFrameGenerator(backend);
         if (g_FrameGenerator) {
+            if (g_TexturePool && g_TexturePool->GetDevice()) {
+                g_FrameGenerator->SetTexturePool(g_TexturePool.get());
+            }
             g_FrameGenerator->Initialize(
                 g_Hooks->GetDevice(),
                 g_Hooks->GetContext(),
@@ -389,6 +441,10 @@ FRAMEGEN_API void SetConfig(const Config& config) {
     if (g_FrameGenerator) {
         g_FrameGenerator->SetQuality(config.quality);
         g_FrameGenerator->SetSharpness(config.sharpness);
+        g_FrameGenerator->SetLinearBlending(config.linearBlending);
+        g_FrameGenerator->SetHudLessMode(config.hudLessMode);
+        g_FrameGenerator->SetRegionOfInterest(config.roi);
+        g_FrameGenerator->SetReadbackDepth(config.readbackDepth);
     }
 }
 
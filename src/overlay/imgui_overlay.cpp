@@ -201,12 +201,73 @@ void ImGuiOverlay::RenderConfigWindow(Config& config, const Stats& stats) {
         
         ImGui::Spacing();
         
+        // Gamma-correct blending
+        ImGui::Checkbox("Linear-Light Blending", &config.linearBlending);
+        ImGui::SameLine();
+        ImGui::TextDisabled("(?)");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Blends frames in linear light\nto avoid dark fringes on bright edges");
+        }
+        
+        ImGui::Spacing();
+        
         // HUD mode
         ImGui::Checkbox("HUD-less Mode", &config.hudLessMode);
         ImGui::SameLine();
         ImGui::TextDisabled("(?)");
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Excludes HUD from interpolation\nto reduce UI artifacts");
+            ImGui::SetTooltip("Copies static HUD elements from the real frame\ninstead of interpolating them");
+        }
+        
+        ImGui::Spacing();
+        
+        // Foveated quality
+        ImGui::Text("Focus Region:");
+        ImGui::SameLine();
+        ImGui::TextDisabled("(?)");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Full-quality interpolation only inside this region;\ncheaper blending elsewhere");
+        }
+        const char* roiModes[] = { "Off (Full Screen)", "Centre Ellipse", "Rectangles (INI)" };
+        int roiMode = static_cast<int>(config.roi.mode);
+        if (ImGui::Combo("##FocusRegion", &roiMode, roiModes, IM_ARRAYSIZE(roiModes))) {
+            // Rectangles only come from the INI; without any there is nothing to select
+            if (roiMode != static_cast<int>(RoiMode::Rectangles) || config.roi.rectCount > 0) {
+                config.roi.mode = static_cast<RoiMode>(roiMode);
+            }
+        }
+        if (config.roi.mode == RoiMode::CenterEllipse) {
+            ImGui::SliderFloat("Width##Roi", &config.roi.radiusX, 0.05f, 1.0f, "%.2f");
+            ImGui::SliderFloat("Height##Roi", &config.roi.radiusY, 0.05f, 1.0f, "%.2f");
+        }
+        if (config.roi.mode != RoiMode::Off) {
+            ImGui::SliderFloat("Feather##Roi", &config.roi.feather, 0.0f, 0.5f, "%.2f");
+        }
+        
+        ImGui::Spacing();
+        
+        // Memory cap
+        ImGui::Text("Memory Budget:");
+        ImGui::SameLine();
+        ImGui::TextDisabled("(?)");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Caps the memory frame generation may hold;\nover it, quality steps down until it fits\n(0 = unlimited)");
+        }
+        int budgetMB = static_cast<int>(config.memoryBudgetMB);
+        if (ImGui::SliderInt("##MemoryBudget", &budgetMB, 0, 2048, budgetMB == 0 ? "Unlimited" : "%d MB")) {
+            config.memoryBudgetMB = static_cast<uint32_t>(budgetMB);
+        }
+        
+        // CPU readback ring
+        ImGui::Text("Readback Depth:");
+        ImGui::SameLine();
+        ImGui::TextDisabled("(?)");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Staging copies used to bring frames to the CPU;\nmore copies never stall but arrive later\n(0 = off)");
+        }
+        int readbackDepth = static_cast<int>(config.readbackDepth);
+        if (ImGui::SliderInt("##ReadbackDepth", &readbackDepth, 0, 8, readbackDepth == 0 ? "Off" : "%d")) {
+            config.readbackDepth = static_cast<uint32_t>(readbackDepth);
         }
         
         ImGui::Spacing();
@@ -238,6 +299,61 @@ void ImGuiOverlay::RenderConfigWindow(Config& config, const Stats& stats) {
         ImGui::Text("%llu", stats.framesGenerated);
         ImGui::NextColumn();
         
+        ImGui::Text("Tiles (blend/warp/full):");
+        ImGui::NextColumn();
+        ImGui::Text("%u / %u / %u", stats.tilesBlended, stats.tilesWarped, stats.tilesFullWarp);
+        ImGui::NextColumn();
+        
+        // Share of the frame the static-tile skip left uninterpolated
+        const uint32_t tilesTotal = stats.tilesStatic + stats.tilesBlended + stats.tilesWarped +
+            stats.tilesFullWarp + stats.tilesReused;
+        ImGui::Text("Tiles Skipped:");
+        ImGui::NextColumn();
+        ImGui::Text("%u (%.0f%%)", stats.tilesStatic,
+            tilesTotal > 0 ? 100.0f * stats.tilesStatic / tilesTotal : 0.0f);
+        ImGui::NextColumn();
+        
+        // Hit rate over the tiles local enough to be looked up at all
+        ImGui::Text("Tiles Reused:");
+        ImGui::NextColumn();
+        ImGui::Text("%u (%.0f%% hit)", stats.tilesReused,
+            stats.tilesReuseLookups > 0 ? 100.0f * stats.tilesReused / stats.tilesReuseLookups : 0.0f);
+        ImGui::NextColumn();
+        
+        ImGui::Text("Memory:");
+        ImGui::NextColumn();
+        const float usedMB = stats.memoryUsedBytes / (1024.0f * 1024.0f);
+        if (stats.memoryBudgetBytes > 0) {
+            const ImVec4 color = stats.memoryUsedBytes > stats.memoryBudgetBytes ?
+                ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+            ImGui::TextColored(color, "%.1f / %.0f MB", usedMB, stats.memoryBudgetBytes / (1024.0f * 1024.0f));
+        } else {
+            ImGui::Text("%.1f MB", usedMB);
+        }
+        ImGui::NextColumn();
+        
+        // Matches MemoryDegradation
+        const char* degradations[] = { "None", "Trim Idle", "Half Resolution" };
+        ImGui::Text("Degradation:");
+        ImGui::NextColumn();
+        ImGui::Text("%s", stats.memoryDegradation < IM_ARRAYSIZE(degradations) ?
+            degradations[stats.memoryDegradation] : "Unknown");
+        ImGui::NextColumn();
+        
+        ImGui::Text("Frame Copies:");
+        ImGui::NextColumn();
+        ImGui::Text("%llu (%llu aliased), %.0f MB", stats.frameCopies, stats.frameCopiesAliased,
+            stats.frameBytesCopied / (1024.0f * 1024.0f));
+        ImGui::NextColumn();
+        
+        if (config.readbackDepth > 0) {
+            ImGui::Text("Readback:");
+            ImGui::NextColumn();
+            ImGui::Text("%u frames / %.1f ms (%llu skipped, %llu dropped)", stats.readbackLatencyFrames,
+                stats.readbackLatencyMs, stats.readbackNotReady, stats.readbackDropped);
+            ImGui::NextColumn();
+        }
+        
         ImGui::Columns(1);
         
         ImGui::Spacing();
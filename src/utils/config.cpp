@@ -6,6 +6,7 @@
 #include "logger.h"
 
 #include <Windows.h>
+#include <algorithm>
 #include <cstdio>
 
 namespace FiveMFrameGen {
@@ -40,8 +41,40 @@ Config ConfigManager::Load() {
     config.showOverlay = ReadBool("General", "ShowOverlay", true);
     config.hudLessMode = ReadBool("General", "HudLessMode", false);
     config.sharpness = ReadFloat("General", "Sharpness", 0.5f);
+    config.linearBlending = ReadBool("General", "LinearBlending", false);
+    config.memoryBudgetMB = static_cast<uint32_t>((std::max)(ReadInt("General", "MemoryBudgetMB", 0), 0));
+    config.readbackDepth = static_cast<uint32_t>((std::clamp)(ReadInt("General", "ReadbackDepth", 0), 0, 8));
+    
+    // Region of interest; rectangles are "x, y, width, height" in screen fractions
+    config.roi.mode = static_cast<RoiMode>(ReadInt("ROI", "Mode", 0));
+    config.roi.radiusX = ReadFloat("ROI", "RadiusX", 0.30f);
+    config.roi.radiusY = ReadFloat("ROI", "RadiusY", 0.35f);
+    config.roi.feather = ReadFloat("ROI", "Feather", 0.05f);
+    config.roi.rectCount = 0;
+    for (uint32_t i = 0; i < MAX_ROI_RECTS; ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "Rect%u", i);
+        std::string value = ReadString("ROI", key, "");
+        
+        RoiRect rect;
+        if (sscanf_s(value.c_str(), "%f , %f , %f , %f", &rect.x, &rect.y, &rect.width, &rect.height) == 4 &&
+            rect.width > 0.0f && rect.height > 0.0f) {
+            config.roi.rects[config.roi.rectCount++] = rect;
+        }
+    }
     
     // Validate
+    // RoiMode is unsigned, so a negative INI value wraps and fails this too
+    if (static_cast<uint32_t>(config.roi.mode) > 2) config.roi.mode = RoiMode::Off;
+    if (config.roi.mode == RoiMode::Rectangles && config.roi.rectCount == 0) {
+        Logger::Warn("ROI mode is Rectangles but no valid Rect0-Rect%u entries; ROI disabled",
+            MAX_ROI_RECTS - 1);
+        config.roi.mode = RoiMode::Off;
+    }
+    config.roi.radiusX = std::clamp(config.roi.radiusX, 0.05f, 1.0f);
+    config.roi.radiusY = std::clamp(config.roi.radiusY, 0.05f, 1.0f);
+    config.roi.feather = std::clamp(config.roi.feather, 0.0f, 0.5f);
+    
     if (config.sharpness < 0.0f) config.sharpness = 0.0f;
     if (config.sharpness > 1.0f) config.sharpness = 1.0f;
     
@@ -61,6 +94,29 @@ void ConfigManager::Save(const Config& config) {
     WriteBool("General", "ShowOverlay", config.showOverlay);
     WriteBool("General", "HudLessMode", config.hudLessMode);
     WriteFloat("General", "Sharpness", config.sharpness);
+    WriteBool("General", "LinearBlending", config.linearBlending);
+    WriteInt("General", "MemoryBudgetMB", static_cast<int>(config.memoryBudgetMB));
+    WriteInt("General", "ReadbackDepth", static_cast<int>(config.readbackDepth));
+    
+    WriteInt("ROI", "Mode", static_cast<int>(config.roi.mode));
+    WriteFloat("ROI", "RadiusX", config.roi.radiusX);
+    WriteFloat("ROI", "RadiusY", config.roi.radiusY);
+    WriteFloat("ROI", "Feather", config.roi.feather);
+    for (uint32_t i = 0; i < MAX_ROI_RECTS; ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "Rect%u", i);
+        
+        // Unused slots are removed from the file
+        if (i >= config.roi.rectCount) {
+            WritePrivateProfileStringA("ROI", key, nullptr, m_Path.c_str());
+            continue;
+        }
+        
+        const RoiRect& rect = config.roi.rects[i];
+        char value[96];
+        snprintf(value, sizeof(value), "%.4f, %.4f, %.4f, %.4f", rect.x, rect.y, rect.width, rect.height);
+        WriteString("ROI", key, value);
+    }
 }
 
 std::string ConfigManager::ReadString(const char* section, const char* key, const char* defaultValue) {
@@ -4,11 +4,11 @@
 
 #include "logger.h"
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <mutex>
 
 namespace FiveMFrameGen {
@@ -20,21 +20,31 @@ bool Logger::s_Initialized = false;
 
 static std::mutex s_LogMutex;
 
+// "HH:MM:SS" of the last logged second, so only the milliseconds are
+// formatted per call and logging never allocates
+static char s_TimePrefix[16] = {};
+static time_t s_TimePrefixSecond = -1;
+
 void Logger::Init(const char* filename) {
     if (s_Initialized) return;
     
+    char path[512];
+#ifdef _WIN32
     // Get path in FiveM plugins directory
-    char path[MAX_PATH];
     char* appData = nullptr;
     size_t len = 0;
     _dupenv_s(&appData, &len, "LOCALAPPDATA");
     
     if (appData) {
-        snprintf(path, MAX_PATH, "%s\\FiveM\\FiveM.app\\plugins\\%s", appData, filename);
+        snprintf(path, sizeof(path), "%s\\FiveM\\FiveM.app\\plugins\\%s", appData, filename);
         free(appData);
     } else {
-        snprintf(path, MAX_PATH, "%s", filename);
+        snprintf(path, sizeof(path), "%s", filename);
     }
+#else
+    // Portable test builds have no FiveM install; log where asked
+    snprintf(path, sizeof(path), "%s", filename);
+#endif
     
     s_File = fopen(path, "w");
     if (!s_File) {
@@ -104,12 +114,16 @@ void Logger::Log(Level level, const char* format, va_list args) {
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
     
-    struct tm localTime;
-    localtime_s(&localTime, &time);
-    
-    std::stringstream ss;
-    ss << std::put_time(&localTime, "%H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
+    if (time != s_TimePrefixSecond) {
+        struct tm localTime;
+#ifdef _WIN32
+        localtime_s(&localTime, &time);
+#else
+        localtime_r(&time, &localTime);
+#endif
+        strftime(s_TimePrefix, sizeof(s_TimePrefix), "%H:%M:%S", &localTime);
+        s_TimePrefixSecond = time;
+    }
     
     // Level string
     const char* levelStr = "";
@@ -126,15 +140,17 @@ void Logger::Log(Level level, const char* format, va_list args) {
     
     // Output to file
     if (s_File) {
-        fprintf(s_File, "[%s] [%s] %s\n", ss.str().c_str(), levelStr, message);
+        fprintf(s_File, "[%s.%03d] [%s] %s\n", s_TimePrefix, static_cast<int>(ms.count()), levelStr, message);
         fflush(s_File);
     }
     
+#ifdef _WIN32
     // Output to debug console
     char debugOutput[1100];
     snprintf(debugOutput, sizeof(debugOutput), 
         "[FiveMFrameGen] [%s] %s\n", levelStr, message);
     OutputDebugStringA(debugOutput);
+#endif
 }
 
 } // namespace Utils
@@ -0,0 +1,256 @@
+/**
+ * CPU Interpolator Tests
+ *
+ * Source copy reuse: a caller that ping-pongs two buffers and rewrites
+ * them in place must get the same frames as one whose tiled or planar
+ * copies are made fresh every call. Switching the source representation
+ * must not replay copies or cached tiles made under the other one.
+ */
+
+#include "test_common.h"
+#include "frame_gen/cpu_interpolator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t WIDTH = 203;
+constexpr uint32_t HEIGHT = 117;
+constexpr uint32_t BLOCK = 8;
+
+using Frame = std::vector<uint32_t>;
+
+/**
+ * Textured frame shifted right by offset pixels
+ */
+Frame MakeFrame(uint32_t offset, uint32_t salt) {
+    Frame frame(static_cast<size_t>(WIDTH) * HEIGHT);
+    for (uint32_t y = 0; y < HEIGHT; ++y) {
+        for (uint32_t x = 0; x < WIDTH; ++x) {
+            const uint32_t sx = std::min(x + offset, WIDTH - 1);
+            frame[y * WIDTH + x] = ((sx * 7 ^ y * 3) & 255) | (((y * 5 + sx + salt) & 255) << 8) |
+                                   (((sx ^ y) & 255) << 16) | 0xFF000000u;
+        }
+    }
+    return frame;
+}
+
+struct Harness {
+    Harness() : vectors((WIDTH / BLOCK) * (HEIGHT / BLOCK)) {
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            vectors[i] = { (i % 7) * 2.7f - 5.0f, ((i / (WIDTH / BLOCK)) % 5) * 1.3f - 2.0f };
+        }
+    }
+
+    static void Configure(CpuInterpolator& engine) {
+        // Keep the engine free of state other than the source copies
+        engine.SetTileReuse(false);
+        engine.SetMotionTiers(false);
+        engine.SetStaticTileSkip(false);
+    }
+
+    bool Run(CpuInterpolator& engine, const Frame& prev, const Frame& curr, Frame& output) {
+        const MotionField motion{ vectors.data(), WIDTH / BLOCK, HEIGHT / BLOCK, BLOCK };
+        output.assign(prev.size(), 0);
+        return engine.Interpolate(
+            ConstImageView(Plane<const uint32_t>{ prev.data(), WIDTH, HEIGHT, WIDTH }),
+            ConstImageView(Plane<const uint32_t>{ curr.data(), WIDTH, HEIGHT, WIDTH }),
+            motion,
+            ImageView(Plane<uint32_t>{ output.data(), WIDTH, HEIGHT, WIDTH }),
+            0.4f);
+    }
+
+    std::vector<MotionVector> vectors;
+};
+
+/**
+ * Overwrite a frame in place, keeping its address
+ */
+void Rewrite(Frame& frame, uint32_t offset, uint32_t salt) {
+    const Frame next = MakeFrame(offset, salt);
+    std::copy(next.begin(), next.end(), frame.begin());
+}
+
+bool Same(const Frame& a, const Frame& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(uint32_t)) == 0;
+}
+
+/**
+ * Two buffers swapped every call and rewritten in place, as a capture
+ * ring of two does
+ */
+void TestTiledPingPong() {
+    Harness harness;
+    CpuInterpolator linear, tiled;
+    Harness::Configure(linear);
+    Harness::Configure(tiled);
+    CHECK(tiled.SetTiledSources(true));
+    CHECK(linear.Initialize(WIDTH, HEIGHT));
+    CHECK(tiled.Initialize(WIDTH, HEIGHT));
+
+    Frame a = MakeFrame(0, 0);
+    Frame b = MakeFrame(3, 0);
+    Frame expected, actual;
+
+    CHECK(harness.Run(linear, a, b, expected));
+    CHECK(harness.Run(tiled, a, b, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 2);
+
+    // A is rewritten with the next frame; B carries over as the previous one
+    Rewrite(a, 6, 1);
+    CHECK(harness.Run(linear, b, a, expected));
+    CHECK(harness.Run(tiled, b, a, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 1);
+
+    Rewrite(b, 9, 2);
+    CHECK(harness.Run(linear, a, b, expected));
+    CHECK(harness.Run(tiled, a, b, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 1);
+}
+
+/**
+ * A previous frame that was not the last current one is converted again
+ */
+void TestTiledBrokenStream() {
+    Harness harness;
+    CpuInterpolator linear, tiled;
+    Harness::Configure(linear);
+    Harness::Configure(tiled);
+    CHECK(tiled.SetTiledSources(true));
+    CHECK(linear.Initialize(WIDTH, HEIGHT));
+    CHECK(tiled.Initialize(WIDTH, HEIGHT));
+
+    Frame a = MakeFrame(0, 0);
+    Frame b = MakeFrame(3, 0);
+    Frame c = MakeFrame(6, 0);
+    Frame expected, actual;
+
+    CHECK(harness.Run(tiled, a, b, actual));
+
+    // Same previous buffer again, now holding other content
+    Rewrite(a, 2, 5);
+    CHECK(harness.Run(linear, a, c, expected));
+    CHECK(harness.Run(tiled, a, c, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 2);
+
+    // One buffer as both frames
+    CHECK(harness.Run(linear, c, c, expected));
+    CHECK(harness.Run(tiled, c, c, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 2);
+}
+
+/**
+ * Planar copies, including the previous luma the bilateral motion
+ * upsampler reads; the reference drops its copies before every call
+ */
+void TestPlanarPingPong() {
+    Harness harness;
+    CpuInterpolator fresh, planar;
+    for (CpuInterpolator* engine : { &fresh, &planar }) {
+        Harness::Configure(*engine);
+        engine->SetBilateralMotion(true);
+        CHECK(engine->SetPlanarYCoCg(true));
+        CHECK(engine->Initialize(WIDTH, HEIGHT));
+    }
+
+    Frame a = MakeFrame(0, 0);
+    Frame b = MakeFrame(3, 0);
+    Frame expected, actual;
+
+    const uint32_t expectedConversions[] = { 2, 1, 1, 1 };
+    for (int step = 0; step < 4; ++step) {
+        Frame& prev = (step & 1) ? b : a;
+        Frame& curr = (step & 1) ? a : b;
+        if (step > 0) {
+            Rewrite(curr, 3 * (step + 1), step);
+        }
+
+        fresh.InvalidateSources();
+        CHECK(harness.Run(fresh, prev, curr, expected));
+        CHECK(harness.Run(planar, prev, curr, actual));
+        CHECK(Same(expected, actual));
+        CHECK(planar.GetLastFrameStats().sourceConversions == expectedConversions[step]);
+    }
+}
+
+/**
+ * Planar sources subsample chroma, so tiles cached from linear sources
+ * must not be replayed once planar mode is on
+ */
+void TestPlanarToggleMissesTileCache() {
+    Harness harness;
+    CpuInterpolator fresh, toggled;
+    for (CpuInterpolator* engine : { &fresh, &toggled }) {
+        Harness::Configure(*engine);
+        engine->SetTileReuse(true);
+    }
+    CHECK(fresh.SetPlanarYCoCg(true));
+    CHECK(fresh.Initialize(WIDTH, HEIGHT));
+    CHECK(toggled.Initialize(WIDTH, HEIGHT));
+
+    const Frame a = MakeFrame(0, 0);
+    const Frame b = MakeFrame(3, 0);
+    Frame expected, actual;
+
+    CHECK(harness.Run(toggled, a, b, actual));
+    CHECK(toggled.SetPlanarYCoCg(true));
+    CHECK(harness.Run(fresh, a, b, expected));
+    CHECK(harness.Run(toggled, a, b, actual));
+    CHECK(Same(expected, actual));
+    CHECK(toggled.GetLastFrameStats().tilesReused == 0);
+}
+
+/**
+ * Calls made with planar sources on do not hand frames over to the tiled
+ * copies, so turning planar mode off must not reuse one
+ */
+void TestPlanarToggleDropsTiledCopies() {
+    Harness harness;
+    CpuInterpolator linear, tiled;
+    Harness::Configure(linear);
+    Harness::Configure(tiled);
+    CHECK(tiled.SetTiledSources(true));
+    CHECK(linear.Initialize(WIDTH, HEIGHT));
+    CHECK(tiled.Initialize(WIDTH, HEIGHT));
+
+    Frame a = MakeFrame(0, 0);
+    Frame b = MakeFrame(3, 0);
+    Frame expected, actual;
+
+    // The tiled copies last saw B as the current frame
+    CHECK(harness.Run(tiled, a, b, actual));
+
+    CHECK(tiled.SetPlanarYCoCg(true));
+    Rewrite(a, 6, 1);
+    CHECK(harness.Run(tiled, b, a, actual));
+    Rewrite(b, 9, 2);
+    CHECK(harness.Run(tiled, a, b, actual));
+    CHECK(tiled.SetPlanarYCoCg(false));
+
+    // B is the last current frame again, but rewritten since it was tiled
+    Rewrite(a, 12, 3);
+    CHECK(harness.Run(linear, b, a, expected));
+    CHECK(harness.Run(tiled, b, a, actual));
+    CHECK(Same(expected, actual));
+    CHECK(tiled.GetLastFrameStats().sourceConversions == 2);
+}
+
+} // namespace
+
+int main() {
+    TestTiledPingPong();
+    TestTiledBrokenStream();
+    TestPlanarPingPong();
+    TestPlanarToggleMissesTileCache();
+    TestPlanarToggleDropsTiledCopies();
+    return FiveMFrameGen::Test::Finish("cpu_interpolator_test");
+}
@@ -0,0 +1,157 @@
+/**
+ * Frame Handle Tests
+ *
+ * FrameTable reference counting and FrameTransfer over
+ * MemoryStagingDevice, following the backend's capture and present
+ * steps: copies between aliased handles are skipped, the rest reach the
+ * device, and the counters add up.
+ */
+
+#include "test_common.h"
+#include "frame_gen/frame_handle.h"
+
+#include <utility>
+#include <vector>
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+constexpr uint64_t FRAME_BYTES = WIDTH * HEIGHT * 4;
+
+int s_Released = 0;
+
+void CountRelease(void*) {
+    ++s_Released;
+}
+
+struct Image {
+    Image() : pixels(WIDTH * HEIGHT), view(pixels.data(), WIDTH, HEIGHT, WIDTH * sizeof(uint32_t)) {}
+
+    void Fill(uint32_t value) {
+        for (uint32_t& pixel : pixels) {
+            pixel = value;
+        }
+    }
+
+    std::vector<uint32_t> pixels;
+    ImageView view;
+};
+
+/**
+ * Capture into alternating history slots, then present either through a
+ * separate output (one more copy) or straight into the back buffer
+ * (aliased, no copy)
+ */
+void RunFrames(bool directToBackBuffer) {
+    MemoryStagingDevice device;
+    FrameTable table;
+    FrameTransfer transfer;
+    transfer.SetDevice(&device);
+    s_Released = 0;
+
+    Image backBuffer, output, history[2];
+    const FrameHandle outputHandle = table.Adopt(&output.view, FRAME_BYTES);
+
+    constexpr uint32_t FRAMES = 10;
+    for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+        backBuffer.Fill(frame);
+
+        // The swap chain hands out one reference per call; a second Adopt
+        // shares the entry and drops its extra reference at once
+        const FrameHandle back = table.Adopt(&backBuffer.view, FRAME_BYTES, CountRelease);
+        const FrameHandle again = table.Adopt(&backBuffer.view, FRAME_BYTES, CountRelease);
+        CHECK(back.Aliases(again));
+        CHECK(back.GetRefCount() == 2);
+        CHECK(s_Released == static_cast<int>(2 * frame + 1));
+
+        // Capture
+        Image& slot = history[frame % 2];
+        CHECK(transfer.Copy(table.Adopt(&slot.view, FRAME_BYTES), back));
+        CHECK(slot.pixels[7] == frame);
+
+        // Generate into the output, or render straight into the back buffer
+        const FrameHandle& generated = directToBackBuffer ? back : outputHandle;
+        if (directToBackBuffer) {
+            backBuffer.Fill(100 + frame);
+        } else {
+            output.Fill(100 + frame);
+        }
+        CHECK(transfer.Copy(back, generated));
+        CHECK(backBuffer.pixels[3] == 100 + frame);
+    }
+
+    // Every back buffer reference is released with its handles
+    CHECK(s_Released == static_cast<int>(2 * FRAMES));
+    CHECK(table.GetLive() == 1);
+
+    const FrameTransfer::Counters& counters = transfer.GetCounters();
+    const uint64_t presentCopies = directToBackBuffer ? 0 : FRAMES;
+    CHECK(counters.copies == FRAMES + presentCopies);
+    CHECK(counters.aliased == FRAMES - presentCopies);
+    CHECK(counters.copies + counters.aliased == 2 * FRAMES);
+    CHECK(counters.bytesMoved == counters.copies * FRAME_BYTES);
+    CHECK(device.GetCounters().frameCopies == counters.copies);
+    CHECK(device.GetCounters().bytesFrameCopied == counters.bytesMoved);
+}
+
+void TestHandleLifetime() {
+    FrameTable table;
+    int resource = 0;
+    s_Released = 0;
+
+    FrameHandle first = table.Adopt(&resource, 16, CountRelease);
+    CHECK(first.Get() == &resource);
+    CHECK(first.GetBytes() == 16);
+    CHECK(table.GetLive() == 1);
+
+    FrameHandle copy = first;
+    CHECK(first.GetRefCount() == 2);
+    FrameHandle moved = std::move(copy);
+    CHECK(!copy);
+    CHECK(moved.GetRefCount() == 2);
+
+    first.Reset();
+    CHECK(s_Released == 0);
+    moved.Reset();
+    CHECK(s_Released == 1);
+    CHECK(table.GetLive() == 0);
+
+    CHECK(!table.Adopt(nullptr, 16));
+}
+
+void TestTableFull() {
+    FrameTable table;
+    int resources[FrameTable::CAPACITY + 1] = {};
+    std::vector<FrameHandle> handles;
+    for (uint32_t i = 0; i < FrameTable::CAPACITY; ++i) {
+        handles.push_back(table.Adopt(&resources[i], 16));
+        CHECK(handles.back());
+    }
+    CHECK(table.GetLive() == FrameTable::CAPACITY);
+
+    // A full table refuses new resources, releasing the caller's reference
+    s_Released = 0;
+    CHECK(!table.Adopt(&resources[FrameTable::CAPACITY], 16, CountRelease));
+    CHECK(s_Released == 1);
+
+    // An empty handle makes the transfer fail without touching the device
+    MemoryStagingDevice device;
+    FrameTransfer transfer;
+    transfer.SetDevice(&device);
+    CHECK(!transfer.Copy(FrameHandle(), handles[0]));
+    CHECK(transfer.GetCounters().copies == 0);
+    CHECK(device.GetCounters().frameCopies == 0);
+}
+
+} // namespace
+
+int main() {
+    RunFrames(false);
+    RunFrames(true);
+    TestHandleLifetime();
+    TestTableFull();
+    return FiveMFrameGen::Test::Finish("frame_handle_test");
+}
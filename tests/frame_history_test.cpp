@@ -0,0 +1,108 @@
+/**
+ * Frame History Tests
+ *
+ * Ring order and the fill-then-advance capture protocol over a slot type
+ * that only records what was written to it, and the frame time average.
+ */
+
+#include "test_common.h"
+#include "frame_gen/frame_history.h"
+#include "frame_gen/frame_time_history.h"
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+struct TestFrame {
+    bool Create(int initial) {
+        value = initial;
+        created = true;
+        return true;
+    }
+
+    void Release() { created = false; }
+
+    int value = 0;
+    bool created = false;
+};
+
+/**
+ * Capture like the backend: fill the next slot, advance only on success
+ */
+bool Capture(FrameHistory<3, TestFrame>& history, int value, bool copySucceeds) {
+    TestFrame& slot = history.Next();
+    if (!copySucceeds) return false;
+    slot.value = value;
+    history.Advance();
+    return true;
+}
+
+void TestOrder() {
+    FrameHistory<3, TestFrame> history;
+    CHECK(history.Initialize(-1));
+    CHECK(history.GetFrameCount() == 0);
+    CHECK(history.Get(0) == nullptr);
+
+    for (int frame = 1; frame <= 5; ++frame) {
+        CHECK(Capture(history, frame, true));
+    }
+    CHECK(history.GetFrameCount() == 3);
+    CHECK(history.Get(0)->value == 5);
+    CHECK(history.Get(1)->value == 4);
+    CHECK(history.Get(2)->value == 3);
+    CHECK(history.Get(3) == nullptr);
+
+    history.Clear();
+    CHECK(history.GetFrameCount() == 0);
+    CHECK(history.Get(0) == nullptr);
+}
+
+void TestFailedCaptureKeepsHistory() {
+    FrameHistory<3, TestFrame> history;
+    CHECK(history.Initialize(-1));
+
+    CHECK(Capture(history, 1, true));
+    CHECK(!Capture(history, 2, false));
+    CHECK(history.GetFrameCount() == 1);
+    CHECK(history.Get(0)->value == 1);
+    CHECK(history.Get(1) == nullptr);
+
+    CHECK(Capture(history, 3, true));
+    CHECK(history.GetFrameCount() == 2);
+    CHECK(history.Get(0)->value == 3);
+    CHECK(history.Get(1)->value == 1);
+
+    // Next names the slot Advance hands out
+    TestFrame* next = &history.Next();
+    CHECK(&history.Advance() == next);
+}
+
+void TestFrameTimeAverage() {
+    FrameTimeHistory<4> timing;
+    CHECK(timing.GetAverage() == 0.0f);
+
+    timing.Push(10.0f);
+    timing.Push(20.0f);
+    CHECK(timing.GetCount() == 2);
+    CHECK(timing.GetAverage() == 15.0f);
+
+    // The oldest times fall out once the ring is full
+    for (int i = 0; i < 4; ++i) {
+        timing.Push(8.0f);
+    }
+    CHECK(timing.GetCount() == 4);
+    CHECK(timing.GetAverage() == 8.0f);
+
+    timing.Clear();
+    CHECK(timing.GetCount() == 0);
+    CHECK(timing.GetAverage() == 0.0f);
+}
+
+} // namespace
+
+int main() {
+    TestOrder();
+    TestFailedCaptureKeepsHistory();
+    TestFrameTimeAverage();
+    return FiveMFrameGen::Test::Finish("frame_history_test");
+}
@@ -0,0 +1,595 @@
+/**
+ * Frame Generation Benchmarks
+ *
+ * Time and quality of the CPU engine's options on synthetic pans with an
+ * analytic ground truth. Run by hand as framegen_bench [case ...]; with
+ * --quick every case runs once on a small frame, which is how CTest runs
+ * it so the cases keep working.
+ */
+
+#include "frame_gen/cpu_interpolator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t BLOCK = 8;
+constexpr uint32_t QUICK_WIDTH = 256;
+constexpr uint32_t QUICK_HEIGHT = 144;
+constexpr int RUNS = 9;
+
+// Border left out of the PSNR, where warps fetch off-screen
+constexpr uint32_t MARGIN = 16;
+
+// Distance from the box's edges counted as the edge region, in pixels
+constexpr float EDGE_BAND = 8.0f;
+
+bool g_Quick = false;
+
+using Frame = std::vector<uint32_t>;
+
+struct Size {
+    uint32_t width;
+    uint32_t height;
+};
+
+/**
+ * Benchmark frame size, or the small one in quick mode
+ */
+Size Pick(uint32_t width, uint32_t height) {
+    return g_Quick ? Size{ QUICK_WIDTH, QUICK_HEIGHT } : Size{ width, height };
+}
+
+/**
+ * Panning scene with an optional box moving across it
+ *
+ * Each channel is a smooth product term plus a fine one with a period of a
+ * few pixels, both separable, so a frame costs a few multiplies per pixel
+ * and the scene can be evaluated at any fractional position. Pixel x of the
+ * frame at time t shows the scene at x + 0.5 - velocity * t.
+ */
+class Scene {
+public:
+    Scene(Size size, float vx, float vy) : m_Width(size.width), m_Height(size.height), m_Vx(vx), m_Vy(vy) {}
+
+    /**
+     * Add a box of half the screen size, centred at time 0 and moving at
+     * its own velocity, with its own texture
+     */
+    void SetBox(float vx, float vy) {
+        m_Box = true;
+        m_BoxVx = vx;
+        m_BoxVy = vy;
+    }
+
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+
+    void Render(float t, Frame& frame) const {
+        frame.resize(static_cast<size_t>(m_Width) * m_Height);
+
+        Axis columns, rows, boxColumns, boxRows;
+        columns.Fill(m_Width, -m_Vx * t, BACKGROUND_X);
+        rows.Fill(m_Height, -m_Vy * t, BACKGROUND_Y);
+
+        float boxX0 = 0.0f, boxY0 = 0.0f;
+        if (m_Box) {
+            BoxOrigin(t, boxX0, boxY0);
+            boxColumns.Fill(m_Width, -boxX0, BOX_X);
+            boxRows.Fill(m_Height, -boxY0, BOX_Y);
+        }
+
+        for (uint32_t y = 0; y < m_Height; ++y) {
+            for (uint32_t x = 0; x < m_Width; ++x) {
+                const bool inBox = m_Box && InBox(x + 0.5f, y + 0.5f, boxX0, boxY0);
+                frame[static_cast<size_t>(y) * m_Width + x] =
+                    inBox ? Texel(boxColumns, boxRows, x, y) : Texel(columns, rows, x, y);
+            }
+        }
+    }
+
+    /**
+     * Block vectors (prev -> curr) at the blocks' positions at time t
+     */
+    MotionField Motion(float t, std::vector<MotionVector>& vectors) const {
+        const uint32_t blocksX = m_Width / BLOCK;
+        const uint32_t blocksY = m_Height / BLOCK;
+        vectors.resize(static_cast<size_t>(blocksX) * blocksY);
+
+        float boxX0 = 0.0f, boxY0 = 0.0f;
+        BoxOrigin(t, boxX0, boxY0);
+        for (uint32_t by = 0; by < blocksY; ++by) {
+            for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                const bool inBox = m_Box && InBox((bx + 0.5f) * BLOCK, (by + 0.5f) * BLOCK, boxX0, boxY0);
+                vectors[static_cast<size_t>(by) * blocksX + bx] =
+                    inBox ? MotionVector{ m_BoxVx, m_BoxVy } : MotionVector{ m_Vx, m_Vy };
+            }
+        }
+        return { vectors.data(), blocksX, blocksY, BLOCK };
+    }
+
+    /**
+     * Flag the pixels within band of the box's edges at time t
+     *
+     * @return False if the scene has no box
+     */
+    bool EdgeMask(float t, float band, std::vector<uint8_t>& mask) const {
+        if (!m_Box) return false;
+
+        float boxX0 = 0.0f, boxY0 = 0.0f;
+        BoxOrigin(t, boxX0, boxY0);
+        const float boxX1 = boxX0 + m_Width * 0.5f;
+        const float boxY1 = boxY0 + m_Height * 0.5f;
+        mask.resize(static_cast<size_t>(m_Width) * m_Height);
+        for (uint32_t y = 0; y < m_Height; ++y) {
+            for (uint32_t x = 0; x < m_Width; ++x) {
+                const float px = x + 0.5f, py = y + 0.5f;
+                const bool outer = px >= boxX0 - band && px < boxX1 + band && py >= boxY0 - band && py < boxY1 + band;
+                const bool inner = px >= boxX0 + band && px < boxX1 - band && py >= boxY0 + band && py < boxY1 - band;
+                mask[static_cast<size_t>(y) * m_Width + x] = outer && !inner;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Frequencies {
+        float low[3];
+        float high[3];
+    };
+
+    static constexpr Frequencies BACKGROUND_X = { { 0.031f, 0.023f, 0.041f }, { 1.1f, 1.3f, 0.9f } };
+    static constexpr Frequencies BACKGROUND_Y = { { 0.027f, 0.037f, 0.019f }, { 0.8f, 1.0f, 1.2f } };
+    static constexpr Frequencies BOX_X = { { 0.043f, 0.017f, 0.029f }, { 0.7f, 1.2f, 1.4f } };
+    static constexpr Frequencies BOX_Y = { { 0.021f, 0.033f, 0.047f }, { 1.3f, 0.9f, 1.1f } };
+
+    /**
+     * Per-channel terms along one axis at pixel centres plus an offset
+     */
+    struct Axis {
+        std::vector<float> low[3];
+        std::vector<float> high[3];
+
+        void Fill(uint32_t count, float offset, const Frequencies& frequencies) {
+            for (int c = 0; c < 3; ++c) {
+                low[c].resize(count);
+                high[c].resize(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    const float u = i + 0.5f + offset;
+                    low[c][i] = std::sin(u * frequencies.low[c] + c);
+                    high[c][i] = std::sin(u * frequencies.high[c] + 2 * c);
+                }
+            }
+        }
+    };
+
+    static uint32_t Texel(const Axis& columns, const Axis& rows, uint32_t x, uint32_t y) {
+        uint32_t texel = 0xFF000000u;
+        for (int c = 0; c < 3; ++c) {
+            const float value = 128.0f + 64.0f * columns.low[c][x] * rows.low[c][y] +
+                                48.0f * columns.high[c][x] * rows.high[c][y];
+            texel |= static_cast<uint32_t>(std::clamp(value + 0.5f, 0.0f, 255.0f)) << (8 * c);
+        }
+        return texel;
+    }
+
+    void BoxOrigin(float t, float& x0, float& y0) const {
+        x0 = m_Width * 0.25f + m_BoxVx * t;
+        y0 = m_Height * 0.25f + m_BoxVy * t;
+    }
+
+    bool InBox(float x, float y, float x0, float y0) const {
+        return x >= x0 && x < x0 + m_Width * 0.5f && y >= y0 && y < y0 + m_Height * 0.5f;
+    }
+
+    uint32_t m_Width;
+    uint32_t m_Height;
+    float m_Vx;
+    float m_Vy;
+    bool m_Box = false;
+    float m_BoxVx = 0.0f;
+    float m_BoxVy = 0.0f;
+};
+
+/**
+ * Minor page faults of the process so far, or 0 where unsupported
+ */
+uint64_t MinorFaults() {
+#if defined(__unix__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<uint64_t>(usage.ru_minflt);
+#endif
+    return 0;
+}
+
+/**
+ * RGB PSNR inside the margin, optionally only over flagged pixels
+ */
+double Psnr(const Frame& a, const Frame& b, uint32_t width, uint32_t height, const uint8_t* mask = nullptr) {
+    double sum = 0.0;
+    uint64_t count = 0;
+    for (uint32_t y = MARGIN; y + MARGIN < height; ++y) {
+        for (uint32_t x = MARGIN; x + MARGIN < width; ++x) {
+            if (mask && !mask[static_cast<size_t>(y) * width + x]) continue;
+            const uint32_t pa = a[static_cast<size_t>(y) * width + x];
+            const uint32_t pb = b[static_cast<size_t>(y) * width + x];
+            for (int c = 0; c < 3; ++c) {
+                const int d = static_cast<int>((pa >> (8 * c)) & 255) - static_cast<int>((pb >> (8 * c)) & 255);
+                sum += d * d;
+            }
+            count += 3;
+        }
+    }
+    if (count == 0 || sum == 0.0) return 99.0;
+    return 10.0 * std::log10(255.0 * 255.0 * count / sum);
+}
+
+struct Result {
+    double ms = 0.0;        // Median Interpolate time
+    double psnr = 0.0;      // Last frame against the scene at its time
+    double edgePsnr = 0.0;  // Same, near the box's edges (0 without a box)
+    uint64_t setupFaults = 0;   // Minor page faults in Initialize and the first frame
+    double frameFaults = 0.0;   // Minor page faults per later frame
+    CpuInterpolator::FrameStats stats;
+};
+
+/**
+ * Disable the per-tile shortcuts, so every tile runs the kernel under test
+ */
+void Configure(CpuInterpolator& engine) {
+    engine.SetTileReuse(false);
+    engine.SetMotionTiers(false);
+}
+
+/**
+ * Generate the midpoint of successive frames of a scene, fed as a capture
+ * ring of two buffers that are rewritten in place
+ */
+bool Measure(CpuInterpolator& engine, const Scene& scene, Result& result) {
+    const uint32_t width = scene.GetWidth();
+    const uint32_t height = scene.GetHeight();
+    const int runs = g_Quick ? 1 : RUNS;
+    uint64_t faults = MinorFaults();
+    if (!engine.Initialize(width, height)) return false;
+    uint64_t setupFaults = MinorFaults() - faults;
+    uint64_t frameFaults = 0;
+
+    Frame frames[2], output(static_cast<size_t>(width) * height), truth;
+    std::vector<MotionVector> vectors;
+    std::vector<double> times;
+    scene.Render(0.0f, frames[0]);
+    scene.Render(1.0f, frames[1]);
+
+    for (int run = 0; run < runs; ++run) {
+        const Frame& prev = frames[run & 1];
+        const Frame& curr = frames[(run + 1) & 1];
+        const MotionField motion = scene.Motion(run + 0.5f, vectors);
+
+        faults = MinorFaults();
+        const auto start = std::chrono::steady_clock::now();
+        const bool generated = engine.Interpolate(
+            ConstImageView(Plane<const uint32_t>{ prev.data(), width, height, width }),
+            ConstImageView(Plane<const uint32_t>{ curr.data(), width, height, width }),
+            motion,
+            ImageView(Plane<uint32_t>{ output.data(), width, height, width }),
+            0.5f);
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        (run == 0 ? setupFaults : frameFaults) += MinorFaults() - faults;
+        if (!generated) return false;
+
+        if (run + 1 < runs) {
+            scene.Render(run + 2.0f, frames[run & 1]);
+        }
+    }
+
+    scene.Render(runs - 0.5f, truth);
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    result.ms = times[times.size() / 2];
+    result.psnr = Psnr(output, truth, width, height);
+    std::vector<uint8_t> edges;
+    if (scene.EdgeMask(runs - 0.5f, EDGE_BAND, edges)) {
+        result.edgePsnr = Psnr(output, truth, width, height, edges.data());
+    }
+    result.setupFaults = setupFaults;
+    result.frameFaults = runs > 1 ? static_cast<double>(frameFaults) / (runs - 1) : 0.0;
+    result.stats = engine.GetLastFrameStats();
+    return true;
+}
+
+void Report(const char* label, const Result& result, const Result& baseline) {
+    std::printf("  %-24s %9.2f ms  %+6.1f%%  %6.2f dB", label, result.ms, 100.0 * (result.ms / baseline.ms - 1.0),
+                result.psnr);
+    if (result.edgePsnr > 0.0) {
+        std::printf("  %6.2f dB at edges", result.edgePsnr);
+    }
+    std::printf("\n");
+}
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+/**
+ * Performance preset: interpolate at half resolution, guided upsample
+ */
+bool BenchHalfResolution() {
+    const Scene scene(Pick(1920, 1080), 5.0f, 3.0f);
+    std::printf("half_resolution: %ux%u pan (5, 3)\n", scene.GetWidth(), scene.GetHeight());
+
+    CpuInterpolator full, half;
+    Configure(full);
+    Configure(half);
+    if (!half.SetHalfResolution(true)) return false;
+
+    Result fullResult, halfResult;
+    if (!Measure(full, scene, fullResult) || !Measure(half, scene, halfResult)) return false;
+
+    Report("full resolution", fullResult, fullResult);
+    Report("half resolution", halfResult, fullResult);
+    return true;
+}
+
+/**
+ * Linear-light blending of the two warped samples against gamma-space lerp
+ */
+bool BenchLinearBlending() {
+    Scene scene(Pick(1920, 1080), 5.0f, 3.0f);
+    scene.SetBox(-4.0f, 1.0f);
+    std::printf("linear_blending: %ux%u pan (5, 3), box (-4, 1)\n", scene.GetWidth(), scene.GetHeight());
+
+    CpuInterpolator gamma, linear;
+    Configure(gamma);
+    Configure(linear);
+    linear.SetLinearBlending(true);
+
+    Result gammaResult, linearResult;
+    if (!Measure(gamma, scene, gammaResult) || !Measure(linear, scene, linearResult)) return false;
+
+    Report("gamma-space blend", gammaResult, gammaResult);
+    Report("linear-light blend", linearResult, gammaResult);
+    return true;
+}
+
+/**
+ * Sharpening fused into the warp/blend rows against a separate pass
+ */
+bool BenchFusedKernel() {
+    for (const Size size : { Pick(1920, 1080), Pick(3840, 2160) }) {
+        const Scene scene(size, 5.0f, 3.0f);
+        std::printf("fused_kernel: %ux%u pan (5, 3), sharpness 0.5\n", scene.GetWidth(), scene.GetHeight());
+
+        CpuInterpolator unsharpened, multiPass, fused;
+        for (CpuInterpolator* engine : { &unsharpened, &multiPass, &fused }) {
+            Configure(*engine);
+            engine->SetSharpness(0.5f);
+        }
+        unsharpened.SetSharpness(0.0f);
+        multiPass.SetFusedKernel(false);
+
+        Result unsharpenedResult, multiPassResult, fusedResult;
+        if (!Measure(unsharpened, scene, unsharpenedResult) || !Measure(multiPass, scene, multiPassResult) ||
+            !Measure(fused, scene, fusedResult)) {
+            return false;
+        }
+
+        Report("warp, then sharpen", multiPassResult, multiPassResult);
+        Report("fused", fusedResult, multiPassResult);
+        Report("no sharpening", unsharpenedResult, multiPassResult);
+    }
+    return true;
+}
+
+/**
+ * Overlapped block compensation against bilinearly filtered block vectors,
+ * on uniform motion and across the edges of a box moving the other way
+ */
+bool BenchOverlappedBlocks() {
+    Scene pan(Pick(1920, 1080), 5.0f, 3.0f);
+    Scene box(Pick(1920, 1080), 5.0f, 3.0f);
+    box.SetBox(-6.0f, -2.0f);
+
+    for (const Scene* scene : { &pan, &box }) {
+        std::printf("overlapped_blocks: %ux%u pan (5, 3)%s\n", scene->GetWidth(), scene->GetHeight(),
+                    scene == &box ? ", box (-6, -2)" : "");
+
+        CpuInterpolator bilinear, overlapped;
+        Configure(bilinear);
+        Configure(overlapped);
+        overlapped.SetOverlappedBlocks(true);
+
+        Result bilinearResult, overlappedResult;
+        if (!Measure(bilinear, *scene, bilinearResult) || !Measure(overlapped, *scene, overlappedResult)) {
+            return false;
+        }
+
+        Report("bilinear vectors", bilinearResult, bilinearResult);
+        Report("overlapped blocks", overlappedResult, bilinearResult);
+    }
+    return true;
+}
+
+/**
+ * 4x4 warp filters against bilinear at fractional offsets; at exactly half
+ * a pixel both 4x4 tables quantize to the same taps, so the pan avoids it
+ */
+bool BenchWarpFilter() {
+    const Scene scene(Pick(1920, 1080), 4.6f, 2.7f);
+    std::printf("warp_filter: %ux%u pan (4.6, 2.7)\n", scene.GetWidth(), scene.GetHeight());
+
+    const struct {
+        const char* label;
+        WarpFilter filter;
+    } filters[] = {
+        { "bilinear", WarpFilter::Bilinear },
+        { "Catmull-Rom", WarpFilter::CatmullRom },
+        { "Lanczos-2", WarpFilter::Lanczos2 },
+    };
+
+    Result baseline;
+    for (const auto& entry : filters) {
+        CpuInterpolator engine;
+        Configure(engine);
+        engine.SetWarpFilter(entry.filter);
+
+        Result result;
+        if (!Measure(engine, scene, result)) return false;
+        if (entry.filter == WarpFilter::Bilinear) baseline = result;
+        Report(entry.label, result, baseline);
+    }
+    return true;
+}
+
+/**
+ * Foveated quality: the default focus ellipse against full quality
+ * everywhere, with the Quality preset's filter and per-pixel flow
+ */
+bool BenchRegionOfInterest() {
+    const Scene scene(Pick(1920, 1080), 4.6f, 2.7f);
+    std::printf("region_of_interest: %ux%u pan (4.6, 2.7), Lanczos-2, bilateral flow\n", scene.GetWidth(),
+                scene.GetHeight());
+
+    CpuInterpolator everywhere, foveated;
+    for (CpuInterpolator* engine : { &everywhere, &foveated }) {
+        Configure(*engine);
+        engine->SetWarpFilter(WarpFilter::Lanczos2);
+        engine->SetBilateralMotion(true);
+    }
+
+    // RoiConfig's defaults; the public header needs Windows
+    foveated.SetRoiEllipse(0.30f, 0.35f, 0.05f);
+
+    Result everywhereResult, foveatedResult;
+    if (!Measure(everywhere, scene, everywhereResult) || !Measure(foveated, scene, foveatedResult)) return false;
+
+    Report("full quality everywhere", everywhereResult, everywhereResult);
+    Report("default ellipse", foveatedResult, everywhereResult);
+    std::printf("  %.0f%% of tiles outside, %u in the feather band\n",
+                100.0 * foveatedResult.stats.RoiReducedRatio(), foveatedResult.stats.tilesRoiBlended);
+    return true;
+}
+
+/**
+ * Huge-page backing of the engine's arenas at 4K: page faults while the
+ * planes are first touched and in steady state, and the frame time
+ */
+bool BenchFrameArena() {
+    const Scene scene(Pick(3840, 2160), 5.0f, 3.0f);
+    std::printf("frame_arena: %ux%u pan (5, 3)\n", scene.GetWidth(), scene.GetHeight());
+
+    Result baseline;
+    for (const bool hugePages : { false, true }) {
+        CpuInterpolator engine;
+        Configure(engine);
+        engine.SetHugePages(hugePages);
+
+        Result result;
+        if (!Measure(engine, scene, result)) return false;
+        if (!hugePages) baseline = result;
+
+        Report(hugePages ? "huge pages" : "normal pages", result, baseline);
+        std::printf("    backed by huge pages: %s, %llu faults to set up, %.1f per frame after\n",
+                    engine.IsHugePages() ? "yes" : "no", static_cast<unsigned long long>(result.setupFaults),
+                    result.frameFaults);
+    }
+    return true;
+}
+
+/**
+ * Warp fetches from 8x8-tiled source copies against the linear frames,
+ * for pans along each axis and the diagonal
+ */
+bool BenchTiledSources() {
+    const struct {
+        const char* label;
+        float vx, vy;
+    } pans[] = {
+        { "horizontal", 7.4f, 0.0f },
+        { "vertical", 0.0f, 7.4f },
+        { "diagonal", 5.2f, 5.2f },
+    };
+
+    for (const auto& pan : pans) {
+        const Scene scene(Pick(1920, 1080), pan.vx, pan.vy);
+        for (const WarpFilter filter : { WarpFilter::Bilinear, WarpFilter::Lanczos2 }) {
+            std::printf("tiled_sources: %ux%u %s pan (%.1f, %.1f), %s\n", scene.GetWidth(), scene.GetHeight(),
+                        pan.label, pan.vx, pan.vy, GetWarpFilterName(filter));
+
+            CpuInterpolator linear, tiled;
+            for (CpuInterpolator* engine : { &linear, &tiled }) {
+                Configure(*engine);
+                engine->SetWarpFilter(filter);
+            }
+            if (!tiled.SetTiledSources(true)) return false;
+
+            Result linearResult, tiledResult;
+            if (!Measure(linear, scene, linearResult) || !Measure(tiled, scene, tiledResult)) return false;
+
+            Report("linear sources", linearResult, linearResult);
+            Report("tiled sources", tiledResult, linearResult);
+        }
+    }
+    return true;
+}
+
+struct Case {
+    const char* name;
+    bool (*run)();
+};
+
+const Case CASES[] = {
+    { "half_resolution", BenchHalfResolution },
+    { "linear_blending", BenchLinearBlending },
+    { "fused_kernel", BenchFusedKernel },
+    { "overlapped_blocks", BenchOverlappedBlocks },
+    { "warp_filter", BenchWarpFilter },
+    { "region_of_interest", BenchRegionOfInterest },
+    { "frame_arena", BenchFrameArena },
+    { "tiled_sources", BenchTiledSources },
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<const Case*> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            g_Quick = true;
+            continue;
+        }
+
+        const Case* match = nullptr;
+        for (const Case& benchCase : CASES) {
+            if (std::strcmp(argv[i], benchCase.name) == 0) match = &benchCase;
+        }
+        if (!match) {
+            std::fprintf(stderr, "usage: framegen_bench [--quick] [case ...]\ncases:");
+            for (const Case& benchCase : CASES) std::fprintf(stderr, " %s", benchCase.name);
+            std::fprintf(stderr, "\n");
+            return 2;
+        }
+        selected.push_back(match);
+    }
+    if (selected.empty()) {
+        for (const Case& benchCase : CASES) selected.push_back(&benchCase);
+    }
+
+    int failures = 0;
+    for (const Case* benchCase : selected) {
+        if (!benchCase->run()) {
+            std::fprintf(stderr, "%s: failed\n", benchCase->name);
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * Memory Budget Tests
+ *
+ * A ResourcePool whose allocator registers every texture with a
+ * MemoryBudget, stepped frame by frame the way the backend applies the
+ * degradation levels: trim idle textures first, then drop to half
+ * resolution, and relax again once the limit leaves room.
+ */
+
+#include "test_common.h"
+#include "frame_gen/memory_budget.h"
+#include "frame_gen/resource_pool.h"
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint64_t FRAME_BYTES = 1920ull * 1080 * 4;
+
+class BudgetedAllocator : public IResourceAllocator {
+public:
+    explicit BudgetedAllocator(MemoryBudget& budget) : m_Budget(budget) {}
+
+    void* Create(const ResourceDesc& desc) override {
+        int* resource = new int(0);
+        m_Budget.Register(resource, MemoryCategory::Textures, static_cast<uint64_t>(desc.width) * desc.height * 4);
+        return resource;
+    }
+
+    void Destroy(void* resource) override {
+        m_Budget.Unregister(resource);
+        delete static_cast<int*>(resource);
+    }
+
+private:
+    MemoryBudget& m_Budget;
+};
+
+/**
+ * The backend's reaction to the budget: half resolution swaps the full
+ * size sharpen target for a half size one, TrimIdle trims every frame
+ */
+struct Pipeline {
+    Pipeline(MemoryBudget& budget, ResourcePool& pool) : budget(budget), pool(pool) {}
+
+    void Frame() {
+        if (budget.Update()) {
+            const bool wantHalf = budget.IsDegraded(MemoryDegradation::HalfResolution);
+            if (wantHalf && !half) {
+                half = pool.Acquire(HALF);
+                pool.Release(sharpen);
+                sharpen = nullptr;
+            } else if (!wantHalf && half) {
+                sharpen = pool.Acquire(FULL);
+                pool.Release(half);
+                half = nullptr;
+            }
+        }
+        pool.EndFrame();
+        if (budget.IsDegraded(MemoryDegradation::TrimIdle)) {
+            pool.Trim();
+        }
+    }
+
+    static constexpr ResourceDesc FULL{ 1920, 1080, 28, 40 };
+    static constexpr ResourceDesc HALF{ 960, 540, 28, 40 };
+
+    MemoryBudget& budget;
+    ResourcePool& pool;
+    void* sharpen = nullptr;
+    void* half = nullptr;
+};
+
+void TestDegradeAndRelax() {
+    MemoryBudget budget;
+    BudgetedAllocator allocator(budget);
+    ResourcePool pool;
+    CHECK(pool.Initialize(&allocator));
+
+    const ResourceDesc history{ 1920, 1080, 28, 8 };
+    pool.Acquire(history);
+    pool.Acquire(history);
+    pool.Acquire(Pipeline::FULL);
+
+    Pipeline pipeline(budget, pool);
+    pipeline.sharpen = pool.Acquire(Pipeline::FULL);
+
+    // An idle leftover from a previous resolution
+    pool.Release(pool.Acquire(ResourceDesc{ 2560, 1440, 28, 40 }));
+
+    int shaders = 0;
+    budget.Register(&shaders, MemoryCategory::Shaders, 100000);
+    CHECK(budget.GetUsage(MemoryCategory::Shaders) == 100000);
+
+    // Room for the four live frames: trimming the leftover is enough
+    budget.SetLimit(4 * FRAME_BYTES + 200000);
+    for (int frame = 0; frame < 6; ++frame) {
+        pipeline.Frame();
+    }
+    CHECK(budget.GetDegradation() == MemoryDegradation::TrimIdle);
+    CHECK(!budget.IsOverBudget());
+
+    // Tighter: needs the half size sharpen target as well
+    budget.SetLimit(33 * FRAME_BYTES / 10);
+    for (int frame = 0; frame < 4; ++frame) {
+        pipeline.Frame();
+    }
+    CHECK(budget.GetDegradation() == MemoryDegradation::HalfResolution);
+    CHECK(!budget.IsOverBudget());
+    CHECK(pipeline.half != nullptr);
+
+    // Headroom again: steps back down one level per frame
+    budget.SetLimit(10 * FRAME_BYTES);
+    for (int frame = 0; frame < 4; ++frame) {
+        pipeline.Frame();
+    }
+    CHECK(budget.GetDegradation() == MemoryDegradation::None);
+    CHECK(pipeline.sharpen != nullptr);
+    CHECK(budget.GetPeakUsage() >= budget.GetUsage());
+
+    // No limit: nothing to re-evaluate
+    budget.SetLimit(0);
+    CHECK(!budget.Update());
+
+    pool.Shutdown();
+    budget.Unregister(&shaders);
+    CHECK(budget.GetUsage() == 0);
+}
+
+void TestRegisterReplacesSize() {
+    MemoryBudget budget;
+    int owner = 0;
+    budget.Register(&owner, MemoryCategory::Buffers, 1000);
+    budget.Register(&owner, MemoryCategory::Buffers, 400);
+    CHECK(budget.GetUsage() == 400);
+    CHECK(budget.GetUsage(MemoryCategory::Buffers) == 400);
+
+    budget.Unregister(&owner);
+    budget.Unregister(&owner);
+    CHECK(budget.GetUsage() == 0);
+    CHECK(budget.GetPeakUsage() == 1000);
+}
+
+} // namespace
+
+int main() {
+    TestDegradeAndRelax();
+    TestRegisterReplacesSize();
+    return FiveMFrameGen::Test::Finish("memory_budget_test");
+}
@@ -0,0 +1,182 @@
+/**
+ * Present Path Allocation Tests
+ *
+ * Replaces the global operator new with a counting one and runs the
+ * D3D-free parts of a presented frame: frame handles and transfers, the
+ * readback and upload rings, the frame time history, the pool and budget
+ * bookkeeping and a log line. Once warmed up, a frame must not allocate.
+ */
+
+#include "test_common.h"
+#include "frame_gen/frame_handle.h"
+#include "frame_gen/frame_time_history.h"
+#include "frame_gen/memory_budget.h"
+#include "frame_gen/readback_ring.h"
+#include "frame_gen/resource_pool.h"
+#include "frame_gen/upload_ring.h"
+#include "utils/logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+bool s_Counting = false;
+size_t s_Allocations = 0;
+
+void* CountedAllocate(size_t size) {
+    if (s_Counting) {
+        ++s_Allocations;
+    }
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+using namespace FiveMFrameGen;
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+constexpr const char* LOG_FILE = "present_alloc_test.log";
+
+class HeapAllocator : public IResourceAllocator {
+public:
+    void* Create(const ResourceDesc& desc) override { return new ResourceDesc(desc); }
+    void Destroy(void* resource) override { delete static_cast<ResourceDesc*>(resource); }
+};
+
+/**
+ * Everything a frame touches, set up once like the backend's Initialize
+ */
+struct PresentPath {
+    PresentPath()
+        : backBufferPixels(WIDTH * HEIGHT), historyPixels(WIDTH * HEIGHT),
+          backBuffer(backBufferPixels.data(), WIDTH, HEIGHT, WIDTH * sizeof(uint32_t)),
+          history(historyPixels.data(), WIDTH, HEIGHT, WIDTH * sizeof(uint32_t)) {
+        const StagingDesc desc{ WIDTH, HEIGHT, 28, 4 };
+        CHECK(readback.Initialize(&device, desc, 3));
+        CHECK(upload.Initialize(&device, desc, 3));
+        transfer.SetDevice(&device);
+
+        CHECK(pool.Initialize(&allocator));
+        pooled = pool.Acquire(ResourceDesc{ WIDTH, HEIGHT, 28, 40 });
+        budget.SetLimit(1 << 20);
+        budget.Register(pooled, MemoryCategory::Textures, WIDTH * HEIGHT * 4);
+    }
+
+    ~PresentPath() {
+        budget.Unregister(pooled);
+        pool.Shutdown();
+    }
+
+    void Frame(uint32_t frame) {
+        backBufferPixels[0] = frame;
+
+        // Capture: one copy into history, then queue it for the CPU
+        const FrameHandle target = frames.Adopt(&backBuffer, WIDTH * HEIGHT * 4);
+        const FrameHandle slot = frames.Adopt(&history, WIDTH * HEIGHT * 4);
+        CHECK(transfer.Copy(slot, target));
+        ConstImageView captured = history;
+        CHECK(readback.Submit(&captured));
+        ReadbackFrame cpuFrame;
+        if (readback.Acquire(cpuFrame)) {
+            readback.Release();
+        }
+
+        // Present a CPU frame, and a generated one rendered in place
+        ImageView staging;
+        if (upload.Begin(staging)) {
+            staging.As<uint32_t>().Row(0)[0] = frame;
+            CHECK(upload.Commit(&backBuffer));
+        }
+        CHECK(transfer.Copy(target, target));
+
+        // Stats and bookkeeping
+        timing.Push(16.6f);
+        CHECK(timing.GetAverage() > 0.0f);
+        budget.Update();
+        pool.EndFrame();
+        Utils::Logger::Info("Frame %u presented (%.1f ms)", frame, timing.GetAverage());
+
+        device.Tick();
+    }
+
+    std::vector<uint32_t> backBufferPixels;
+    std::vector<uint32_t> historyPixels;
+    ImageView backBuffer;
+    ImageView history;
+
+    MemoryStagingDevice device;
+    ReadbackRing readback;
+    UploadRing upload;
+    FrameTable frames;
+    FrameTransfer transfer;
+    FrameTimeHistory<60> timing;
+
+    HeapAllocator allocator;
+    ResourcePool pool;
+    MemoryBudget budget;
+    void* pooled = nullptr;
+};
+
+void TestSteadyStateDoesNotAllocate() {
+    Utils::Logger::Init(LOG_FILE);
+    {
+        PresentPath path;
+
+        // The first frames fill the rings and open the log's buffers
+        for (uint32_t frame = 0; frame < 4; ++frame) {
+            path.Frame(frame);
+        }
+
+        s_Allocations = 0;
+        s_Counting = true;
+        for (uint32_t frame = 4; frame < 200; ++frame) {
+            path.Frame(frame);
+        }
+        s_Counting = false;
+
+        CHECK(s_Allocations == 0);
+        CHECK(path.transfer.GetCounters().aliased == 200);
+        CHECK(path.frames.GetLive() == 0);
+        CHECK(path.readback.GetStats().delivered > 0);
+        CHECK(path.upload.GetStats().uploads > 0);
+    }
+    Utils::Logger::Shutdown();
+    std::remove(LOG_FILE);
+}
+
+/**
+ * The harness itself sees allocations
+ */
+void TestCounterWorks() {
+    s_Allocations = 0;
+    s_Counting = true;
+    std::vector<int>* allocated = new std::vector<int>(16);
+    s_Counting = false;
+    delete allocated;
+    CHECK(s_Allocations == 2);
+}
+
+} // namespace
+
+int main() {
+    TestCounterWorks();
+    TestSteadyStateDoesNotAllocate();
+    return FiveMFrameGen::Test::Finish("present_alloc_test");
+}
@@ -0,0 +1,189 @@
+/**
+ * Readback Ring Tests
+ *
+ * ReadbackRing over MemoryStagingDevice, whose copies finish a set number
+ * of Tick calls after they are queued: frames arrive depth - 1 submits
+ * late, a GPU slower than the ring shows up as notReady and dropped
+ * copies, and only an explicit wait blocks.
+ */
+
+#include "test_common.h"
+#include "frame_gen/readback_ring.h"
+
+#include <vector>
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+
+/**
+ * Source frames filled with their own frame number
+ */
+struct Source {
+    Source() : pixels(WIDTH * HEIGHT) {}
+
+    ConstImageView Fill(uint32_t frame) {
+        for (uint32_t& pixel : pixels) {
+            pixel = frame;
+        }
+        return ConstImageView(Plane<const uint32_t>{ pixels.data(), WIDTH, HEIGHT, WIDTH });
+    }
+
+    std::vector<uint32_t> pixels;
+};
+
+const StagingDesc DESC{ WIDTH, HEIGHT, 28, 4 };
+
+void TestDepthDelaysDelivery() {
+    MemoryStagingDevice device;
+    ReadbackRing ring;
+    Source source;
+    device.SetCopyLatency(1);
+    CHECK(ring.Initialize(&device, DESC, 3));
+    CHECK(ring.GetDepth() == 3);
+
+    uint32_t delivered = 0;
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        ConstImageView view = source.Fill(frame);
+        CHECK(ring.Submit(&view));
+
+        ReadbackFrame captured;
+        if (ring.Acquire(captured)) {
+            // Two submits behind, and the data is that frame's
+            CHECK(captured.frameIndex + 2 == frame);
+            CHECK(captured.view.As<const uint32_t>().Row(5)[7] == captured.frameIndex);
+            CHECK(ring.GetStats().lastLatencyFrames == 2);
+            ring.Release();
+            ++delivered;
+        }
+        device.Tick();
+    }
+    CHECK(delivered == 18);
+
+    const ReadbackRing::Stats& stats = ring.GetStats();
+    CHECK(stats.submitted == 20);
+    CHECK(stats.delivered == 18);
+    CHECK(stats.inFlight == 2);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.notReady == 0);
+    CHECK(stats.stalls == 0);
+    CHECK(device.GetCounters().blockingMaps == 0);
+
+    // Draining takes the remaining copies early; they are finished, so no stall
+    ReadbackFrame captured;
+    while (ring.Acquire(captured, true)) {
+        ring.Release();
+        ++delivered;
+    }
+    CHECK(delivered == 20);
+    CHECK(stats.inFlight == 0);
+    CHECK(stats.stalls == 0);
+
+    ring.Shutdown();
+    CHECK(device.GetCounters().live == 0);
+}
+
+void TestSlowGpuDropsInsteadOfStalling() {
+    MemoryStagingDevice device;
+    ReadbackRing ring;
+    Source source;
+    device.SetCopyLatency(4);
+    CHECK(ring.Initialize(&device, DESC, 3));
+
+    uint32_t delivered = 0;
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        ConstImageView view = source.Fill(frame);
+        CHECK(ring.Submit(&view));
+
+        ReadbackFrame captured;
+        if (ring.Acquire(captured)) {
+            ring.Release();
+            ++delivered;
+        }
+        device.Tick();
+    }
+
+    // Every due copy was still in flight; the ring lapped them instead of blocking
+    const ReadbackRing::Stats& stats = ring.GetStats();
+    CHECK(delivered == 0);
+    CHECK(stats.notReady == 18);
+    CHECK(stats.dropped == 17);
+    CHECK(stats.stalls == 0);
+    CHECK(device.GetCounters().blockingMaps == 0);
+    CHECK(stats.submitted == stats.delivered + stats.dropped + stats.inFlight);
+
+    // Only an explicit wait stalls
+    ReadbackFrame captured;
+    uint32_t drained = 0;
+    while (ring.Acquire(captured, true)) {
+        CHECK(captured.view.As<const uint32_t>().Row(0)[0] == captured.frameIndex);
+        ring.Release();
+        ++drained;
+    }
+    CHECK(drained == 3);
+    CHECK(stats.stalls == 3);
+    CHECK(device.GetCounters().blockingMaps == 3);
+    CHECK(stats.submitted == stats.delivered + stats.dropped);
+
+    ring.Shutdown();
+    CHECK(device.GetCounters().live == 0);
+}
+
+void TestHeldFrameBlocksItsSlot() {
+    MemoryStagingDevice device;
+    ReadbackRing ring;
+    Source source;
+    CHECK(ring.Initialize(&device, DESC, 2));
+
+    ConstImageView view = source.Fill(0);
+    CHECK(ring.Submit(&view));
+    view = source.Fill(1);
+    CHECK(ring.Submit(&view));
+    device.Tick();
+
+    ReadbackFrame captured;
+    CHECK(ring.Acquire(captured));
+    CHECK(captured.frameIndex == 0);
+
+    // The next submit would overwrite the mapped copy
+    view = source.Fill(2);
+    CHECK(!ring.Submit(&view));
+    ReadbackFrame second;
+    CHECK(!ring.Acquire(second));
+
+    ring.Release();
+    CHECK(ring.Submit(&view));
+
+    // Discard forgets queued copies without counting them as dropped
+    ring.Discard();
+    CHECK(ring.GetStats().inFlight == 0);
+    CHECK(!ring.Acquire(captured, true));
+    CHECK(ring.GetStats().dropped == 0);
+
+    ring.Shutdown();
+    CHECK(device.GetCounters().live == 0);
+}
+
+void TestInvalidDepth() {
+    MemoryStagingDevice device;
+    ReadbackRing ring;
+    CHECK(!ring.Initialize(&device, DESC, 0));
+    CHECK(!ring.Initialize(&device, DESC, ReadbackRing::MAX_DEPTH + 1));
+    CHECK(!ring.Initialize(nullptr, DESC, 3));
+    CHECK(!ring.Initialize(&device, StagingDesc{}, 3));
+    CHECK(!ring.IsInitialized());
+    CHECK(device.GetCounters().live == 0);
+}
+
+} // namespace
+
+int main() {
+    TestDepthDelaysDelivery();
+    TestSlowGpuDropsInsteadOfStalling();
+    TestHeldFrameBlocksItsSlot();
+    TestInvalidDepth();
+    return FiveMFrameGen::Test::Finish("readback_ring_test");
+}
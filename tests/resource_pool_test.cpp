@@ -0,0 +1,138 @@
+/**
+ * Resource Pool Tests
+ *
+ * Drives ResourcePool over a counting allocator through the lifetimes the
+ * backends put it through: a Reset, a backend switch, a resolution round
+ * trip and idle aging.
+ */
+
+#include "test_common.h"
+#include "frame_gen/resource_pool.h"
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+class CountingAllocator : public IResourceAllocator {
+public:
+    void* Create(const ResourceDesc& desc) override {
+        ++creates;
+        ++live;
+        return new ResourceDesc(desc);
+    }
+
+    void Destroy(void* resource) override {
+        ++destroys;
+        --live;
+        delete static_cast<ResourceDesc*>(resource);
+    }
+
+    int creates = 0;
+    int destroys = 0;
+    int live = 0;
+};
+
+void TestReuseAcrossResetAndBackendSwitch() {
+    CountingAllocator allocator;
+    ResourcePool pool;
+    CHECK(pool.Initialize(&allocator, 3));
+
+    const ResourceDesc history{ 3840, 2160, 28, 8 };
+    const ResourceDesc target{ 3840, 2160, 28, 40 };
+
+    // Initialize: two history slots and two render targets
+    void* h0 = pool.Acquire(history);
+    void* h1 = pool.Acquire(history);
+    void* t0 = pool.Acquire(target);
+    void* t1 = pool.Acquire(target);
+    CHECK(allocator.creates == 4);
+
+    // Reset: history released and taken again
+    pool.Release(h0);
+    pool.Release(h1);
+    h0 = pool.Acquire(history);
+    h1 = pool.Acquire(history);
+    CHECK(allocator.creates == 4);
+    CHECK(pool.GetStats().reused == 2);
+
+    // Backend switch: everything released, the next generator asks again
+    pool.Release(h0);
+    pool.Release(h1);
+    pool.Release(t0);
+    pool.Release(t1);
+    void* a = pool.Acquire(target);
+    pool.Acquire(target);
+    void* c = pool.Acquire(history);
+    pool.Acquire(history);
+    CHECK(allocator.creates == 4);
+    CHECK(allocator.destroys == 0);
+
+    // Only exact descriptor matches are handed back
+    CHECK(static_cast<ResourceDesc*>(a)->bindFlags == 40);
+    CHECK(static_cast<ResourceDesc*>(c)->bindFlags == 8);
+    CHECK(pool.GetStats().inUse == 4);
+
+    pool.Shutdown();
+    CHECK(allocator.live == 0);
+}
+
+void TestIdleAgingAndTrim() {
+    CountingAllocator allocator;
+    ResourcePool pool;
+    CHECK(pool.Initialize(&allocator, 3));
+
+    const ResourceDesc full{ 1920, 1080, 28, 40 };
+    const ResourceDesc half{ 960, 540, 28, 40 };
+
+    void* kept = pool.Acquire(full);
+
+    // Half resolution toggled on and off: the half target goes idle
+    pool.Release(pool.Acquire(half));
+    CHECK(allocator.creates == 2);
+    CHECK(pool.GetStats().idle == 1);
+
+    for (int i = 0; i < 3; ++i) {
+        pool.EndFrame();
+    }
+    CHECK(allocator.destroys == 0);
+
+    pool.EndFrame();
+    CHECK(allocator.destroys == 1);
+    CHECK(pool.GetStats().idle == 0);
+
+    // Trim drops idle resources at once, in-use ones stay
+    pool.Release(kept);
+    pool.Trim();
+    CHECK(allocator.destroys == 2);
+    CHECK(pool.GetStats().inUse == 0);
+
+    // Releasing something the pool never handed out is ignored
+    int stranger = 0;
+    pool.Release(&stranger);
+    CHECK(allocator.destroys == 2);
+
+    pool.Shutdown();
+    CHECK(allocator.live == 0);
+}
+
+void TestShutdownDestroysOutstanding() {
+    CountingAllocator allocator;
+    ResourcePool pool;
+    CHECK(pool.Initialize(&allocator));
+
+    pool.Acquire(ResourceDesc{ 64, 64, 28, 8 });
+    pool.Release(pool.Acquire(ResourceDesc{ 32, 32, 28, 8 }));
+
+    pool.Shutdown();
+    CHECK(allocator.live == 0);
+    CHECK(pool.GetStats().created == pool.GetStats().destroyed);
+}
+
+} // namespace
+
+int main() {
+    TestReuseAcrossResetAndBackendSwitch();
+    TestIdleAgingAndTrim();
+    TestShutdownDestroysOutstanding();
+    return FiveMFrameGen::Test::Finish("resource_pool_test");
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * Test Support
+ *
+ * Each portable test is a plain executable: CHECK reports a failed
+ * expression and keeps going, and Finish turns the failure count into
+ * the exit code CTest looks at.
+ */
+
+#ifndef FIVEM_FRAMEGEN_TEST_COMMON_H
+#define FIVEM_FRAMEGEN_TEST_COMMON_H
+
+#include <cstdio>
+
+namespace FiveMFrameGen {
+namespace Test {
+
+inline int& FailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void Fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    ++FailureCount();
+}
+
+/**
+ * Report the result of a test executable
+ *
+ * @return Exit code for main
+ */
+inline int Finish(const char* name) {
+    if (FailureCount() > 0) {
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, FailureCount());
+        return 1;
+    }
+    std::printf("%s: all checks passed\n", name);
+    return 0;
+}
+
+} // namespace Test
+} // namespace FiveMFrameGen
+
+#define CHECK(expression) \
+    ((expression) ? (void)0 : ::FiveMFrameGen::Test::Fail(__FILE__, __LINE__, #expression))
+
+#endif // FIVEM_FRAMEGEN_TEST_COMMON_H
@@ -0,0 +1,157 @@
+/**
+ * Upload Ring Tests
+ *
+ * UploadRing over MemoryStagingDevice: copies cycle through a fixed set
+ * of staging buffers, and a copy the simulated GPU is still reading is
+ * skipped rather than waited on unless the caller asks to block.
+ */
+
+#include "test_common.h"
+#include "frame_gen/upload_ring.h"
+
+#include <vector>
+
+using namespace FiveMFrameGen::FrameGen;
+
+namespace {
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+
+const StagingDesc DESC{ WIDTH, HEIGHT, 28, 4 };
+
+/**
+ * GPU-side target the uploads are copied into
+ */
+struct Target {
+    Target() : pixels(WIDTH * HEIGHT), view(pixels.data(), WIDTH, HEIGHT, WIDTH * sizeof(uint32_t)) {}
+
+    uint32_t At(uint32_t x, uint32_t y) const { return pixels[y * WIDTH + x]; }
+
+    std::vector<uint32_t> pixels;
+    ImageView view;
+};
+
+void Write(const ImageView& view, uint32_t frame) {
+    const Plane<uint32_t> plane = view.As<uint32_t>();
+    for (uint32_t y = 0; y < plane.height; ++y) {
+        for (uint32_t x = 0; x < plane.width; ++x) {
+            plane.Row(y)[x] = frame * 7 + y;
+        }
+    }
+}
+
+void TestSlotReuse() {
+    MemoryStagingDevice device;
+    UploadRing ring;
+    Target target;
+    device.SetCopyLatency(1);
+    CHECK(ring.Initialize(&device, DESC, 3));
+    CHECK(device.GetCounters().live == 3);
+
+    // The ring hands out its three copies in turn and never creates more
+    void* slots[3] = {};
+    for (uint32_t frame = 0; frame < 12; ++frame) {
+        ImageView view;
+        CHECK(ring.Begin(view));
+        if (frame < 3) {
+            slots[frame] = view.data;
+        } else {
+            CHECK(view.data == slots[frame % 3]);
+        }
+        Write(view, frame);
+        CHECK(ring.Commit(&target.view));
+        CHECK(target.At(3, 5) == frame * 7 + 5);
+        device.Tick();
+    }
+    CHECK(slots[0] != slots[1] && slots[1] != slots[2] && slots[0] != slots[2]);
+    CHECK(device.GetCounters().live == 3);
+
+    const UploadRing::Stats& stats = ring.GetStats();
+    CHECK(stats.uploads == 12);
+    CHECK(stats.bytesUploaded == 12ull * WIDTH * HEIGHT * 4);
+    CHECK(stats.busy == 0);
+    CHECK(stats.stalls == 0);
+    CHECK(device.GetCounters().uploads == 12);
+
+    // Cancel keeps the copy for the next Begin and uploads nothing
+    ImageView view;
+    CHECK(ring.Begin(view));
+    void* cancelled = view.data;
+    ImageView second;
+    CHECK(!ring.Begin(second));
+    ring.Cancel();
+    CHECK(ring.Begin(view));
+    CHECK(view.data == cancelled);
+    ring.Cancel();
+    CHECK(stats.uploads == 12);
+
+    ring.Shutdown();
+    CHECK(device.GetCounters().live == 0);
+}
+
+void TestSkipWhenBusy() {
+    MemoryStagingDevice device;
+    UploadRing ring;
+    Target target;
+    device.SetCopyLatency(5);
+    CHECK(ring.Initialize(&device, DESC, 3));
+
+    // Each copy is read for five frames and the ring has three: two of
+    // every five frames find the next copy busy and skip the upload
+    uint32_t uploaded = 0;
+    for (uint32_t frame = 0; frame < 60; ++frame) {
+        ImageView view;
+        if (ring.Begin(view)) {
+            Write(view, frame);
+            CHECK(ring.Commit(&target.view));
+            CHECK(target.At(3, 5) == frame * 7 + 5);
+            ++uploaded;
+        }
+        device.Tick();
+    }
+
+    const UploadRing::Stats& stats = ring.GetStats();
+    CHECK(uploaded == 36);
+    CHECK(stats.uploads == 36);
+    CHECK(stats.busy == 24);
+    CHECK(stats.stalls == 0);
+    CHECK(stats.inFlight == 3);
+    CHECK(device.GetCounters().blockingMaps == 0);
+
+    // With every copy just queued, asking to wait blocks instead
+    ImageView view;
+    for (uint32_t i = 0; i < 3; ++i) {
+        if (ring.Begin(view)) {
+            CHECK(ring.Commit(&target.view));
+        }
+    }
+    CHECK(ring.Begin(view, true));
+    CHECK(stats.stalls == 1);
+    CHECK(device.GetCounters().blockingMaps == 1);
+    ring.Cancel();
+
+    ring.Shutdown();
+    CHECK(device.GetCounters().live == 0);
+}
+
+void TestInvalidDepth() {
+    MemoryStagingDevice device;
+    UploadRing ring;
+    CHECK(!ring.Initialize(&device, DESC, 0));
+    CHECK(!ring.Initialize(&device, DESC, UploadRing::MAX_DEPTH + 1));
+    CHECK(!ring.IsInitialized());
+
+    ImageView view;
+    CHECK(!ring.Begin(view));
+    CHECK(device.GetCounters().live == 0);
+}
+
+} // namespace
+
+int main() {
+    TestSlotReuse();
+    TestSkipWhenBusy();
+    TestInvalidDepth();
+    return FiveMFrameGen::Test::Finish("upload_ring_test");
+}